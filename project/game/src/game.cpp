@@ -1,27 +1,27 @@
 #include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <memory>
 #include <random>
+#include <vector>
 
+#include "nova/kinematics/kinematics_plugin.hpp"
 #include "nova/nova.hpp"
+#include "nova/render/render_plugin.hpp"
 
 using namespace nova;
 
-// A simple component
-struct velocity {
-  float dx{};
-  float dy{};
-};
-
-struct acceleration {
-  float ddx{};
-  float ddy{};
-};
+// nova's vertices are submitted to SFML as they are.
+static_assert(sizeof(Vertex) == sizeof(sf::Vertex));
+static_assert(offsetof(Vertex, color) == offsetof(sf::Vertex, color));
+static_assert(offsetof(Vertex, u) == offsetof(sf::Vertex, texCoords));
 
 // A Bundle of components
 struct CircleBundle {
   using is_bundle = void;
 
-  velocity vel{};
-  sf::CircleShape circle{};
+  Position pos{};
+  Velocity vel{};
+  Circle circle{};
 };
 
 // make a random number between a (min, max)
@@ -33,73 +33,68 @@ auto rng(const float min, const float max) -> float {
 }
 
 // a system to spawn circles
-auto spawn_circles(Resource<sf::RenderWindow> window, Registry& registry)
+auto spawn_circles(NonSend<sf::RenderWindow> window, Registry& registry)
     -> void {
   const auto size = window->getSize();
   const auto x_center = (float)size.x / 2.f;
   const auto y_center = (float)size.y / 2.f;
 
+  auto circles = std::vector<CircleBundle>{};
   for (auto i = 0; i < 10; ++i) {
-    const auto e = registry.create();
-
-    auto circle = sf::CircleShape(rng(5.f, 20.f));
-    circle.setFillColor(sf::Color::Cyan);
-    circle.setPosition(sf::Vector2f{x_center, y_center});
-
-    registry.emplace_bundle(e, CircleBundle{.vel =
-                                                velocity{
-                                                    .dx = rng(-20.f, 20.f),
-                                                    .dy = rng(-20.f, 20.f),
-                                                },
-                                            .circle = circle});
-
-    // only add acceleration to half of the circles
-    if (i % 2 == 0) {
-      registry.emplace<acceleration>(e, acceleration{
-                                            .ddx = rng(-5.f, 5.f),
-                                            .ddy = rng(-5.f, 5.f),
-                                        });
-    }
+    circles.push_back(CircleBundle{
+        .pos = Position{.x = x_center, .y = y_center},
+        .vel =
+            Velocity{
+                .dx = rng(-20.f, 20.f),
+                .dy = rng(-20.f, 20.f),
+            },
+        .circle =
+            Circle{
+                .radius = rng(5.f, 20.f),
+                .color = Color{.r = 0u, .g = 255u, .b = 255u},
+            },
+    });
   }
-}
 
-auto acceleration_system(Resource<const Time> time,
-                         View<With<const acceleration, velocity>> view)
-    -> void {
-  const auto delta = time->delta_seconds<float>();
-  for (auto [_, acc, vel] : view.each()) {
-    vel.dx += acc.ddx * delta;
-    vel.dy += acc.ddy * delta;
+  const auto entities = registry.spawn_batch(circles);
+
+  // only add acceleration to half of the circles
+  for (auto i = 0u; i < std::size(entities); i += 2u) {
+    registry.emplace<Acceleration>(entities[i], Acceleration{
+                                                    .ddx = rng(-5.f, 5.f),
+                                                    .ddy = rng(-5.f, 5.f),
+                                                });
   }
 }
 
-auto speed_system(Resource<const Time> time,
-                  View<With<const velocity, sf::CircleShape>> view) -> void {
-  const auto delta = time->delta_seconds<float>();
-  for (auto [_, velocity, circle] : view.each()) {
-    const auto [x, y] = circle.getPosition();
+// draws on the render thread, which owns the window's OpenGL context.
+class SfmlBackend final : public RenderBackend {
+  sf::RenderWindow* window_;
 
-    const auto new_x = x + velocity.dx * delta;
-    const auto new_y = y + velocity.dy * delta;
-    circle.setPosition(sf::Vector2f{new_x, new_y});
-  }
-}
+ public:
+  explicit SfmlBackend(sf::RenderWindow& window) : window_(&window) {}
+
+  auto activate() -> void override { window_->setActive(true); }
 
-auto draw_circle(Resource<sf::RenderWindow> window,
-                 View<With<const sf::CircleShape>> view) -> void {
-  window->clear();
-  for (auto&& [_, circle] : view.each()) {
-    window->draw(circle);
+  // submits the whole batch in one draw call.
+  auto draw(const RenderFrame& frame) -> void override {
+    window_->clear();
+    window_->draw(
+        reinterpret_cast<const sf::Vertex*>(std::data(frame.vertices)),
+        std::size(frame.vertices), sf::Triangles);
+    window_->display();
   }
-  window->display();
-}
 
-auto exit_game(Resource<sf::RenderWindow> window, Resource<AppExit> exit) {
+  auto deactivate() -> void override { window_->setActive(false); }
+};
+
+auto exit_game(NonSend<sf::RenderWindow> window, Resource<AppExit> exit) {
   sf::Event event{};
   while (window->pollEvent(event)) {
     if (event.type == sf::Event::Closed) {
+      // the window is closed when it is destroyed, after the render thread
+      // stopped drawing to it.
       exit->should_exit = true;
-      window->close();
     }
   }
 }
@@ -107,11 +102,19 @@ auto exit_game(Resource<sf::RenderWindow> window, Resource<AppExit> exit) {
 int main() {
   auto app = App{};
   app.add_plugin(DefaultPlugins{})
-      .insert_resource<sf::RenderWindow>(sf::VideoMode(500, 500), "SFML Works!")
+      .add_plugin(TaskPoolPlugin{})
+      .insert_non_send_resource<sf::RenderWindow>(sf::VideoMode(500, 500),
+                                                  "SFML Works!");
+
+  // events are polled on this thread, drawing happens on the render thread.
+  auto& window = **app.world.resources().get_non_send<sf::RenderWindow>();
+  window.setActive(false);
+
+  app.insert_resource<RenderThread>(std::make_unique<SfmlBackend>(window))
       .add_startup_system(spawn_circles)
-      .add_system(system(speed_system).label("speed"))
-      .add_system(system(acceleration_system).before("speed"))
-      .add_system_to_stage<stages::PostUpdate>(draw_circle)
+      .add_plugin(KinematicsPlugin{})
+      .insert_resource<Viewport>(Viewport{.max_x = 500.f, .max_y = 500.f})
+      .add_plugin(PipelinedRenderPlugin{})
       .add_system_to_stage<stages::Last>(exit_game)
       .run();
 }
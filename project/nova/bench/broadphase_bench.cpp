@@ -0,0 +1,62 @@
+#include <algorithm>
+#include <entt/entt.hpp>
+#include <random>
+
+#include "common.hpp"
+#include "nova/collision/broadphase.hpp"
+
+namespace {
+
+using collider_view_t =
+    nova::View<nova::With<const nova::Position, const nova::CircleCollider>>;
+
+}  // namespace
+
+int main() {
+  constexpr auto n = std::size_t{200'000};
+  constexpr auto extent = 4'000.f;
+
+  auto gen = std::mt19937{42u};
+  auto place = std::uniform_real_distribution<float>{-extent, extent};
+  auto step = std::uniform_real_distribution<float>{-0.5f, 0.5f};
+
+  auto registry = entt::registry{};
+  for (auto i = std::size_t{0}; i < n; ++i) {
+    const auto e = registry.create();
+    registry.emplace<nova::Position>(e, place(gen), place(gen));
+    registry.emplace<nova::CircleCollider>(e, 3.f);
+  }
+  const auto view = collider_view_t{
+      registry.view<const nova::Position, const nova::CircleCollider>()};
+
+  auto pool = nova::TaskPool{};
+  auto sap = nova::SweepAndPrune{};
+  auto pairs = std::vector<nova::CandidatePair>{};
+
+  bench::report("initial update (full sort)", n,
+                bench::measure(1u, [&] { sap.update(view); }));
+
+  const auto move = [&] {
+    for (auto&& [e, pos] : registry.view<nova::Position>().each()) {
+      pos.x += step(gen);
+      pos.y += step(gen);
+    }
+  };
+
+  auto update = bench::millis_t::max();
+  auto sweep = bench::millis_t::max();
+  auto parallel_sweep = bench::millis_t::max();
+  for (auto frame = 0; frame < 10; ++frame) {
+    move();
+    update = std::min(update, bench::measure(1u, [&] { sap.update(view); }));
+    sweep = std::min(sweep, bench::measure(1u, [&] { sap.find_pairs(pairs); }));
+    parallel_sweep =
+        std::min(parallel_sweep,
+                 bench::measure(1u, [&] { sap.find_pairs(pairs, &pool); }));
+  }
+
+  bench::report("coherent update (insertion sort)", n, update);
+  bench::report("sweep", n, sweep);
+  bench::report("sweep, parallel", n, parallel_sweep);
+  std::printf("  candidate pairs: %zu\n", std::size(pairs));
+}
@@ -0,0 +1,23 @@
+#include <vector>
+
+#include "common.hpp"
+#include "nova/render/circle_batch.hpp"
+
+int main() {
+  auto pool = nova::TaskPool{};
+
+  for (const auto n : {std::size_t{10'000}, std::size_t{100'000},
+                       std::size_t{1'000'000}}) {
+    auto circles = std::vector<nova::CircleInstance>(n);
+    for (auto i = std::size_t{0}; i < n; ++i) {
+      const auto f = static_cast<float>(i);
+      circles[i] = nova::CircleInstance{.x = f, .y = f, .radius = 4.f};
+    }
+
+    auto batch = nova::CircleBatch{};
+    bench::report("build", n,
+                  bench::measure(10u, [&] { batch.build(circles); }));
+    bench::report("build, parallel", n,
+                  bench::measure(10u, [&] { batch.build(circles, &pool); }));
+  }
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <span>
+#include <string_view>
+
+namespace bench {
+
+using clock_t = std::chrono::steady_clock;
+using millis_t = std::chrono::duration<double, std::milli>;
+
+/// @brief Runs `func` `iterations` times and returns the fastest run.
+template <typename TFunc>
+auto measure(const std::size_t iterations, TFunc&& func) -> millis_t {
+  auto best = millis_t::max();
+  for (auto i = std::size_t{0}; i < iterations; ++i) {
+    const auto start = clock_t::now();
+    func();
+    best = std::min(best, millis_t{clock_t::now() - start});
+  }
+  return best;
+}
+
+/// @brief The `p` quantile (in [0, 1]) of the `sorted` durations, by nearest
+/// rank.
+inline auto percentile(std::span<const millis_t> sorted, const double p)
+    -> millis_t {
+  if (std::empty(sorted)) {
+    return millis_t{};
+  }
+  const auto rank = static_cast<std::size_t>(
+      std::ceil(p * static_cast<double>(std::size(sorted))));
+  return sorted[std::clamp<std::size_t>(rank, 1u, std::size(sorted)) - 1u];
+}
+
+inline auto report(const std::string_view name, const std::size_t n,
+                   const millis_t elapsed) -> void {
+  std::printf("%-40.*s n=%-9zu %10.3f ms\n", static_cast<int>(std::size(name)),
+              std::data(name), n, elapsed.count());
+}
+
+}  // namespace bench
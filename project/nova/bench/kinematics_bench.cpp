@@ -0,0 +1,84 @@
+#include <entt/entt.hpp>
+#include <string>
+
+#include "common.hpp"
+#include "nova/kinematics/kinematics.hpp"
+
+namespace {
+
+using velocity_view_t =
+    nova::View<nova::With<const nova::Velocity, nova::Position>>;
+using acceleration_view_t =
+    nova::View<nova::With<const nova::Acceleration, nova::Velocity>>;
+
+auto make_registry(const std::size_t n) -> entt::registry {
+  auto registry = entt::registry{};
+  for (auto i = std::size_t{0}; i < n; ++i) {
+    const auto e = registry.create();
+    const auto f = static_cast<float>(i);
+    registry.emplace<nova::Position>(e, f, f);
+    registry.emplace<nova::Velocity>(e, 1.f, -1.f);
+  }
+  return registry;
+}
+
+}  // namespace
+
+int main() {
+  constexpr auto dt = 0.016f;
+
+  std::printf("best instruction set: %.*s\n",
+              static_cast<int>(std::size(
+                  nova::simd::isa_name(nova::simd::best_isa()))),
+              std::data(nova::simd::isa_name(nova::simd::best_isa())));
+
+  for (const auto n : {std::size_t{10'000}, std::size_t{100'000},
+                       std::size_t{1'000'000}}) {
+    auto registry = make_registry(n);
+    const auto view =
+        velocity_view_t{registry.view<const nova::Velocity, nova::Position>()};
+
+    // the loop the game used to run, one entity at a time.
+    const auto each = bench::measure(20u, [&] {
+      for (auto&& [_, vel, pos] : view.each()) {
+        pos.x += vel.dx * dt;
+        pos.y += vel.dy * dt;
+      }
+    });
+    bench::report("each (per entity)", n, each);
+
+    for (const auto isa : {nova::simd::Isa::scalar, nova::simd::Isa::sse2,
+                           nova::simd::Isa::avx2, nova::simd::Isa::avx512}) {
+      if (not nova::simd::supports(isa)) {
+        continue;
+      }
+      const auto chunked = bench::measure(20u, [&] {
+        for (const auto& chunk : view.chunks()) {
+          const auto x =
+              nova::detail::as_floats(chunk.get<const nova::Velocity>());
+          const auto y = nova::detail::as_floats(chunk.get<nova::Position>());
+          nova::simd::axpy(isa, dt, std::data(x), std::data(y), std::size(y));
+        }
+      });
+      const auto name = std::string{"chunks + "} +
+                        std::string{nova::simd::isa_name(isa)};
+      bench::report(name, n, chunked);
+    }
+
+    // half the entities accelerate, so the acceleration view only has
+    // chunks of one entity, which are gathered into blocks.
+    auto index = std::size_t{0};
+    for (const auto e : registry.view<nova::Velocity>()) {
+      if (index++ % 2u == 0u) {
+        registry.emplace<nova::Acceleration>(e, 1.f, 1.f);
+      }
+    }
+    const auto acceleration_view = acceleration_view_t{
+        registry.view<const nova::Acceleration, nova::Velocity>()};
+    const auto gathered = bench::measure(20u, [&] {
+      nova::detail::integrate_chunks<nova::Acceleration, nova::Velocity>(
+          acceleration_view, dt);
+    });
+    bench::report("interleaved acceleration (gathered)", n / 2u, gathered);
+  }
+}
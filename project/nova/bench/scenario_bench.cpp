@@ -0,0 +1,462 @@
+// Whole-frame benchmarks of standard ECS workloads, run through `App` the way
+// a game would: the default stages and runner, a task pool, and `View`-based
+// systems. Every scenario uses a fixed time step and a fixed seed, and prints
+// a checksum of the final positions: runs built with the same standard library
+// must agree on it, with or without the task pool.
+//
+// usage: scenario_bench [particles|boids|nbody]... [max entities] [--serial]
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <entt/entt.hpp>
+#include <numbers>
+#include <random>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "common.hpp"
+#include "nova/app/app.hpp"
+#include "nova/app/core_stages.hpp"
+#include "nova/app/default_plugins.hpp"
+#include "nova/kinematics/kinematics.hpp"
+#include "nova/scheduler/observer.hpp"
+#include "nova/spatial/spatial_grid.hpp"
+#include "nova/system/system_builder.hpp"
+#include "nova/task/task_pool_plugin.hpp"
+
+namespace {
+
+using nova::Position;
+using nova::Velocity;
+
+constexpr auto USAGE =
+    "usage: scenario_bench [particles|boids|nbody]... [max entities] "
+    "[--serial]\n";
+
+constexpr auto DT = 1.f / 60.f;
+constexpr auto SEED = 42u;
+
+struct Rng {
+  std::mt19937 gen{SEED};
+
+  auto uniform(const float min, const float max) -> float {
+    return std::uniform_real_distribution<float>{min, max}(gen);
+  }
+};
+
+// the square the entities live in, centered on the origin.
+struct Bounds {
+  float half_extent{};
+};
+
+auto integrate(nova::View<nova::With<const Velocity, Position>> view)
+    -> void {
+  for (auto&& [_, vel, pos] : view.each()) {
+    pos.x += vel.dx * DT;
+    pos.y += vel.dy * DT;
+  }
+}
+
+// Particles: short-lived entities falling under gravity, respawned as they
+// expire so that the population stays constant while the pools churn.
+
+struct Lifetime {
+  float remaining{};
+};
+
+auto spawn_particle(nova::Registry& registry, Rng& rng) -> void {
+  const auto angle = rng.uniform(0.f, 2.f * std::numbers::pi_v<float>);
+  const auto speed = rng.uniform(10.f, 50.f);
+  const auto e = registry.create();
+  registry.emplace<Position>(e);
+  registry.emplace<Velocity>(e, std::cos(angle) * speed,
+                             std::sin(angle) * speed);
+  registry.emplace<Lifetime>(e, rng.uniform(0.25f, 2.f));
+}
+
+auto apply_gravity(nova::View<nova::With<Velocity>> view) -> void {
+  for (auto&& [_, vel] : view.each()) {
+    vel.dy -= 9.81f * DT;
+  }
+}
+
+auto age_particles(nova::View<nova::With<Lifetime>> view) -> void {
+  for (auto&& [_, lifetime] : view.each()) {
+    lifetime.remaining -= DT;
+  }
+}
+
+auto churn_particles(nova::Registry& registry, nova::Resource<Rng> rng,
+                     nova::Local<std::vector<entt::entity>> expired) -> void {
+  expired->clear();
+  for (auto&& [e, lifetime] : registry.view<const Lifetime>().each()) {
+    if (lifetime.remaining <= 0.f) {
+      expired->push_back(e);
+    }
+  }
+  registry.destroy(std::begin(*expired), std::end(*expired));
+  for (auto i = std::size_t{0}; i < std::size(*expired); ++i) {
+    spawn_particle(registry, *rng);
+  }
+}
+
+auto setup_particles(nova::App& app, const std::size_t n) -> void {
+  auto& registry = app.world.registry();
+  auto& rng = **app.world.resources().get<Rng>();
+  for (auto i = std::size_t{0}; i < n; ++i) {
+    spawn_particle(registry, rng);
+  }
+
+  app.add_system(nova::system(apply_gravity).label("gravity"))
+      .add_system(nova::system(integrate).after("gravity"))
+      .add_system(age_particles)
+      .add_system_to_stage<nova::stages::PostUpdate>(churn_particles);
+}
+
+// Boids: flocking, each boid steering by its neighbours found through a
+// `SpatialGrid`.
+
+constexpr auto BOID_RADIUS = 4.f;
+constexpr auto BOID_SPEED = 8.f;
+constexpr auto BOID_NEIGHBOURS = 8.f;
+
+struct Boid {
+  float ax{};
+  float ay{};
+};
+
+// the grid is rebuilt without the task pool, whose parallel sort does not
+// keep the order of the entities in a cell, and with it the order in which
+// the neighbours are summed.
+auto rebuild_boid_grid(nova::Resource<nova::SpatialGrid> grid,
+                       nova::View<nova::With<const Position>> view) -> void {
+  grid->rebuild(view);
+}
+
+auto steer_boids(
+    nova::Resource<const nova::SpatialGrid> grid,
+    nova::View<nova::With<const Position, const Velocity, Boid>> view)
+    -> void {
+  for (auto&& [e, pos, vel, boid] : view.each()) {
+    const auto self = e;
+    const auto x = pos.x;
+    const auto y = pos.y;
+    auto n = 0.f;
+    auto center_x = 0.f, center_y = 0.f;
+    auto heading_x = 0.f, heading_y = 0.f;
+    auto away_x = 0.f, away_y = 0.f;
+    grid->for_each_in_radius(
+        x, y, BOID_RADIUS, [&](const nova::SpatialGrid::Entry& entry) {
+          if (entry.entity == self) {
+            return;
+          }
+          const auto& other = view.get<const Velocity>(entry.entity);
+          const auto dx = x - entry.x;
+          const auto dy = y - entry.y;
+          const auto distance_sq = std::max(dx * dx + dy * dy, 1e-4f);
+          n += 1.f;
+          center_x += entry.x;
+          center_y += entry.y;
+          heading_x += other.dx;
+          heading_y += other.dy;
+          away_x += dx / distance_sq;
+          away_y += dy / distance_sq;
+        });
+
+    boid = Boid{};
+    if (n > 0.f) {
+      boid.ax = (center_x / n - pos.x) * 0.5f +
+                (heading_x / n - vel.dx) * 0.8f + away_x * 1.5f;
+      boid.ay = (center_y / n - pos.y) * 0.5f +
+                (heading_y / n - vel.dy) * 0.8f + away_y * 1.5f;
+    }
+  }
+}
+
+auto apply_steering(nova::View<nova::With<const Boid, Velocity>> view)
+    -> void {
+  for (auto&& [_, boid, vel] : view.each()) {
+    vel.dx += boid.ax * DT;
+    vel.dy += boid.ay * DT;
+    const auto speed = std::hypot(vel.dx, vel.dy);
+    if (speed > BOID_SPEED) {
+      vel.dx *= BOID_SPEED / speed;
+      vel.dy *= BOID_SPEED / speed;
+    }
+  }
+}
+
+auto wrap_around(nova::Resource<const Bounds> bounds,
+                 nova::View<nova::With<Position>> view) -> void {
+  const auto extent = bounds->half_extent;
+  const auto wrap = [extent](const float x) {
+    return x < -extent ? x + 2.f * extent : x > extent ? x - 2.f * extent : x;
+  };
+  for (auto&& [_, pos] : view.each()) {
+    pos.x = wrap(pos.x);
+    pos.y = wrap(pos.y);
+  }
+}
+
+auto setup_boids(nova::App& app, const std::size_t n) -> void {
+  // about `BOID_NEIGHBOURS` boids within the radius of each other.
+  const auto area = std::numbers::pi_v<float> * BOID_RADIUS * BOID_RADIUS /
+                    BOID_NEIGHBOURS;
+  const auto extent = std::sqrt(static_cast<float>(n) * area) / 2.f;
+  app.insert_resource<Bounds>(Bounds{.half_extent = extent})
+      .insert_resource<nova::SpatialGrid>(BOID_RADIUS);
+
+  auto& registry = app.world.registry();
+  auto& rng = **app.world.resources().get<Rng>();
+  for (auto i = std::size_t{0}; i < n; ++i) {
+    // drawn one by one, the order of evaluation of arguments is unspecified.
+    const auto x = rng.uniform(-extent, extent);
+    const auto y = rng.uniform(-extent, extent);
+    const auto dx = rng.uniform(-BOID_SPEED, BOID_SPEED);
+    const auto dy = rng.uniform(-BOID_SPEED, BOID_SPEED);
+    const auto e = registry.create();
+    registry.emplace<Position>(e, x, y);
+    registry.emplace<Velocity>(e, dx, dy);
+    registry.emplace<Boid>(e);
+  }
+
+  app.add_system_to_stage<nova::stages::PreUpdate>(rebuild_boid_grid)
+      .add_system(nova::system(steer_boids).label("steer"))
+      .add_system(
+          nova::system(apply_steering).label("apply").after("steer"))
+      .add_system(nova::system(integrate).after("apply"))
+      .add_system_to_stage<nova::stages::PostUpdate>(wrap_around);
+}
+
+// N-body: every body is pulled by a fixed set of massive attractors, which
+// also pull each other (the restricted problem, so that a million bodies
+// remain tractable).
+
+constexpr auto N_ATTRACTORS = std::size_t{64};
+constexpr auto GRAVITY = 50.f;
+constexpr auto SOFTENING_SQ = 1.f;
+
+struct Mass {
+  float value{};
+};
+
+struct Attractor {
+  float x{};
+  float y{};
+  float mass{};
+};
+
+struct Attractors {
+  std::vector<Attractor> values{};
+};
+
+auto gather_attractors(nova::Resource<Attractors> attractors,
+                       nova::View<nova::With<const Position, const Mass>> view)
+    -> void {
+  attractors->values.clear();
+  for (auto&& [_, pos, mass] : view.each()) {
+    attractors->values.push_back(
+        Attractor{.x = pos.x, .y = pos.y, .mass = mass.value});
+  }
+}
+
+auto gravitate(nova::Resource<const Attractors> attractors,
+               nova::View<nova::With<const Position, Velocity>> view) -> void {
+  const auto values = std::span{attractors->values};
+  for (auto&& [_, pos, vel] : view.each()) {
+    auto ax = 0.f;
+    auto ay = 0.f;
+    for (const auto& attractor : values) {
+      const auto dx = attractor.x - pos.x;
+      const auto dy = attractor.y - pos.y;
+      const auto distance_sq = dx * dx + dy * dy + SOFTENING_SQ;
+      const auto pull =
+          GRAVITY * attractor.mass / (distance_sq * std::sqrt(distance_sq));
+      ax += dx * pull;
+      ay += dy * pull;
+    }
+    vel.dx += ax * DT;
+    vel.dy += ay * DT;
+  }
+}
+
+auto setup_nbody(nova::App& app, const std::size_t n) -> void {
+  app.insert_resource<Attractors>();
+
+  const auto extent = std::sqrt(static_cast<float>(n));
+  auto& registry = app.world.registry();
+  auto& rng = **app.world.resources().get<Rng>();
+  for (auto i = std::size_t{0}; i < n; ++i) {
+    const auto e = registry.create();
+    const auto x = rng.uniform(-extent, extent);
+    const auto y = rng.uniform(-extent, extent);
+    registry.emplace<Position>(e, x, y);
+    // a rough orbit around the origin.
+    registry.emplace<Velocity>(e, -y * 0.1f, x * 0.1f);
+    if (i < N_ATTRACTORS) {
+      registry.emplace<Mass>(e, rng.uniform(1.f, 10.f));
+    }
+  }
+
+  app.add_system_to_stage<nova::stages::PreUpdate>(gather_attractors)
+      .add_system(nova::system(gravitate).label("gravitate"))
+      .add_system(nova::system(integrate).after("gravitate"));
+}
+
+struct Scenario {
+  std::string_view name;
+  void (*setup)(nova::App&, std::size_t);
+};
+
+constexpr auto scenarios = std::array{
+    Scenario{"particles", setup_particles},
+    Scenario{"boids", setup_boids},
+    Scenario{"nbody", setup_nbody},
+};
+
+struct Options {
+  std::vector<std::string_view> scenarios{};
+  std::size_t max_entities{1'000'000u};
+  bool parallel{true};
+};
+
+// Times the frames run by the default runner after `warmup` ones, and has it
+// exit once `frames` are timed.
+class FrameTimer final : public nova::SchedulerObserver {
+  std::size_t warmup_;
+  std::size_t frames_;
+  std::size_t frame_ = 0u;
+  bench::clock_t::time_point start_{};
+  std::vector<bench::millis_t> times_{};
+
+ public:
+  FrameTimer(const std::size_t warmup, const std::size_t frames)
+      : warmup_(warmup), frames_(frames) {
+    times_.reserve(frames);
+  }
+
+  auto on_frame_begin(const std::size_t /*n_stages*/) -> void override {
+    start_ = bench::clock_t::now();
+  }
+
+  auto on_frame_end(nova::World& world, const nova::Scheduler& /*scheduler*/)
+      -> void override {
+    if (frame_++ >= warmup_) {
+      times_.emplace_back(bench::clock_t::now() - start_);
+    }
+    if (std::size(times_) == frames_) {
+      (*world.resources().get<nova::AppExit>())->should_exit = true;
+    }
+  }
+
+  [[nodiscard]] auto times() -> std::vector<bench::millis_t>& {
+    return times_;
+  }
+};
+
+// FNV-1a over the positions, in the (deterministic) order of the pool.
+auto checksum(const nova::Registry& registry) -> std::uint32_t {
+  auto hash = 2'166'136'261u;
+  for (auto&& [_, pos] : registry.view<const Position>().each()) {
+    for (const auto value : {pos.x, pos.y}) {
+      auto bits = std::uint32_t{};
+      std::memcpy(&bits, &value, sizeof(bits));
+      hash = (hash ^ bits) * 16'777'619u;
+    }
+  }
+  return hash;
+}
+
+auto run(const Scenario& scenario, const std::size_t n,
+         const std::size_t frames, const bool parallel) -> void {
+  constexpr auto warmup_frames = std::size_t{5};
+
+  auto app = nova::App{};
+  app.add_plugin(nova::DefaultPlugins{})
+      .insert_resource<Rng>()
+      .insert_resource<FrameTimer>(warmup_frames, frames);
+  app.scheduler.observe<FrameTimer>();
+  if (parallel) {
+    app.add_plugin(nova::TaskPoolPlugin{});
+  }
+  scenario.setup(app, n);
+  app.run();
+
+  auto& times = (*app.world.resources().get<FrameTimer>())->times();
+  auto total = bench::millis_t{};
+  for (const auto time : times) {
+    total += time;
+  }
+  std::ranges::sort(times);
+  const auto entities_per_second = static_cast<double>(n * frames) /
+                                   std::chrono::duration<double>{total}.count();
+
+  std::printf(
+      "%-10.*s n=%-9zu frames=%-4zu p50 %9.3f  p90 %9.3f  p99 %9.3f  "
+      "max %9.3f ms  %8.2f M entities/s  checksum %08x\n",
+      static_cast<int>(std::size(scenario.name)), std::data(scenario.name), n,
+      frames, bench::percentile(times, 0.5).count(),
+      bench::percentile(times, 0.9).count(),
+      bench::percentile(times, 0.99).count(), times.back().count(),
+      entities_per_second / 1e6, checksum(app.world.registry()));
+}
+
+auto is_scenario(const std::string_view name) -> bool {
+  return std::ranges::find(scenarios, name, &Scenario::name) !=
+         std::end(scenarios);
+}
+
+auto parse(std::span<char*> args) -> Options {
+  auto options = Options{};
+  for (const std::string_view arg : args) {
+    const auto* const last = std::data(arg) + std::size(arg);
+    auto max_entities = std::size_t{};
+    if (arg == "--serial") {
+      options.parallel = false;
+    } else if (const auto [ptr, error] =
+                   std::from_chars(std::data(arg), last, max_entities);
+               error == std::errc{} and ptr == last) {
+      options.max_entities = max_entities;
+    } else {
+      options.scenarios.push_back(arg);
+    }
+  }
+  return options;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const auto options = parse(std::span{argv, static_cast<std::size_t>(argc)}
+                                 .subspan(1u));
+  for (const auto name : options.scenarios) {
+    if (not is_scenario(name)) {
+      std::fprintf(stderr, "unknown scenario: %.*s\n%s",
+                   static_cast<int>(std::size(name)), std::data(name), USAGE);
+      return 1;
+    }
+  }
+
+  for (const auto& scenario : scenarios) {
+    if (not std::empty(options.scenarios) and
+        std::ranges::find(options.scenarios, scenario.name) ==
+            std::end(options.scenarios)) {
+      continue;
+    }
+    for (const auto n : {std::size_t{10'000}, std::size_t{100'000},
+                         std::size_t{1'000'000}}) {
+      if (n > options.max_entities) {
+        continue;
+      }
+      // about the same work for every size.
+      const auto frames = std::clamp<std::size_t>(2'000'000u / n, 10u, 200u);
+      run(scenario, n, frames, options.parallel);
+    }
+  }
+}
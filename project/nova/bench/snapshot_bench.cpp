@@ -0,0 +1,66 @@
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "common.hpp"
+#include "nova/snapshot/snapshot.hpp"
+#include "nova/world.hpp"
+
+namespace {
+
+struct position {
+  float x{};
+  float y{};
+};
+
+struct velocity {
+  float dx{};
+  float dy{};
+};
+
+struct tag {
+  std::string value{};
+};
+
+auto populate(nova::World& world, const std::size_t n) -> void {
+  auto& registry = world.registry();
+  auto entities = std::vector<entt::entity>(n);
+  registry.create(std::begin(entities), std::end(entities));
+  for (auto i = std::size_t{0}; i < n; ++i) {
+    const auto f = static_cast<float>(i);
+    registry.emplace<position>(entities[i], position{.x = f, .y = f});
+    registry.emplace<velocity>(entities[i], velocity{.dx = f, .dy = -f});
+    // a few entities with a component that is written member by member.
+    if (i % 100u == 0u) {
+      registry.emplace<tag>(entities[i], tag{.value = "tagged"});
+    }
+  }
+}
+
+}  // namespace
+
+// the target is a save and a load of 1M entities in under 100 ms each.
+int main() {
+  const auto snapshot = nova::Snapshot{}
+                            .component<position>()
+                            .component<velocity>()
+                            .component<tag>();
+
+  for (const auto n : {std::size_t{10'000}, std::size_t{100'000},
+                       std::size_t{1'000'000}}) {
+    auto world = nova::World{};
+    populate(world, n);
+
+    auto bytes = std::vector<std::byte>{};
+    const auto save = bench::measure(5u, [&] {
+      bytes.clear();
+      snapshot.save(world, bytes);
+    });
+    bench::report("Snapshot::save", n, save);
+
+    auto restored = nova::World{};
+    const auto load =
+        bench::measure(5u, [&] { snapshot.load(restored, bytes); });
+    bench::report("Snapshot::load", n, load);
+  }
+}
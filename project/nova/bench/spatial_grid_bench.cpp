@@ -0,0 +1,65 @@
+#include <cmath>
+#include <entt/entt.hpp>
+#include <random>
+#include <string>
+
+#include "common.hpp"
+#include "nova/spatial/spatial_grid.hpp"
+
+namespace {
+
+using position_view_t = nova::View<nova::With<const nova::Position>>;
+
+// Spreads `n` entities over a square holding `density` entities per cell on
+// average.
+auto make_registry(const std::size_t n, const float cell_size,
+                   const float density) -> entt::registry {
+  const auto extent =
+      std::sqrt(static_cast<float>(n) / density) * cell_size / 2.f;
+  auto gen = std::mt19937{42u};
+  auto distrib = std::uniform_real_distribution<float>{-extent, extent};
+
+  auto registry = entt::registry{};
+  for (auto i = std::size_t{0}; i < n; ++i) {
+    registry.emplace<nova::Position>(registry.create(), distrib(gen),
+                                     distrib(gen));
+  }
+  return registry;
+}
+
+}  // namespace
+
+int main() {
+  constexpr auto cell_size = 16.f;
+  constexpr auto n_queries = std::size_t{10'000};
+
+  auto pool = nova::TaskPool{};
+
+  for (const auto n : {std::size_t{100'000}, std::size_t{1'000'000}}) {
+    for (const auto density : {0.5f, 4.f, 32.f}) {
+      auto registry = make_registry(n, cell_size, density);
+      const auto view =
+          position_view_t{registry.view<const nova::Position>()};
+      const auto suffix = " (density " + std::to_string(density) + ")";
+
+      auto grid = nova::SpatialGrid{cell_size};
+      bench::report("rebuild" + suffix, n,
+                    bench::measure(10u, [&] { grid.rebuild(view); }));
+      bench::report("rebuild, parallel" + suffix, n,
+                    bench::measure(10u, [&] { grid.rebuild(view, &pool); }));
+
+      const auto entries = grid.entries();
+      auto found = std::size_t{0};
+      const auto queries = bench::measure(5u, [&] {
+        for (auto i = std::size_t{0}; i < n_queries; ++i) {
+          const auto& entry = entries[(i * 7'919u) % std::size(entries)];
+          grid.for_each_in_radius(entry.x, entry.y, cell_size,
+                                  [&](const auto&) { ++found; });
+        }
+      });
+      bench::report("10k radius queries" + suffix, n, queries);
+      std::printf("  average neighbours: %.1f\n",
+                  static_cast<double>(found) / (5.0 * n_queries));
+    }
+  }
+}
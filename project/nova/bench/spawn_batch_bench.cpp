@@ -0,0 +1,71 @@
+#include <vector>
+
+#include "common.hpp"
+#include "nova/registry.hpp"
+
+namespace {
+
+struct position {
+  float x{};
+  float y{};
+};
+
+struct velocity {
+  float dx{};
+  float dy{};
+};
+
+struct radius {
+  float value{};
+};
+
+struct ShapeBundle {
+  using is_bundle = void;
+
+  position pos{};
+  radius r{};
+};
+
+struct CircleBundle {
+  using is_bundle = void;
+
+  velocity vel{};
+  ShapeBundle shape{};
+};
+
+auto make_bundles(const std::size_t n) -> std::vector<CircleBundle> {
+  auto bundles = std::vector<CircleBundle>{};
+  bundles.reserve(n);
+  for (auto i = std::size_t{0}; i < n; ++i) {
+    const auto f = static_cast<float>(i);
+    bundles.push_back(CircleBundle{
+        .vel = velocity{.dx = f, .dy = -f},
+        .shape = ShapeBundle{.pos = position{.x = f, .y = f},
+                             .r = radius{.value = 1.f}},
+    });
+  }
+  return bundles;
+}
+
+}  // namespace
+
+int main() {
+  for (const auto n : {std::size_t{10'000}, std::size_t{100'000},
+                       std::size_t{1'000'000}}) {
+    const auto bundles = make_bundles(n);
+
+    const auto emplace = bench::measure(5u, [&] {
+      auto registry = nova::Registry{};
+      for (const auto& bundle : bundles) {
+        registry.emplace_bundle(registry.create(), bundle);
+      }
+    });
+    bench::report("emplace_bundle (loop)", n, emplace);
+
+    const auto batch = bench::measure(5u, [&] {
+      auto registry = nova::Registry{};
+      registry.spawn_batch(bundles);
+    });
+    bench::report("spawn_batch", n, batch);
+  }
+}
@@ -47,6 +47,17 @@ struct App {
     return *this;
   }
 
+  /// @brief Inserts a resource that may only be used from the main thread
+  /// (see `NonSend<T>`). The calling thread must be the one running the app.
+  ///
+  /// @tparam TResource The resource type
+  /// @param args The arguments used to construct the resource.
+  template <typename TResource>
+  auto insert_non_send_resource(auto&&... args) -> auto& {
+    world.resources().set_non_send<TResource>(FWD(args)...);
+    return *this;
+  }
+
   /// @brief Adds a new stage to the scheduler.
   ///
   /// @tparam TStage The stage type.
@@ -68,6 +79,30 @@ struct App {
     return *this;
   }
 
+  /// @brief Adds a new system to the specified stage of an app whose
+  /// scheduler is already initialized, between two updates. Only the affected
+  /// stage is re-ordered and only the new system's state is initialized.
+  /// A system set is inserted as a whole, or not at all if this throws.
+  ///
+  /// @param system The system to add.
+  /// @param stage The stage the systems should to added to.
+  template <typename TStage, typename TSystem>
+  auto insert_system_to_stage(TSystem&& system, TStage&& stage = {}) -> auto& {
+    scheduler.insert_system_to_stage(world, FWD(system), FWD(stage));
+    return *this;
+  }
+
+  /// @brief Removes every system with the given label from a stage.
+  ///
+  /// @param label The label of the systems to remove.
+  /// @param stage The stage the systems should be removed from.
+  /// @return The number of removed systems.
+  template <typename TStage, typename TLabel>
+  auto remove_systems_from_stage(TLabel&& label, TStage&& stage = {})
+      -> std::size_t {
+    return scheduler.remove_systems_from_stage(FWD(label), FWD(stage));
+  }
+
   /// @brief Adds a new startup system (only runs once at the beginning).
   ///
   /// @param system The startup system to add.
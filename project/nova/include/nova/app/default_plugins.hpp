@@ -1,13 +1,21 @@
 #pragma once
 
+#include <nova/task/task_pool.hpp>
 #include <nova/time/time_plugin.hpp>
 
 #include "app.hpp"
 
 namespace nova {
 
+// With a `TaskPool`, independent systems run concurrently on it, and the
+// systems that must run on the main thread run on the calling thread.
 inline auto default_runner(App& app) {
-  app.scheduler.initialize_systems(app.world);
+  auto pool = app.world.resources().get<TaskPool>();
+  if (pool.has_value()) {
+    app.scheduler.initialize_systems(app.world, **pool);
+  } else {
+    app.scheduler.initialize_systems(app.world);
+  }
   app.scheduler.startup(app.world);
   for (;;) {
     const auto should_exit = std::as_const(app.world)
@@ -21,7 +29,11 @@ inline auto default_runner(App& app) {
     if (should_exit) [[unlikely]] {
       break;
     }
-    app.update();
+    if (pool.has_value()) {
+      app.scheduler.update(app.world, **pool);
+    } else {
+      app.update();
+    }
   }
   app.scheduler.teardown(app.world);
 }
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <nova/app/app.hpp>
+#include <nova/app/core_stages.hpp>
+#include <nova/system/system.hpp>
+#include <nova/system/system_builder.hpp>
+#include <nova/task/task_pool.hpp>
+
+#include "asset_server.hpp"
+
+namespace nova {
+
+struct UpdateAssetsSystem {};
+
+inline auto update_assets(Resource<AssetServer> server) -> void {
+  server->update();
+}
+
+inline auto stop_asset_server(Resource<AssetServer> server) -> void {
+  server->stop();
+}
+
+/// @brief Adds an `AssetServer` resource, decoding on the `TaskPool` when
+/// the `TaskPoolPlugin` was added first, and publishes the finished loads at
+/// the start of every frame.
+///
+/// Startup systems only start the loads and keep the handles; the systems
+/// using the assets poll them every frame:
+/// ```cpp
+/// auto load_level(Resource<AssetServer> server, Resource<Level> level) {
+///   level->data = server->load<LevelData>("levels/1.json");
+/// }
+///
+/// auto build_level(Resource<const AssetServer> server,
+///                  Resource<const Level> level) {
+///   if (const auto* data = server->get(level->data)) { ... }
+/// }
+/// ```
+///
+/// The root directory can be chosen by inserting an `AssetServer` before
+/// adding the plugin.
+struct AssetPlugin {
+  auto operator()(App& app) -> void {
+    auto& resources = app.world.resources();
+    auto pool = resources.get<TaskPool>();
+    resources.try_add<AssetServer>(pool.has_value() ? &**pool : nullptr);
+    app.add_system_to_stage<stages::First>(
+           system(update_assets).label<UpdateAssetsSystem>())
+        .add_teardown_system(stop_asset_server);
+  }
+};
+
+}  // namespace nova
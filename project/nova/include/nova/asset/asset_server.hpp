@@ -0,0 +1,416 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <nova/task/task_pool.hpp>
+#include <nova/task/task_set.hpp>
+#include <nova/util/common.hpp>
+#include <nova/util/type.hpp>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "file_bytes.hpp"
+#include "handle.hpp"
+
+namespace nova {
+
+/// @brief Decodes the bytes of the file at the given path into an asset.
+/// Loaders run on the task pool, possibly several at once, and report
+/// errors by throwing.
+template <typename T>
+using AssetLoader =
+    std::function<T(std::span<const std::byte>, const std::filesystem::path&)>;
+
+namespace detail {
+
+template <typename T>
+struct AssetResult {
+  AssetResult* next = nullptr;
+  AssetId id{};
+  std::optional<T> value{};
+  std::string error{};
+};
+
+[[nodiscard]] inline auto exception_message(const std::exception_ptr& error)
+    -> std::string {
+  try {
+    std::rethrow_exception(error);
+  } catch (const std::exception& e) {
+    return e.what();
+  } catch (...) {
+    return "unknown error";
+  }
+}
+
+struct AssetRequest {
+  std::filesystem::path path{};
+  std::function<void(FileBytes)> decode{};
+  std::function<void(std::exception_ptr)> fail{};
+};
+
+class AssetStorageBase {
+ public:
+  virtual ~AssetStorageBase() = default;
+
+  virtual auto update() -> void = 0;
+  [[nodiscard]] virtual auto pending() const noexcept -> std::size_t = 0;
+};
+
+template <typename T>
+class AssetStorage final : public AssetStorageBase {
+ public:
+  using results_t = CompletionQueue<AssetResult<T>>;
+
+  AssetLoader<T> loader{};
+  std::deque<AssetSlot<T>> slots{};
+  // the handle counts of `slots`, by index. Shared with the handles, which
+  // may outlive the storage, and a deque so that the counts never move.
+  std::shared_ptr<std::deque<AssetRefs>> refs{
+      std::make_shared<std::deque<AssetRefs>>()};
+  std::vector<std::uint32_t> free_slots{};
+  std::unordered_map<std::string, std::uint32_t> by_path{};
+  // shared with the loads in flight, which may outlive the storage.
+  std::shared_ptr<results_t> results{std::make_shared<results_t>()};
+  std::size_t n_pending = 0u;
+
+  explicit(true) AssetStorage(AssetLoader<T> asset_loader)
+      : loader(MOV(asset_loader)) {}
+
+  [[nodiscard]] auto allocate() -> AssetSlot<T>& {
+    if (not std::empty(free_slots)) {
+      const auto index = free_slots.back();
+      free_slots.pop_back();
+      return slots[index];
+    }
+    refs->emplace_back(0u);
+    return slots.emplace_back(static_cast<std::uint32_t>(std::size(slots)));
+  }
+
+  // the count of the handles to `slot`, kept alive by the result.
+  [[nodiscard]] auto share_refs(const AssetSlot<T>& slot) const
+      -> std::shared_ptr<AssetRefs> {
+    return std::shared_ptr<AssetRefs>{refs, &(*refs)[slot.index]};
+  }
+
+  [[nodiscard]] auto find(const AssetId id) const noexcept
+      -> const AssetSlot<T>* {
+    if (id.index >= std::size(slots)) {
+      return nullptr;
+    }
+    const auto& slot = slots[id.index];
+    return slot.generation == id.generation ? &slot : nullptr;
+  }
+
+  auto update() -> void override {
+    for (auto* node = results->take_all(); node != nullptr;) {
+      const auto result = std::unique_ptr<AssetResult<T>>{node};
+      node = node->next;
+
+      auto& slot = slots[result->id.index];
+      // the asset was unloaded while it was loading.
+      if (slot.generation != result->id.generation) {
+        continue;
+      }
+      --n_pending;
+      if (result->value.has_value()) {
+        slot.value = MOV(result->value);
+        slot.state = AssetState::loaded;
+      } else {
+        slot.error = MOV(result->error);
+        slot.state = AssetState::failed;
+      }
+    }
+
+    // no handle can be created for a slot without handles but by `load`,
+    // which runs on this thread: a count of zero cannot change under us.
+    for (auto& slot : slots) {
+      if (slot.state != AssetState::unloaded and
+          (*refs)[slot.index].load(std::memory_order_acquire) == 0u) {
+        unload(slot);
+      }
+    }
+  }
+
+  [[nodiscard]] auto pending() const noexcept -> std::size_t override {
+    return n_pending;
+  }
+
+ private:
+  auto unload(AssetSlot<T>& slot) -> void {
+    if (slot.state == AssetState::loading) {
+      --n_pending;
+    }
+    by_path.erase(slot.path.string());
+    slot.value.reset();
+    slot.error.clear();
+    slot.path.clear();
+    slot.state = AssetState::unloaded;
+    ++slot.generation;
+    free_slots.push_back(slot.index);
+  }
+};
+
+}  // namespace detail
+
+/// @brief Loads assets from files without blocking the frame.
+///
+/// Files are read on a dedicated I/O thread, memory mapped when they are
+/// large, and decoded by their type's `AssetLoader` on the task pool (or on
+/// the I/O thread without one). `load` returns a `Handle` right away; the
+/// asset shows up once `update()` publishes the finished loads, which the
+/// `AssetPlugin` does at the start of every frame. Systems poll the handle
+/// until `get` returns the asset.
+///
+/// Loading a path that is already loaded (or loading) returns a handle to
+/// the same asset. Assets are unloaded by `update()` once their last handle
+/// is dropped, and their slot is reused for later loads with a new
+/// generation, so stale `AssetId`s never refer to the wrong asset.
+///
+/// Everything but the handles' reference counts belongs to the thread
+/// calling `load` and `update`. Handles may outlive the server, e.g. in a
+/// resource destroyed after it.
+class AssetServer {
+  TaskPool* pool_;
+  std::filesystem::path root_;
+  std::size_t mmap_threshold_;
+  std::unordered_map<TypeId, std::unique_ptr<detail::AssetStorageBase>>
+      storages_{};
+
+  std::mutex mutex_{};
+  std::condition_variable_any cv_{};
+  std::deque<detail::AssetRequest> requests_{};
+  // declared last so it is joined before the queue it reads is destroyed.
+  std::jthread io_thread_{};
+
+  template <typename T>
+  [[nodiscard]] auto storage() -> detail::AssetStorage<T>& {
+    const auto iter = storages_.find(type_id<T>());
+    if (iter == std::end(storages_)) [[unlikely]] {
+      throw nova_exception{
+          std::format("AssetServer: no loader registered for `{}`",
+                      type_id<T>().name())};
+    }
+    return static_cast<detail::AssetStorage<T>&>(*iter->second);
+  }
+
+  template <typename T>
+  [[nodiscard]] auto find(const AssetId id) const
+      -> const detail::AssetSlot<T>* {
+    const auto iter = storages_.find(type_id<T>());
+    if (iter == std::end(storages_)) {
+      return nullptr;
+    }
+    return static_cast<const detail::AssetStorage<T>&>(*iter->second).find(id);
+  }
+
+  auto io_loop(const std::stop_token& stop) -> void {
+    for (;;) {
+      auto request = detail::AssetRequest{};
+      {
+        auto lock = std::unique_lock{mutex_};
+        const auto has_request = [&] { return not std::empty(requests_); };
+        if (not cv_.wait(lock, stop, has_request)) {
+          return;
+        }
+        request = MOV(requests_.front());
+        requests_.pop_front();
+      }
+
+      auto bytes = FileBytes{};
+      try {
+        bytes = FileBytes::read(request.path, mmap_threshold_);
+      } catch (...) {
+        request.fail(std::current_exception());
+        continue;
+      }
+
+      if (pool_ != nullptr) {
+        // tasks must be copyable, the bytes are shared rather than moved in.
+        pool_->spawn([decode = MOV(request.decode),
+                      shared = std::make_shared<FileBytes>(MOV(bytes))] {
+          decode(MOV(*shared));
+        });
+      } else {
+        request.decode(MOV(bytes));
+      }
+    }
+  }
+
+ public:
+  /// @brief Paths given to `load` are relative to `root`. Files of at least
+  /// `mmap_threshold` bytes are memory mapped rather than read.
+  explicit(true) AssetServer(
+      TaskPool* const pool = nullptr, std::filesystem::path root = {},
+      const std::size_t mmap_threshold = FileBytes::DEFAULT_MMAP_THRESHOLD)
+      : pool_(pool), root_(MOV(root)), mmap_threshold_(mmap_threshold) {
+    io_thread_ = std::jthread{
+        [this](const std::stop_token& stop) { io_loop(stop); }};
+  }
+
+  AssetServer(AssetServer&&) = delete;
+  AssetServer(AssetServer const&) = delete;
+  AssetServer& operator=(AssetServer&&) = delete;
+  AssetServer& operator=(AssetServer const&) = delete;
+
+  ~AssetServer() { stop(); }
+
+  [[nodiscard]] auto root() const noexcept -> const std::filesystem::path& {
+    return root_;
+  }
+
+  /// @brief Sets how assets of type `T` are decoded, which must happen
+  /// before they are loaded.
+  template <typename T, typename TLoader>
+  auto register_loader(TLoader&& loader) -> AssetServer& {
+    auto asset_loader = AssetLoader<T>{FWD(loader)};
+    if (auto iter = storages_.find(type_id<T>()); iter != std::end(storages_)) {
+      static_cast<detail::AssetStorage<T>&>(*iter->second).loader =
+          MOV(asset_loader);
+    } else {
+      storages_.emplace(
+          type_id<T>(),
+          std::make_unique<detail::AssetStorage<T>>(MOV(asset_loader)));
+    }
+    return *this;
+  }
+
+  template <typename T>
+  [[nodiscard]] auto has_loader() const -> bool {
+    return storages_.contains(type_id<T>());
+  }
+
+  /// @brief Starts loading the asset at `path`, unless it is already loaded
+  /// or loading. Throws a `nova_exception` if no loader is registered for
+  /// `T`, or once the server is stopped.
+  template <typename T>
+  [[nodiscard]] auto load(const std::filesystem::path& path) -> Handle<T> {
+    auto& assets = storage<T>();
+    auto full_path = (root_ / path).lexically_normal();
+    auto key = full_path.string();
+    if (const auto iter = assets.by_path.find(key);
+        iter != std::end(assets.by_path)) {
+      const auto& slot = assets.slots[iter->second];
+      return Handle<T>{assets.share_refs(slot), slot.id()};
+    }
+    if (not io_thread_.joinable()) [[unlikely]] {
+      throw nova_exception{"AssetServer: cannot load assets once stopped"};
+    }
+
+    auto& slot = assets.allocate();
+    slot.state = AssetState::loading;
+    slot.path = full_path;
+    assets.by_path.emplace(MOV(key), slot.index);
+    ++assets.n_pending;
+    auto handle = Handle<T>{assets.share_refs(slot), slot.id()};
+
+    auto request = detail::AssetRequest{
+        .path = full_path,
+        .decode =
+            [loader = assets.loader, results = assets.results, id = slot.id(),
+             path = full_path](FileBytes bytes) {
+              auto result = std::make_unique<detail::AssetResult<T>>();
+              result->id = id;
+              try {
+                result->value.emplace(loader(bytes.bytes(), path));
+              } catch (...) {
+                result->error =
+                    detail::exception_message(std::current_exception());
+              }
+              results->push(result.release());
+            },
+        .fail =
+            [results = assets.results, id = slot.id()](
+                const std::exception_ptr& error) {
+              auto result = std::make_unique<detail::AssetResult<T>>();
+              result->id = id;
+              result->error = detail::exception_message(error);
+              results->push(result.release());
+            },
+    };
+    {
+      auto lock = std::scoped_lock{mutex_};
+      requests_.push_back(MOV(request));
+    }
+    cv_.notify_one();
+    return handle;
+  }
+
+  /// @brief Publishes the loads that finished since the last call and
+  /// unloads the assets without handles.
+  auto update() -> void {
+    for (auto& [_, assets] : storages_) {
+      assets->update();
+    }
+  }
+
+  /// @brief Stops the I/O thread. Loads that were not read yet never finish.
+  auto stop() -> void {
+    if (io_thread_.joinable()) {
+      io_thread_.request_stop();
+      io_thread_.join();
+    }
+  }
+
+  /// @brief The number of loads whose result was not published yet.
+  [[nodiscard]] auto pending() const noexcept -> std::size_t {
+    auto n = std::size_t{0};
+    for (const auto& [_, assets] : storages_) {
+      n += assets->pending();
+    }
+    return n;
+  }
+
+  /// @brief The state of the asset, `unloaded` if `id` is stale.
+  template <typename T>
+  [[nodiscard]] auto state(const AssetId id) const -> AssetState {
+    const auto* const slot = find<T>(id);
+    return slot != nullptr ? slot->state : AssetState::unloaded;
+  }
+
+  template <typename T>
+  [[nodiscard]] auto state(const Handle<T>& handle) const -> AssetState {
+    return state<T>(handle.id());
+  }
+
+  /// @brief The asset, or null while it is loading, if it failed to load or
+  /// if `id` is stale.
+  template <typename T>
+  [[nodiscard]] auto get(const AssetId id) const -> const T* {
+    const auto* const slot = find<T>(id);
+    return slot != nullptr and slot->value.has_value() ? &*slot->value
+                                                       : nullptr;
+  }
+
+  template <typename T>
+  [[nodiscard]] auto get(const Handle<T>& handle) const -> const T* {
+    return get<T>(handle.id());
+  }
+
+  /// @brief Why the asset failed to load, empty unless it failed.
+  template <typename T>
+  [[nodiscard]] auto error(const AssetId id) const -> std::string_view {
+    const auto* const slot = find<T>(id);
+    return slot != nullptr ? std::string_view{slot->error}
+                           : std::string_view{};
+  }
+
+  template <typename T>
+  [[nodiscard]] auto error(const Handle<T>& handle) const -> std::string_view {
+    return error<T>(handle.id());
+  }
+};
+
+}  // namespace nova
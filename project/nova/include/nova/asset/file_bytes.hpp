@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "nova_export.h"
+
+namespace nova {
+
+/// @brief The content of a file, either memory mapped or read into a buffer.
+class FileBytes {
+  std::vector<std::byte> buffer_{};
+  void* mapping_ = nullptr;
+  std::size_t mapped_size_ = 0u;
+
+  NOVA_EXPORT auto unmap() noexcept -> void;
+
+ public:
+  /// @brief Files at least this large are mapped rather than read.
+  static constexpr std::size_t DEFAULT_MMAP_THRESHOLD = 1u << 20u;
+
+  FileBytes() noexcept = default;
+  explicit(true) FileBytes(std::vector<std::byte> buffer) noexcept;
+
+  FileBytes(FileBytes&& other) noexcept;
+  FileBytes& operator=(FileBytes&& other) noexcept;
+  FileBytes(FileBytes const&) = delete;
+  FileBytes& operator=(FileBytes const&) = delete;
+
+  ~FileBytes() { unmap(); }
+
+  /// @brief Reads the file at `path`, mapping it in memory when it holds at
+  /// least `mmap_threshold` bytes and the platform supports it.
+  /// Throws a `nova_exception` if the file cannot be read.
+  [[nodiscard]] NOVA_EXPORT static auto read(
+      const std::filesystem::path& path,
+      std::size_t mmap_threshold = DEFAULT_MMAP_THRESHOLD) -> FileBytes;
+
+  [[nodiscard]] auto bytes() const noexcept -> std::span<const std::byte> {
+    if (mapping_ != nullptr) {
+      return {static_cast<const std::byte*>(mapping_), mapped_size_};
+    }
+    return buffer_;
+  }
+
+  [[nodiscard]] auto size() const noexcept -> std::size_t {
+    return std::size(bytes());
+  }
+
+  [[nodiscard]] auto mapped() const noexcept -> bool {
+    return mapping_ != nullptr;
+  }
+};
+
+inline FileBytes::FileBytes(std::vector<std::byte> buffer) noexcept
+    : buffer_(std::move(buffer)) {}
+
+inline FileBytes::FileBytes(FileBytes&& other) noexcept
+    : buffer_(std::move(other.buffer_)),
+      mapping_(std::exchange(other.mapping_, nullptr)),
+      mapped_size_(std::exchange(other.mapped_size_, 0u)) {}
+
+inline auto FileBytes::operator=(FileBytes&& other) noexcept -> FileBytes& {
+  if (this != &other) {
+    unmap();
+    buffer_ = std::move(other.buffer_);
+    mapping_ = std::exchange(other.mapping_, nullptr);
+    mapped_size_ = std::exchange(other.mapped_size_, 0u);
+  }
+  return *this;
+}
+
+}  // namespace nova
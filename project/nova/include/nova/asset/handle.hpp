@@ -0,0 +1,142 @@
+#pragma once
+
+#include <atomic>
+#include <compare>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <nova/util/common.hpp>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace nova {
+
+enum class AssetState {
+  // never loaded, or unloaded since.
+  unloaded,
+  loading,
+  loaded,
+  failed,
+};
+
+/// @brief Identifies a loaded asset without keeping it alive. Slots are
+/// reused once their asset is unloaded, and the generation tells the new
+/// asset from the old one.
+struct AssetId {
+  std::uint32_t index{};
+  std::uint32_t generation{};
+
+  constexpr auto operator<=>(const AssetId&) const = default;
+};
+
+class AssetServer;
+
+namespace detail {
+
+// the number of live handles of a slot, the only state touched off the main
+// thread. Handles share the storage of the counts, so they stay valid after
+// the server is gone.
+using AssetRefs = std::atomic<std::uint32_t>;
+
+template <typename T>
+struct AssetSlot {
+  std::uint32_t index{};
+  std::uint32_t generation{};
+  AssetState state = AssetState::unloaded;
+  std::optional<T> value{};
+  std::string error{};
+  std::filesystem::path path{};
+
+  explicit(true) AssetSlot(const std::uint32_t slot_index) noexcept
+      : index(slot_index) {}
+
+  [[nodiscard]] auto id() const noexcept -> AssetId {
+    return AssetId{index, generation};
+  }
+};
+
+}  // namespace detail
+
+/// @brief A reference counted handle to an asset of type `T`, returned by
+/// `AssetServer::load`. The asset stays loaded as long as a handle to it is
+/// alive; its content is read through the `AssetServer`.
+///
+/// Handles may be copied and dropped from any thread, and may outlive the
+/// server that issued them, after which they keep no asset alive.
+template <typename T>
+class Handle {
+  // aliases the counts of all the slots of the storage.
+  std::shared_ptr<detail::AssetRefs> refs_{};
+  AssetId id_{};
+
+  friend class AssetServer;
+
+  Handle(std::shared_ptr<detail::AssetRefs> refs, const AssetId id) noexcept
+      : refs_(MOV(refs)), id_(id) {
+    retain();
+  }
+
+  auto retain() const noexcept -> void {
+    if (refs_ != nullptr) {
+      refs_->fetch_add(1u, std::memory_order_relaxed);
+    }
+  }
+
+  auto release() noexcept -> void {
+    if (refs_ != nullptr) {
+      // pairs with the acquire load of the server when it unloads the slot.
+      refs_->fetch_sub(1u, std::memory_order_release);
+      refs_.reset();
+    }
+  }
+
+ public:
+  Handle() noexcept = default;
+
+  Handle(const Handle& other) noexcept : refs_(other.refs_), id_(other.id_) {
+    retain();
+  }
+
+  Handle(Handle&& other) noexcept
+      : refs_(std::exchange(other.refs_, nullptr)), id_(other.id_) {}
+
+  Handle& operator=(const Handle& other) noexcept {
+    if (this != &other) {
+      other.retain();
+      release();
+      refs_ = other.refs_;
+      id_ = other.id_;
+    }
+    return *this;
+  }
+
+  Handle& operator=(Handle&& other) noexcept {
+    if (this != &other) {
+      release();
+      refs_ = std::exchange(other.refs_, nullptr);
+      id_ = other.id_;
+    }
+    return *this;
+  }
+
+  ~Handle() { release(); }
+
+  [[nodiscard]] auto valid() const noexcept -> bool {
+    return refs_ != nullptr;
+  }
+
+  /// @brief The id of the asset, which remains usable after the handle is
+  /// dropped but no longer refers to the asset once it is unloaded.
+  [[nodiscard]] auto id() const noexcept -> AssetId { return id_; }
+
+  /// @brief Drops the reference to the asset.
+  auto reset() noexcept -> void { release(); }
+
+  friend auto operator==(const Handle& lhs, const Handle& rhs) noexcept
+      -> bool {
+    return lhs.refs_ == rhs.refs_ and lhs.id_ == rhs.id_;
+  }
+};
+
+}  // namespace nova
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <array>
+#include <entt/entt.hpp>
+#include <functional>
+#include <nova/registry.hpp>
+#include <nova/util/common.hpp>
+#include <nova/util/meta.hpp>
+#include <nova/util/reflection.hpp>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "bundle.hpp"
+
+namespace nova {
+
+namespace detail {
+
+// Flattens a bundle (and its nested bundles) into a tuple of its components.
+template <typename T>
+auto flatten_bundle(const T& value) {
+  if constexpr (concepts::bundle<T>) {
+    return std::apply(
+        [](const auto&... members) {
+          return std::tuple_cat(flatten_bundle(members)...);
+        },
+        reflect::get_member_references(value));
+  } else {
+    return std::tuple<T>{value};
+  }
+}
+
+template <typename TBundle>
+using flattened_bundle_t =
+    decltype(flatten_bundle(std::declval<const TBundle&>()));
+
+template <typename T>
+using storage_ptr_t = std::remove_reference_t<
+    decltype(std::declval<Registry&>().storage<T>())>*;
+
+template <typename TTuple>
+struct storage_ptrs;
+
+template <typename... Ts>
+struct storage_ptrs<std::tuple<Ts...>> {
+  using type = std::tuple<storage_ptr_t<Ts>...>;
+};
+
+template <typename T, typename TTuple>
+struct tuple_index;
+
+template <typename T, typename... Ts>
+struct tuple_index<T, std::tuple<Ts...>> {
+  static constexpr auto value = [] {
+    constexpr auto matches = std::array{std::is_same_v<T, Ts>...};
+    static_assert((std::is_same_v<T, Ts> + ...) == 1,
+                  "prefab override arguments must name exactly one of the "
+                  "prefab's components");
+    auto index = std::size_t{0};
+    while (not matches[index]) {
+      ++index;
+    }
+    return index;
+  }();
+};
+
+}  // namespace detail
+
+/// @brief A bundle whose component values are resolved once, so that it can
+/// be instantiated many times at the cost of a bulk insert per component.
+/// The storages are looked up once per spawn rather than kept, as the
+/// registry's pools may be replaced in between (e.g. by loading a snapshot).
+///
+/// ```cpp
+/// auto prefab = nova::Prefab{registry, UnitBundle{...}};
+/// // 10k identical units
+/// prefab.spawn(10'000);
+/// // 10k units with their own position
+/// prefab.spawn(10'000, [](const std::size_t i, position& pos) {
+///   pos.x = static_cast<float>(i);
+/// });
+/// ```
+template <concepts::bundle TBundle>
+class Prefab {
+  using components_t = detail::flattened_bundle_t<TBundle>;
+  static constexpr auto n_components = std::tuple_size_v<components_t>;
+
+  template <std::size_t I>
+  using component_t = std::tuple_element_t<I, components_t>;
+
+  using storages_t = typename detail::storage_ptrs<components_t>::type;
+
+  Registry* registry_;
+  components_t defaults_;
+
+  // looked up on every spawn, as the registry's pools may have been replaced.
+  [[nodiscard]] auto storages() const -> storages_t {
+    return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      return storages_t{std::addressof(
+          registry_->template storage<component_t<Is>>())...};
+    }(std::make_index_sequence<n_components>{});
+  }
+
+  template <typename TOverride, typename... TArgs>
+  auto apply_override(TOverride& override, const storages_t& storages,
+                      const std::vector<entt::entity>& entities,
+                      args<std::size_t, TArgs...>) -> void {
+    for (auto index = std::size_t{0}; index < std::size(entities); ++index) {
+      const auto entity = entities[index];
+      std::invoke(override, index,
+                  std::get<detail::tuple_index<std::remove_cvref_t<TArgs>,
+                                               components_t>::value>(storages)
+                      ->get(entity)...);
+    }
+  }
+
+  // Creates `n` entities and inserts every component column into `storages`.
+  auto spawn_into(const storages_t& storages, const std::size_t n)
+      -> std::vector<entt::entity> {
+    auto entities = std::vector<entt::entity>(n);
+    registry_->create(std::begin(entities), std::end(entities));
+
+    [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      (insert_column<Is>(storages, entities), ...);
+    }
+    (std::make_index_sequence<n_components>{});
+
+    return entities;
+  }
+
+  // Appends the default value of the `I`th component to every entity in a
+  // single range insert into its storage.
+  template <std::size_t I>
+  auto insert_column(const storages_t& storages,
+                     const std::vector<entt::entity>& entities) -> void {
+    auto& storage = *std::get<I>(storages);
+    storage.reserve(std::size(storage) + std::size(entities));
+    if constexpr (std::is_empty_v<component_t<I>>) {
+      storage.insert(std::begin(entities), std::end(entities));
+    } else {
+      storage.insert(std::begin(entities), std::end(entities),
+                     std::get<I>(defaults_));
+    }
+  }
+
+ public:
+  explicit(true) Prefab(Registry& registry, const TBundle& bundle)
+      : registry_(std::addressof(registry)),
+        defaults_(detail::flatten_bundle(bundle)) {}
+
+  /// @brief The value a component of the prefab is instantiated with.
+  template <typename T>
+  [[nodiscard]] auto get() -> T& {
+    return std::get<detail::tuple_index<T, components_t>::value>(defaults_);
+  }
+
+  template <typename T>
+  [[nodiscard]] auto get() const -> const T& {
+    return std::get<detail::tuple_index<T, components_t>::value>(defaults_);
+  }
+
+  /// @brief Creates `n` entities with the prefab's components.
+  /// @return The created entities.
+  auto spawn(const std::size_t n) -> std::vector<entt::entity> {
+    return spawn_into(storages(), n);
+  }
+
+  /// @brief Creates `n` entities with the prefab's components, then calls
+  /// `override(index, components&...)` for each of them, where `components`
+  /// is any subset of the prefab's components.
+  /// @return The created entities.
+  template <typename TOverride>
+  auto spawn(const std::size_t n, TOverride&& override)
+      -> std::vector<entt::entity> {
+    const auto found = storages();
+    auto entities = spawn_into(found, n);
+    apply_override(override, found, entities,
+                   args_t<std::remove_cvref_t<TOverride>>{});
+    return entities;
+  }
+};
+
+template <concepts::bundle TBundle>
+Prefab(Registry&, const TBundle&) -> Prefab<TBundle>;
+
+}  // namespace nova
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <algorithm>
+#include <entt/entt.hpp>
+#include <nova/kinematics/kinematics.hpp>
+#include <nova/task/task_pool.hpp>
+#include <nova/util/common.hpp>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace nova {
+
+/// @brief A circle collider centered on the entity's `Position`.
+struct CircleCollider {
+  float radius{};
+};
+
+/// @brief Two entities whose bounding boxes overlap, and which may collide.
+struct CandidatePair {
+  entt::entity first{entt::null};
+  entt::entity second{entt::null};
+
+  constexpr auto operator==(const CandidatePair&) const -> bool = default;
+};
+
+/// @brief The candidate pairs found by the broadphase this frame.
+/// Consumers may read them or `take()` them for themselves.
+struct CollisionPairs {
+  std::vector<CandidatePair> pairs{};
+
+  /// @brief Moves the pairs out, leaving the resource empty.
+  [[nodiscard]] auto take() -> std::vector<CandidatePair> {
+    return std::exchange(pairs, {});
+  }
+};
+
+/// @brief Sweep and prune along the x axis.
+///
+/// The bounding boxes stay sorted by their minimum x from one frame to the
+/// next, so re-sorting them is an insertion sort over an almost sorted array,
+/// close to linear time when objects move little per frame. Entities that
+/// just got a collider are sorted separately and merged in.
+class SweepAndPrune {
+ public:
+  struct Box {
+    float min_x{};
+    float max_x{};
+    float min_y{};
+    float max_y{};
+    entt::entity entity{entt::null};
+  };
+
+ private:
+  // Number of boxes each parallel task sweeps.
+  static constexpr std::size_t SWEEP_BLOCK_SIZE = 4'096u;
+
+  std::vector<Box> boxes_{};
+  // `tracked_[entt::to_entity(e)] == e` when `e` has a box.
+  std::vector<entt::entity> tracked_{};
+  std::vector<std::vector<CandidatePair>> block_pairs_{};
+
+  [[nodiscard]] static auto slot(const entt::entity e) noexcept
+      -> std::size_t {
+    return static_cast<std::size_t>(entt::to_entity(e));
+  }
+
+  [[nodiscard]] static auto make_box(const entt::entity e, const Position& pos,
+                                     const CircleCollider& collider) noexcept
+      -> Box {
+    return Box{
+        .min_x = pos.x - collider.radius,
+        .max_x = pos.x + collider.radius,
+        .min_y = pos.y - collider.radius,
+        .max_y = pos.y + collider.radius,
+        .entity = e,
+    };
+  }
+
+  [[nodiscard]] static auto by_min_x(const Box& lhs, const Box& rhs) noexcept
+      -> bool {
+    return lhs.min_x < rhs.min_x;
+  }
+
+  // Sorts `boxes_[0, n)`, which are expected to be almost sorted. Falls back
+  // to a full sort when too many boxes moved (e.g. after teleports).
+  auto insertion_sort(const std::size_t n) -> void {
+    const auto max_moves = 16u * n;
+    auto moves = std::size_t{0};
+    for (auto i = std::size_t{1}; i < n; ++i) {
+      if (not by_min_x(boxes_[i], boxes_[i - 1u])) {
+        continue;
+      }
+      const auto box = boxes_[i];
+      auto j = i;
+      for (; j > 0u and by_min_x(box, boxes_[j - 1u]); --j) {
+        boxes_[j] = boxes_[j - 1u];
+      }
+      boxes_[j] = box;
+
+      moves += i - j;
+      if (moves > max_moves) [[unlikely]] {
+        std::sort(std::begin(boxes_), std::begin(boxes_) + n, by_min_x);
+        return;
+      }
+    }
+  }
+
+  auto sweep(const std::size_t first, const std::size_t last,
+             std::vector<CandidatePair>& out) const -> void {
+    for (auto i = first; i < last; ++i) {
+      const auto& box = boxes_[i];
+      for (auto j = i + 1u;
+           j < std::size(boxes_) and boxes_[j].min_x <= box.max_x; ++j) {
+        const auto& other = boxes_[j];
+        if (other.min_y <= box.max_y and box.min_y <= other.max_y) {
+          out.push_back(CandidatePair{box.entity, other.entity});
+        }
+      }
+    }
+  }
+
+ public:
+  /// @brief The boxes, sorted by their minimum x.
+  [[nodiscard]] auto boxes() const noexcept -> std::span<const Box> {
+    return boxes_;
+  }
+
+  /// @brief Refreshes the boxes of the entities in `view` (a view over
+  /// `Position` and `CircleCollider`), dropping those that left it, and
+  /// re-sorts them.
+  template <typename TView>
+  auto update(const TView& view) -> void {
+    std::erase_if(boxes_, [&](const Box& box) {
+      if (view.contains(box.entity)) {
+        return false;
+      }
+      tracked_[slot(box.entity)] = entt::null;
+      return true;
+    });
+
+    for (auto& box : boxes_) {
+      const auto& [pos, collider] =
+          view.template get<const Position, const CircleCollider>(box.entity);
+      box = make_box(box.entity, pos, collider);
+    }
+    const auto n_kept = std::size(boxes_);
+    insertion_sort(n_kept);
+
+    for (const auto e : view) {
+      if (slot(e) >= std::size(tracked_)) {
+        tracked_.resize(slot(e) + 1u, entt::null);
+      }
+      if (tracked_[slot(e)] != e) {
+        tracked_[slot(e)] = e;
+        const auto& [pos, collider] =
+            view.template get<const Position, const CircleCollider>(e);
+        boxes_.push_back(make_box(e, pos, collider));
+      }
+    }
+
+    // new boxes are not coherent with the previous frame, so they are sorted
+    // on their own and merged in.
+    const auto middle =
+        std::begin(boxes_) + static_cast<std::ptrdiff_t>(n_kept);
+    std::sort(middle, std::end(boxes_), by_min_x);
+    std::inplace_merge(std::begin(boxes_), middle, std::end(boxes_), by_min_x);
+  }
+
+  /// @brief Writes every pair of overlapping boxes to `out`, replacing its
+  /// content. With a task pool, the sweep is split across the workers and the
+  /// per-task results are concatenated in order.
+  auto find_pairs(std::vector<CandidatePair>& out,
+                  TaskPool* const pool = nullptr) -> void {
+    out.clear();
+    const auto n = std::size(boxes_);
+    if (pool == nullptr or n <= SWEEP_BLOCK_SIZE) {
+      sweep(0u, n, out);
+      return;
+    }
+
+    const auto n_blocks = (n + SWEEP_BLOCK_SIZE - 1u) / SWEEP_BLOCK_SIZE;
+    block_pairs_.resize(n_blocks);
+    pool->parallel_for(n_blocks, [&](const std::size_t block) {
+      auto& pairs = block_pairs_[block];
+      pairs.clear();
+      const auto first = block * SWEEP_BLOCK_SIZE;
+      sweep(first, std::min(n, first + SWEEP_BLOCK_SIZE), pairs);
+    });
+
+    auto total = std::size_t{0};
+    for (const auto& pairs : block_pairs_) {
+      total += std::size(pairs);
+    }
+    out.reserve(total);
+    for (const auto& pairs : block_pairs_) {
+      out.insert(std::end(out), std::begin(pairs), std::end(pairs));
+    }
+  }
+};
+
+}  // namespace nova
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <nova/app/app.hpp>
+#include <nova/app/core_stages.hpp>
+#include <nova/system/system.hpp>
+#include <nova/system/system_builder.hpp>
+
+#include "broadphase.hpp"
+
+namespace nova {
+
+struct BroadphaseSystem {};
+
+/// @brief Updates the sweep and prune structure and publishes this frame's
+/// candidate pairs.
+inline auto broadphase(
+    Resource<SweepAndPrune> sap, Resource<CollisionPairs> pairs,
+    Optional<Resource<TaskPool>> pool,
+    View<With<const Position, const CircleCollider>> view) -> void {
+  sap->update(view);
+  sap->find_pairs(pairs->pairs,
+                  pool.map([](auto p) { return &*p; }).value_or(nullptr));
+}
+
+/// @brief Finds the pairs of entities with a `Position` and a
+/// `CircleCollider` whose bounding boxes overlap, after the update stage.
+/// The pairs are published in the `CollisionPairs` resource, for narrowphase
+/// or gameplay systems to consume.
+struct BroadphasePlugin {
+  auto operator()(App& app) -> void {
+    app.insert_resource<SweepAndPrune>()
+        .insert_resource<CollisionPairs>()
+        .add_system_to_stage<stages::PostUpdate>(
+            system(broadphase).label<BroadphaseSystem>());
+  }
+};
+
+}  // namespace nova
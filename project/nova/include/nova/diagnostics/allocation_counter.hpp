@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+
+#include "nova_export.h"
+
+namespace nova {
+
+/// @brief Whether nova was built with `NOVA_TRACK_ALLOCATIONS`, which
+/// replaces the global `operator new` and `operator delete` to count the
+/// allocations of every thread.
+#ifdef NOVA_TRACK_ALLOCATIONS
+inline constexpr bool allocation_tracking_enabled = true;
+#else
+inline constexpr bool allocation_tracking_enabled = false;
+#endif
+
+/// @brief The heap allocations a thread made.
+struct AllocationCounts {
+  std::uint64_t allocations{};
+  std::uint64_t deallocations{};
+  // the bytes requested by the allocations.
+  std::uint64_t bytes{};
+
+  constexpr auto operator+=(const AllocationCounts& other) noexcept
+      -> AllocationCounts& {
+    allocations += other.allocations;
+    deallocations += other.deallocations;
+    bytes += other.bytes;
+    return *this;
+  }
+
+  constexpr auto operator-=(const AllocationCounts& other) noexcept
+      -> AllocationCounts& {
+    allocations -= other.allocations;
+    deallocations -= other.deallocations;
+    bytes -= other.bytes;
+    return *this;
+  }
+
+  [[nodiscard]] friend constexpr auto operator+(AllocationCounts lhs,
+                                                const AllocationCounts& rhs)
+      -> AllocationCounts {
+    return lhs += rhs;
+  }
+
+  [[nodiscard]] friend constexpr auto operator-(AllocationCounts lhs,
+                                                const AllocationCounts& rhs)
+      -> AllocationCounts {
+    return lhs -= rhs;
+  }
+
+  constexpr auto operator==(const AllocationCounts&) const -> bool = default;
+};
+
+namespace detail {
+
+NOVA_EXPORT auto thread_allocation_counts() noexcept -> const AllocationCounts&;
+
+}  // namespace detail
+
+/// @brief The allocations the calling thread made so far. Always zero
+/// unless `allocation_tracking_enabled`.
+[[nodiscard]] inline auto allocation_counts() noexcept -> AllocationCounts {
+  return detail::thread_allocation_counts();
+}
+
+}  // namespace nova
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <nova/debug/debug.hpp>
+#include <nova/scheduler/observer.hpp>
+#include <nova/system/system_data.hpp>
+#include <nova/util/common.hpp>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "allocation_counter.hpp"
+#include "stage_counters.hpp"
+
+namespace nova {
+
+/// @brief What an `AllocationGuard` does about allocations past its warm-up.
+enum class AllocationPolicy : std::uint8_t {
+  // records them in `violations()` until the next frame, and calls the
+  // reporter.
+  report,
+  // also panics at the end of the frame.
+  panic,
+};
+
+/// @brief The allocations of a system, or of a whole stage.
+using AllocationRecord = CounterRecord<AllocationCounts>;
+using StageAllocations = StageCounters<AllocationCounts>;
+
+/// @brief An allocation past the warm-up.
+struct AllocationViolation {
+  std::uint64_t frame{};
+  std::string stage{};
+  // empty when the scheduler itself allocated.
+  std::string system{};
+  AllocationCounts counts{};
+};
+
+/// @brief Counts the allocations of every system and stage during
+/// `Scheduler::update`, and enforces that frames stop allocating after a
+/// warm-up.
+///
+/// The scheduler only reports to the guard when it `observe`s
+/// `AllocationGuard` and the guard is a resource, and it only observes the
+/// systems when nova is built with `NOVA_TRACK_ALLOCATIONS` (see
+/// `allocation_tracking_enabled`). The first `warmup_frames` frames are free
+/// to allocate, e.g. to grow pools and buffers to their steady size; every
+/// allocation after them is a violation. Only the violations of the last
+/// frame are kept, so that a guard left reporting stays bounded.
+///
+/// Fused kernels are run one pass after the other while the guard observes
+/// them, so that it can name the one that allocates. The scheduler
+/// dispatches without allocating, on a `TaskPool` too, so that the guard
+/// only catches the systems' allocations.
+class AllocationGuard final : public SchedulerObserver {
+ public:
+  using reporter_t = std::function<void(const AllocationViolation&)>;
+
+ private:
+  std::uint64_t warmup_frames_;
+  AllocationPolicy policy_;
+  reporter_t reporter_;
+  detail::StageCountersTable<AllocationCounts> table_{};
+  detail::StageSampler<AllocationCounts, allocation_counts> sampler_{};
+  std::vector<AllocationViolation> violations_{};
+  std::uint64_t violation_count_ = 0u;
+  std::uint64_t frame_ = 0u;
+
+  auto check(const std::uint64_t frame) -> void {
+    violations_.clear();
+    for (const auto& stage : table_.stages()) {
+      for (const auto& system : stage.systems) {
+        if (system.frame.allocations > 0u) {
+          violations_.push_back(AllocationViolation{
+              .frame = frame,
+              .stage = stage.stage.name,
+              .system = system.name,
+              .counts = system.frame,
+          });
+        }
+      }
+      if (stage.scheduler.frame.allocations > 0u) {
+        violations_.push_back(AllocationViolation{
+            .frame = frame,
+            .stage = stage.stage.name,
+            .counts = stage.scheduler.frame,
+        });
+      }
+    }
+
+    violation_count_ += std::size(violations_);
+    if (reporter_) {
+      for (const auto& violation : violations_) {
+        reporter_(violation);
+      }
+    }
+    if (policy_ == AllocationPolicy::panic and not std::empty(violations_)) {
+      const auto& first = violations_.front();
+      PANIC("frame {} allocated in {} place(s) after the warm-up, first in "
+            "`{}` of stage `{}` ({} allocations, {} bytes)",
+            frame, std::size(violations_),
+            std::empty(first.system) ? "the scheduler" : first.system,
+            first.stage, first.counts.allocations, first.counts.bytes);
+    }
+  }
+
+ public:
+  explicit(true) AllocationGuard(
+      const std::uint64_t warmup_frames = 1u,
+      const AllocationPolicy policy = AllocationPolicy::report,
+      reporter_t reporter = {})
+      : warmup_frames_(warmup_frames),
+        policy_(policy),
+        reporter_(MOV(reporter)) {}
+
+  /// @brief Starts a frame of `n_stages` stages.
+  auto begin_frame(const std::size_t n_stages) -> void {
+    table_.begin_frame(n_stages);
+  }
+
+  /// @brief Matches the records of stage `index` to its `systems`. Only
+  /// allocates when the stage changed.
+  auto prepare_stage(const std::size_t index, const std::string_view name,
+                     std::span<const System> systems) -> void {
+    table_.prepare_stage(index, name, systems);
+  }
+
+  /// @brief Adds to the allocations of system `system` of stage `stage`.
+  auto add_system(const std::size_t stage, const std::size_t system,
+                  const AllocationCounts& counts) noexcept -> void {
+    table_.add_system(stage, system, counts);
+  }
+
+  /// @brief Adds to the allocations the scheduler made while running stage
+  /// `stage`, outside of its systems.
+  auto add_scheduler(const std::size_t stage,
+                     const AllocationCounts& counts) noexcept -> void {
+    table_.add_scheduler(stage, counts);
+  }
+
+  /// @brief Ends the frame, and reports its allocations if it is past the
+  /// warm-up.
+  auto end_frame() -> void {
+    table_.end_frame();
+    if (const auto frame = frame_++; frame >= warmup_frames_) {
+      check(frame);
+    }
+  }
+
+  [[nodiscard]] auto observes_systems() const noexcept -> bool override {
+    return allocation_tracking_enabled;
+  }
+
+  [[nodiscard]] auto splits_fused_batches() const noexcept -> bool override {
+    return true;
+  }
+
+  auto on_frame_begin(const std::size_t n_stages) -> void override {
+    begin_frame(n_stages);
+  }
+
+  auto on_stage_begin(const std::size_t index, const std::string_view name,
+                      std::span<const System> systems) -> void override {
+    prepare_stage(index, name, systems);
+    sampler_.begin_stage(std::size(systems));
+  }
+
+  auto on_systems_begin(const std::size_t /*stage*/, const std::size_t first,
+                        const std::size_t /*count*/) noexcept
+      -> void override {
+    sampler_.begin_systems(first);
+  }
+
+  // fused batches are split, so `count` is one.
+  auto on_systems_end(const std::size_t stage, const std::size_t first,
+                      const std::size_t /*count*/) noexcept -> void override {
+    add_system(stage, first, sampler_.end_systems(first));
+  }
+
+  auto on_stage_end(const std::size_t index) -> void override {
+    add_scheduler(index, sampler_.end_stage());
+  }
+
+  // may panic, so best registered first: its `end` hooks then run last.
+  auto on_frame_end(World& /*world*/, const Scheduler& /*scheduler*/)
+      -> void override {
+    end_frame();
+  }
+
+  /// @brief The number of frames tracked so far.
+  [[nodiscard]] auto frames() const noexcept -> std::uint64_t {
+    return frame_;
+  }
+
+  [[nodiscard]] auto warmup_frames() const noexcept -> std::uint64_t {
+    return warmup_frames_;
+  }
+
+  [[nodiscard]] auto stages() const noexcept
+      -> std::span<const StageAllocations> {
+    return table_.stages();
+  }
+
+  /// @brief The violations of the last frame past the warm-up.
+  [[nodiscard]] auto violations() const noexcept
+      -> std::span<const AllocationViolation> {
+    return violations_;
+  }
+
+  /// @brief The number of violations since the start.
+  [[nodiscard]] auto violation_count() const noexcept -> std::uint64_t {
+    return violation_count_;
+  }
+
+  auto clear_violations() noexcept -> void { violations_.clear(); }
+};
+
+}  // namespace nova
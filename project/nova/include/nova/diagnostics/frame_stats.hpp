@@ -0,0 +1,260 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <nova/scheduler/observer.hpp>
+#include <nova/system/system_data.hpp>
+#include <nova/util/common.hpp>
+#include <nova/util/type.hpp>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "hdr_histogram.hpp"
+#include "stage_counters.hpp"
+
+namespace nova {
+
+/// @brief Whether `FrameStats` also times every stage.
+enum class StageTiming : std::uint8_t {
+  off,
+  on,
+};
+
+/// @brief Whether `FrameStats` also times every system.
+enum class SystemTiming : std::uint8_t {
+  off,
+  on,
+};
+
+/// @brief The durations of a frame or stage, in nanoseconds: over the last
+/// frames, and since the start.
+class TimingSeries {
+  std::string name_;
+  WindowedHistogram window_;
+  HdrHistogram lifetime_{};
+
+ public:
+  TimingSeries(std::string name, const std::uint64_t window)
+      : name_(MOV(name)), window_(window) {}
+
+  auto record(const std::chrono::nanoseconds duration) noexcept -> void {
+    const auto ns = static_cast<std::uint64_t>(
+        std::max(duration.count(), std::chrono::nanoseconds::rep{0}));
+    window_.record(ns);
+    lifetime_.record(ns);
+  }
+
+  [[nodiscard]] auto name() const noexcept -> std::string_view {
+    return name_;
+  }
+
+  [[nodiscard]] auto window() const noexcept -> const WindowedHistogram& {
+    return window_;
+  }
+
+  [[nodiscard]] auto lifetime() const noexcept -> const HdrHistogram& {
+    return lifetime_;
+  }
+
+  auto reset() noexcept -> void {
+    window_.reset();
+    lifetime_.reset();
+  }
+};
+
+/// @brief The series of the systems of a stage, named as in the other stats
+/// (see `detail::system_record_name`).
+struct SystemTimings {
+  std::string stage{};
+  std::vector<std::unique_ptr<TimingSeries>> systems{};
+  // the ids of the systems, to detect that the stage changed.
+  std::vector<id_type> ids{};
+};
+
+/// @brief Records how long every `Scheduler::update` takes, and optionally
+/// every stage and every system, while the scheduler `observe`s
+/// `FrameStats` and the `FrameStats` is a resource.
+///
+/// The durations go to high dynamic range histograms, so percentiles (p50,
+/// p90, p99, p99.9) and maxima are available over a sliding window of the
+/// last `window` frames and since the start, in constant memory. Recording
+/// costs a couple of clock reads and relaxed atomic increments per frame,
+/// stage or system, and only allocates when the stages change. Systems are
+/// timed on the thread that runs them; fused kernels are timed as the single
+/// pass they run as, and the duration is shared evenly between them.
+class FrameStats final : public SchedulerObserver {
+  using clock_t = std::chrono::steady_clock;
+
+  std::uint64_t window_;
+  StageTiming stage_timing_;
+  SystemTiming system_timing_;
+  TimingSeries frame_;
+  std::vector<std::unique_ptr<TimingSeries>> stages_{};
+  std::vector<SystemTimings> systems_{};
+  // when each batch of systems of the current stage started.
+  std::vector<clock_t::time_point> system_starts_{};
+  std::size_t current_stage_{};
+  clock_t::time_point frame_start_{};
+  clock_t::time_point stage_start_{};
+  // the stage being timed, named by the scheduler.
+  std::string_view stage_name_{};
+
+ public:
+  explicit(true) FrameStats(
+      const std::uint64_t window = 600u,
+      const StageTiming stage_timing = StageTiming::off,
+      const SystemTiming system_timing = SystemTiming::off)
+      : window_(window),
+        stage_timing_(stage_timing),
+        system_timing_(system_timing),
+        frame_("frame", window) {}
+
+  [[nodiscard]] auto stage_timing() const noexcept -> StageTiming {
+    return stage_timing_;
+  }
+
+  [[nodiscard]] auto system_timing() const noexcept -> SystemTiming {
+    return system_timing_;
+  }
+
+  /// @brief The number of frames the sliding windows cover at most.
+  [[nodiscard]] auto window() const noexcept -> std::uint64_t {
+    return frame_.window().window();
+  }
+
+  auto record_frame(const std::chrono::nanoseconds duration) noexcept
+      -> void {
+    frame_.record(duration);
+  }
+
+  /// @brief Records the duration of stage `index`. A stage named differently
+  /// than before starts a new series.
+  auto record_stage(const std::size_t index, const std::string_view name,
+                    const std::chrono::nanoseconds duration) -> void {
+    if (index >= std::size(stages_)) {
+      stages_.resize(index + 1u);
+    }
+    auto& stage = stages_[index];
+    if (stage == nullptr or stage->name() != name) {
+      stage = std::make_unique<TimingSeries>(std::string{name}, window_);
+    }
+    stage->record(duration);
+  }
+
+  auto on_frame_begin(const std::size_t /*n_stages*/) -> void override {
+    frame_start_ = clock_t::now();
+  }
+
+  [[nodiscard]] auto observes_systems() const noexcept -> bool override {
+    return system_timing_ == SystemTiming::on;
+  }
+
+  auto on_stage_begin(const std::size_t index, const std::string_view name,
+                      std::span<const System> systems) -> void override {
+    if (system_timing_ == SystemTiming::on) {
+      prepare_systems(index, name, systems);
+    }
+    if (stage_timing_ == StageTiming::on) {
+      stage_name_ = name;
+      stage_start_ = clock_t::now();
+    }
+  }
+
+  auto on_systems_begin(const std::size_t /*stage*/, const std::size_t first,
+                        const std::size_t /*count*/) noexcept
+      -> void override {
+    system_starts_[first] = clock_t::now();
+  }
+
+  auto on_systems_end(const std::size_t /*stage*/, const std::size_t first,
+                      const std::size_t count) noexcept -> void override {
+    const auto share = (clock_t::now() - system_starts_[first]) /
+                       static_cast<clock_t::rep>(count);
+    auto& systems = systems_[current_stage_].systems;
+    for (auto i = first; i < first + count; ++i) {
+      systems[i]->record(share);
+    }
+  }
+
+  auto on_stage_end(const std::size_t index) -> void override {
+    if (stage_timing_ == StageTiming::on) {
+      record_stage(index, stage_name_, clock_t::now() - stage_start_);
+    }
+  }
+
+  auto on_frame_end(World& /*world*/, const Scheduler& /*scheduler*/)
+      -> void override {
+    record_frame(clock_t::now() - frame_start_);
+  }
+
+  [[nodiscard]] auto frame() const noexcept -> const TimingSeries& {
+    return frame_;
+  }
+
+  /// @brief The series of the systems of every stage timed so far, by
+  /// stage index.
+  [[nodiscard]] auto systems() const noexcept
+      -> std::span<const SystemTimings> {
+    return systems_;
+  }
+
+  /// @brief The number of stages timed so far.
+  [[nodiscard]] auto stage_count() const noexcept -> std::size_t {
+    return std::size(stages_);
+  }
+
+  /// @brief The series of stage `index`, or null if it was never timed.
+  [[nodiscard]] auto stage(const std::size_t index) const noexcept
+      -> const TimingSeries* {
+    return index < std::size(stages_) ? stages_[index].get() : nullptr;
+  }
+
+  auto reset() noexcept -> void {
+    frame_.reset();
+    for (const auto& stage : stages_) {
+      if (stage != nullptr) {
+        stage->reset();
+      }
+    }
+    for (auto& stage : systems_) {
+      for (const auto& system : stage.systems) {
+        system->reset();
+      }
+    }
+  }
+
+ private:
+  // matches the series of stage `index` to its `systems`, and makes room
+  // for their start times. Only allocates when the stage changed.
+  auto prepare_systems(const std::size_t index, const std::string_view name,
+                       std::span<const System> systems) -> void {
+    current_stage_ = index;
+    system_starts_.resize(std::size(systems));
+    if (index >= std::size(systems_)) {
+      systems_.resize(index + 1u);
+    }
+    auto& stage = systems_[index];
+    const auto same = std::ranges::equal(
+        stage.ids, systems, std::equal_to{}, {},
+        [](const System& system) { return system.meta.id.id(); });
+    if (same and stage.stage == name) {
+      return;
+    }
+    stage.stage = std::string{name};
+    stage.systems.clear();
+    stage.ids.clear();
+    for (auto i = std::size_t{0}; i < std::size(systems); ++i) {
+      stage.systems.push_back(std::make_unique<TimingSeries>(
+          detail::system_record_name(systems, i), window_));
+      stage.ids.push_back(systems[i].meta.id.id());
+    }
+  }
+};
+
+}  // namespace nova
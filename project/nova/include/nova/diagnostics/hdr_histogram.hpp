@@ -0,0 +1,285 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <nova/util/common.hpp>
+#include <span>
+
+namespace nova {
+
+/// @brief Percentiles of the values recorded in a histogram. Percentiles are
+/// the highest value equivalent to the one of that rank, so within
+/// `HdrHistogram::relative_error` of the exact value, and never above `max`.
+struct HistogramSummary {
+  std::uint64_t count{};
+  double mean{};
+  std::uint64_t p50{};
+  std::uint64_t p90{};
+  std::uint64_t p99{};
+  std::uint64_t p999{};
+  std::uint64_t max{};
+
+  constexpr auto operator==(const HistogramSummary&) const -> bool = default;
+};
+
+/// @brief A high dynamic range histogram of integers, e.g. durations in
+/// nanoseconds, in constant memory.
+///
+/// Values below `2^precision_bits` have a bucket each; above, every power of
+/// two is split in `2^(precision_bits - 1)` buckets, which bounds the
+/// relative error of the percentiles. Values from `2^max_value_bits` on share
+/// the last bucket, but still count towards `max`.
+///
+/// Recording is lock-free, and safe from any number of threads. Reading
+/// while other threads record sees some of their values.
+class HdrHistogram {
+ public:
+  static constexpr auto precision_bits = 7u;
+  static constexpr auto max_value_bits = 36u;
+  static constexpr auto bucket_count =
+      (std::size_t{1} << precision_bits) +
+      (max_value_bits - precision_bits) * (std::size_t{1}
+                                           << (precision_bits - 1u));
+  static constexpr auto relative_error =
+      1.0 / static_cast<double>(std::uint64_t{1} << (precision_bits - 1u));
+
+ private:
+  std::array<std::atomic<std::uint64_t>, bucket_count> buckets_{};
+  std::atomic<std::uint64_t> count_ = 0u;
+  std::atomic<std::uint64_t> sum_ = 0u;
+  std::atomic<std::uint64_t> max_ = 0u;
+
+ public:
+  [[nodiscard]] static constexpr auto bucket_index(
+      const std::uint64_t value) noexcept -> std::size_t {
+    constexpr auto linear = std::uint64_t{1} << precision_bits;
+    constexpr auto half = linear >> 1u;
+    if (value < linear) {
+      return static_cast<std::size_t>(value);
+    }
+    const auto shift = std::min<std::size_t>(
+        static_cast<std::size_t>(std::bit_width(value)) - precision_bits,
+        max_value_bits - precision_bits);
+    const auto mantissa = std::min(value >> shift, linear - 1u);
+    return static_cast<std::size_t>(linear + (shift - 1u) * half +
+                                    (mantissa - half));
+  }
+
+  /// @brief The highest value of bucket `index`.
+  [[nodiscard]] static constexpr auto bucket_value(
+      const std::size_t index) noexcept -> std::uint64_t {
+    constexpr auto linear = std::size_t{1} << precision_bits;
+    constexpr auto half = linear >> 1u;
+    if (index < linear) {
+      return index;
+    }
+    const auto shift = (index - linear) / half + 1u;
+    const auto mantissa = std::uint64_t{(index - linear) % half + half};
+    return ((mantissa + 1u) << shift) - 1u;
+  }
+
+  /// @brief Calls `func(p, value)` for every percentile `p` of `percentiles`,
+  /// in ascending order in [0, 1], given the `total` values and the count of
+  /// every bucket `count_at(index)`.
+  template <typename TCountAt, typename TFunc>
+  static auto walk(const std::uint64_t total, const std::uint64_t max,
+                   const std::span<const double> percentiles,
+                   TCountAt&& count_at, TFunc&& func) -> void {
+    auto next = std::begin(percentiles);
+    auto seen = std::uint64_t{0};
+    for (auto index = std::size_t{0};
+         index < bucket_count and next != std::end(percentiles); ++index) {
+      seen += count_at(index);
+      while (next != std::end(percentiles)) {
+        const auto rank = std::max<std::uint64_t>(
+            1u, static_cast<std::uint64_t>(
+                    std::ceil(*next * static_cast<double>(total))));
+        if (seen < rank) {
+          break;
+        }
+        func(*next, std::min(bucket_value(index), max));
+        ++next;
+      }
+    }
+    for (; next != std::end(percentiles); ++next) {
+      func(*next, max);
+    }
+  }
+
+  /// @brief The summary of `total` values summing to `sum`, given the count
+  /// of every bucket `count_at(index)`.
+  template <typename TCountAt>
+  static auto summarize(const std::uint64_t total, const std::uint64_t sum,
+                        const std::uint64_t max, TCountAt&& count_at)
+      -> HistogramSummary {
+    auto summary = HistogramSummary{.count = total, .max = max};
+    if (total == 0u) {
+      return summary;
+    }
+    summary.mean = static_cast<double>(sum) / static_cast<double>(total);
+
+    static constexpr auto percentiles = std::array{0.5, 0.9, 0.99, 0.999};
+    const auto out = std::array{&summary.p50, &summary.p90, &summary.p99,
+                                &summary.p999};
+    auto n = std::size_t{0};
+    walk(total, max, percentiles, FWD(count_at),
+         [&](double, const std::uint64_t found) { *out[n++] = found; });
+    return summary;
+  }
+
+  auto record(const std::uint64_t value) noexcept -> void {
+    buckets_[bucket_index(value)].fetch_add(1u, std::memory_order_relaxed);
+    count_.fetch_add(1u, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+    auto max = max_.load(std::memory_order_relaxed);
+    while (value > max and not max_.compare_exchange_weak(
+                               max, value, std::memory_order_relaxed)) {
+    }
+  }
+
+  [[nodiscard]] auto bucket_count_at(const std::size_t index) const noexcept
+      -> std::uint64_t {
+    return buckets_[index].load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] auto count() const noexcept -> std::uint64_t {
+    return count_.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] auto sum() const noexcept -> std::uint64_t {
+    return sum_.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] auto max() const noexcept -> std::uint64_t {
+    return max_.load(std::memory_order_relaxed);
+  }
+
+  /// @brief The value of percentile `p`, in [0, 1], or zero when empty.
+  [[nodiscard]] auto value_at(const double p) const -> std::uint64_t {
+    auto value = std::uint64_t{0};
+    if (const auto total = count(); total > 0u) {
+      walk(
+          total, max(), std::span{&p, 1u},
+          [&](const std::size_t index) { return bucket_count_at(index); },
+          [&](double, const std::uint64_t found) { value = found; });
+    }
+    return value;
+  }
+
+  [[nodiscard]] auto summary() const -> HistogramSummary {
+    return summarize(count(), sum(), max(), [&](const std::size_t index) {
+      return bucket_count_at(index);
+    });
+  }
+
+  auto reset() noexcept -> void {
+    for (auto& bucket : buckets_) {
+      bucket.store(0u, std::memory_order_relaxed);
+    }
+    count_.store(0u, std::memory_order_relaxed);
+    sum_.store(0u, std::memory_order_relaxed);
+    max_.store(0u, std::memory_order_relaxed);
+  }
+};
+
+/// @brief A histogram of the last `window` values or so, in constant memory:
+/// `slots` histograms each take `window / slots` values in turn, and the
+/// oldest one is cleared to make room. The window thus holds between
+/// `window - window / slots` and `window` values once full.
+///
+/// Only one thread may record, since it rotates the slots; other threads may
+/// read while it does, and then see some of the values of the slot being
+/// cleared.
+class WindowedHistogram {
+  std::size_t n_slots_;
+  std::uint64_t slot_size_;
+  std::unique_ptr<HdrHistogram[]> slots_;
+  std::atomic<std::size_t> current_ = 0u;
+
+ public:
+  explicit(true) WindowedHistogram(const std::uint64_t window = 600u,
+                                   const std::size_t slots = 8u)
+      : n_slots_(std::max<std::size_t>(slots, 1u)),
+        slot_size_(std::max<std::uint64_t>(
+            (window + n_slots_ - 1u) / n_slots_, 1u)),
+        slots_(std::make_unique<HdrHistogram[]>(n_slots_)) {}
+
+  auto record(const std::uint64_t value) noexcept -> void {
+    auto current = current_.load(std::memory_order_relaxed);
+    if (slots_[current].count() >= slot_size_) {
+      current = (current + 1u) % n_slots_;
+      slots_[current].reset();
+      current_.store(current, std::memory_order_relaxed);
+    }
+    slots_[current].record(value);
+  }
+
+  /// @brief The number of values the window holds at most.
+  [[nodiscard]] auto window() const noexcept -> std::uint64_t {
+    return slot_size_ * n_slots_;
+  }
+
+  [[nodiscard]] auto count() const noexcept -> std::uint64_t {
+    auto count = std::uint64_t{0};
+    for (auto i = std::size_t{0}; i < n_slots_; ++i) {
+      count += slots_[i].count();
+    }
+    return count;
+  }
+
+  [[nodiscard]] auto max() const noexcept -> std::uint64_t {
+    auto max = std::uint64_t{0};
+    for (auto i = std::size_t{0}; i < n_slots_; ++i) {
+      max = std::max(max, slots_[i].max());
+    }
+    return max;
+  }
+
+  /// @brief The value of percentile `p`, in [0, 1], in the window.
+  [[nodiscard]] auto value_at(const double p) const -> std::uint64_t {
+    auto value = std::uint64_t{0};
+    if (const auto total = count(); total > 0u) {
+      HdrHistogram::walk(
+          total, max(), std::span{&p, 1u},
+          [&](const std::size_t index) { return count_at(index); },
+          [&](double, const std::uint64_t found) { value = found; });
+    }
+    return value;
+  }
+
+  /// @brief The percentiles of the window, in a single pass.
+  [[nodiscard]] auto summary() const -> HistogramSummary {
+    auto sum = std::uint64_t{0};
+    for (auto i = std::size_t{0}; i < n_slots_; ++i) {
+      sum += slots_[i].sum();
+    }
+    return HdrHistogram::summarize(
+        count(), sum, max(),
+        [&](const std::size_t index) { return count_at(index); });
+  }
+
+  auto reset() noexcept -> void {
+    for (auto i = std::size_t{0}; i < n_slots_; ++i) {
+      slots_[i].reset();
+    }
+    current_.store(0u, std::memory_order_relaxed);
+  }
+
+ private:
+  [[nodiscard]] auto count_at(const std::size_t index) const noexcept
+      -> std::uint64_t {
+    auto count = std::uint64_t{0};
+    for (auto i = std::size_t{0}; i < n_slots_; ++i) {
+      count += slots_[i].bucket_count_at(index);
+    }
+    return count;
+  }
+};
+
+}  // namespace nova
@@ -0,0 +1,294 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <entt/entt.hpp>
+#include <format>
+#include <nova/scheduler/scheduler.hpp>
+#include <nova/util/hash.hpp>
+#include <nova/util/memory_usage.hpp>
+#include <nova/util/type.hpp>
+#include <nova/world.hpp>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "stage_counters.hpp"
+
+namespace nova {
+
+enum class MemoryCategory : std::uint8_t {
+  component,
+  resource,
+  system,
+};
+
+[[nodiscard]] constexpr auto category_name(const MemoryCategory category)
+    -> std::string_view {
+  switch (category) {
+    case MemoryCategory::component:
+      return "component";
+    case MemoryCategory::resource:
+      return "resource";
+    case MemoryCategory::system:
+      return "system";
+  }
+  return "unknown";
+}
+
+/// @brief The memory taken by a component pool, a resource or the state of
+/// a system.
+struct MemoryEntry {
+  std::string name{};
+  MemoryCategory category = MemoryCategory::resource;
+  // for pools, the number of components and the number allocated for.
+  std::size_t size{1u};
+  std::size_t capacity{1u};
+  MemoryUsage usage{};
+  // false for pools of unknown layout (see `MemoryStats`), whose usage only
+  // covers the entity index and not the components themselves.
+  bool complete = true;
+};
+
+namespace detail {
+
+// escapes `text` as the content of a JSON string.
+inline auto append_json_string(std::string& out, const std::string_view text)
+    -> void {
+  out += '"';
+  for (const auto c : text) {
+    switch (c) {
+      case '"':
+        out += "\\\"";
+        break;
+      case '\\':
+        out += "\\\\";
+        break;
+      case '\n':
+        out += "\\n";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20u) {
+          out += std::format("\\u{:04x}", static_cast<unsigned>(c));
+        } else {
+          out += c;
+        }
+    }
+  }
+  out += '"';
+}
+
+inline auto append_json_usage(std::string& out, const MemoryUsage& usage)
+    -> void {
+  out += std::format(
+      R"("used_bytes":{},"reserved_bytes":{},"wasted_bytes":{})",
+      usage.used_bytes, usage.reserved_bytes, usage.wasted_bytes());
+}
+
+}  // namespace detail
+
+/// @brief How much memory the component pools of the `Registry`, the
+/// `Resources` and the state of the systems take, by type name.
+///
+/// Collecting walks every pool, resource and system, so it only happens on
+/// demand: `request_update()` has a scheduler that `observe`s `MemoryStats`
+/// collect at the end of its next update, and `collect` does it right away.
+/// The entries are sorted by reserved bytes, largest first, which is where
+/// runaway pools show up.
+///
+/// Pools are type erased, so the size of their components is taken from
+/// the layouts the `Registry` records when they are reached through
+/// `Registry::storage<T>` (bundles spawned in batches, prefabs, system
+/// views), or from those `track`ed here. Pools of unknown layout only
+/// account for their entity index. Resources and system states count their
+/// `sizeof` plus what `heap_usage<T>` reports for them.
+class MemoryStats final : public SchedulerObserver {
+  hash::hash_map_t<id_type, ComponentLayout> layouts_{};
+  std::vector<MemoryEntry> entries_{};
+  std::uint64_t collections_ = 0u;
+  bool requested_ = false;
+
+  // the layout `track`ed for the component `id`, or the one the registry
+  // recorded.
+  [[nodiscard]] auto find_layout(const Registry& registry,
+                                 const id_type id) const
+      -> const ComponentLayout* {
+    const auto iter = layouts_.find(id);
+    return iter != std::end(layouts_) ? &iter->second : registry.layout(id);
+  }
+
+  auto collect_pools(const Registry& registry) -> void {
+    constexpr auto entity_size = sizeof(entt::entity);
+    for (const auto& [id, pool] : registry.storage()) {
+      auto entry = MemoryEntry{
+          .name = std::string{pool.type().name()},
+          .category = MemoryCategory::component,
+          .size = pool.size(),
+          .capacity = pool.capacity(),
+          // the packed array of entities, and the sparse array. Sparse pages
+          // are allocated lazily, so the latter is an upper bound.
+          .usage =
+              MemoryUsage{
+                  .used_bytes = 2u * pool.size() * entity_size,
+                  .reserved_bytes =
+                      (pool.capacity() + pool.extent()) * entity_size,
+              },
+          .complete = false,
+      };
+
+      if (const auto* const layout = find_layout(registry, pool.type().hash());
+          layout != nullptr) {
+        entry.complete = true;
+        if (layout->size > 0u and layout->page_size > 0u) {
+          const auto pages =
+              (pool.capacity() + layout->page_size - 1u) / layout->page_size;
+          entry.usage += MemoryUsage{
+              .used_bytes = pool.size() * layout->size,
+              .reserved_bytes = pages * layout->page_size * layout->size,
+          };
+        }
+      }
+      entries_.push_back(MOV(entry));
+    }
+  }
+
+  auto collect_resources(const Resources& resources) -> void {
+    resources.for_each([this](const TypeId id, const void_ptr& value) {
+      entries_.push_back(MemoryEntry{
+          .name = std::string{id.name()},
+          .category = MemoryCategory::resource,
+          .usage = value.memory_usage(),
+      });
+    });
+  }
+
+ public:
+  /// @brief Accounts for the components themselves in their pools, for
+  /// pools the `Registry` has no layout of, e.g. those only `emplace`d
+  /// into.
+  template <typename... TComponents>
+  auto track() -> MemoryStats& {
+    (layouts_.insert_or_assign(entt::type_hash<TComponents>::value(),
+                               component_layout<TComponents>()),
+     ...);
+    return *this;
+  }
+
+  /// @brief Has the scheduler `collect` at the end of its next update.
+  auto request_update() noexcept -> void { requested_ = true; }
+
+  [[nodiscard]] auto update_requested() const noexcept -> bool {
+    return requested_;
+  }
+
+  /// @brief Walks the pools and resources of `world`.
+  auto collect(const World& world) -> void {
+    entries_.clear();
+    collect_pools(world.registry());
+    collect_resources(world.resources());
+    finish();
+  }
+
+  /// @brief Walks the pools and resources of `world`, and the systems of
+  /// `scheduler`, named `<stage>/<system>`.
+  auto collect(const World& world, const Scheduler& scheduler) -> void {
+    entries_.clear();
+    collect_pools(world.registry());
+    collect_resources(world.resources());
+    scheduler.for_each_stage([this](const std::string_view stage,
+                                    std::span<const System> systems) {
+      for (auto i = std::size_t{0}; i < std::size(systems); ++i) {
+        entries_.push_back(MemoryEntry{
+            .name = std::format("{}/{}", stage,
+                                detail::system_record_name(systems, i)),
+            .category = MemoryCategory::system,
+            .usage = systems[i].data.memory_usage(),
+        });
+      }
+    });
+    finish();
+  }
+
+  /// @brief Collects, if an update was requested.
+  auto on_frame_end(World& world, const Scheduler& scheduler)
+      -> void override {
+    if (requested_) {
+      collect(world, scheduler);
+    }
+  }
+
+  /// @brief The entries of the last collection, largest first.
+  [[nodiscard]] auto entries() const noexcept
+      -> const std::vector<MemoryEntry>& {
+    return entries_;
+  }
+
+  /// @brief The entry named `name`, or null.
+  [[nodiscard]] auto find(const std::string_view name,
+                          const MemoryCategory category) const
+      -> const MemoryEntry* {
+    const auto iter = std::ranges::find_if(entries_, [&](const auto& entry) {
+      return entry.category == category and entry.name == name;
+    });
+    return iter != std::end(entries_) ? &*iter : nullptr;
+  }
+
+  [[nodiscard]] auto total(const MemoryCategory category) const
+      -> MemoryUsage {
+    auto usage = MemoryUsage{};
+    for (const auto& entry : entries_) {
+      if (entry.category == category) {
+        usage += entry.usage;
+      }
+    }
+    return usage;
+  }
+
+  /// @brief The number of collections so far.
+  [[nodiscard]] auto collections() const noexcept -> std::uint64_t {
+    return collections_;
+  }
+
+  /// @brief The last collection as a JSON document:
+  /// `{"collections": n, "totals": {...}, "entries": [...]}`.
+  [[nodiscard]] auto to_json() const -> std::string {
+    auto out = std::format(R"({{"collections":{},"totals":{{)", collections_);
+    for (const auto category :
+         {MemoryCategory::component, MemoryCategory::resource,
+          MemoryCategory::system}) {
+      if (category != MemoryCategory::component) {
+        out += ',';
+      }
+      out += std::format(R"("{}":{{)", category_name(category));
+      detail::append_json_usage(out, total(category));
+      out += '}';
+    }
+    out += R"(},"entries":[)";
+    for (auto i = std::size_t{0}; i < std::size(entries_); ++i) {
+      const auto& entry = entries_[i];
+      out += i == 0u ? R"({"name":)" : R"(,{"name":)";
+      detail::append_json_string(out, entry.name);
+      out += std::format(
+          R"(,"category":"{}","size":{},"capacity":{},"complete":{},)",
+          category_name(entry.category), entry.size, entry.capacity,
+          entry.complete);
+      detail::append_json_usage(out, entry.usage);
+      out += '}';
+    }
+    out += "]}";
+    return out;
+  }
+
+ private:
+  auto finish() -> void {
+    std::ranges::stable_sort(entries_, [](const auto& lhs, const auto& rhs) {
+      return lhs.usage.reserved_bytes > rhs.usage.reserved_bytes;
+    });
+    ++collections_;
+    requested_ = false;
+  }
+};
+
+}  // namespace nova
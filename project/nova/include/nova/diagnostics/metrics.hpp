@@ -0,0 +1,325 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <iterator>
+#include <nova/util/memory_usage.hpp>
+#include <nova/world.hpp>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "frame_stats.hpp"
+#include "memory_stats.hpp"
+#include "perf_stats.hpp"
+
+namespace nova {
+
+/// @brief The durations of a frame, stage or system, in nanoseconds: percentiles
+/// over the sliding window, and totals since the start.
+struct TimingMetrics {
+  std::string name{};
+  HistogramSummary window{};
+  std::uint64_t count{};
+  std::uint64_t sum{};
+};
+
+/// @brief The durations of a system of stage `stage`.
+struct SystemTimingMetrics {
+  std::string stage{};
+  TimingMetrics timing{};
+};
+
+/// @brief The performance counters of a system since the start.
+struct SystemMetrics {
+  std::string stage{};
+  std::string name{};
+  PerfCounts total{};
+};
+
+/// @brief A copy of the stats of a `World`, to be read off the simulation
+/// thread. Collecting into the same snapshot again reuses its memory.
+struct MetricsSnapshot {
+  // the number of snapshots collected into this one so far.
+  std::uint64_t sequence{};
+  TimingMetrics frame{};
+  std::vector<TimingMetrics> stages{};
+  std::vector<SystemTimingMetrics> system_times{};
+  std::vector<SystemMetrics> systems{};
+  // the events in `systems`.
+  std::array<bool, perf_event_count> perf_events{};
+  std::size_t entities{};
+  std::vector<MemoryEntry> memory{};
+};
+
+namespace detail {
+
+inline auto collect_timing(TimingMetrics& out, const TimingSeries& series)
+    -> void {
+  out.name = series.name();
+  out.window = series.window().summary();
+  out.count = series.lifetime().count();
+  out.sum = series.lifetime().sum();
+}
+
+// escapes `text` as a Prometheus label value.
+inline auto append_label_value(std::string& out, const std::string_view text)
+    -> void {
+  for (const auto c : text) {
+    switch (c) {
+      case '"':
+        out += "\\\"";
+        break;
+      case '\\':
+        out += "\\\\";
+        break;
+      case '\n':
+        out += "\\n";
+        break;
+      default:
+        out += c;
+    }
+  }
+}
+
+inline auto append_header(std::string& out, const std::string_view name,
+                          const std::string_view type,
+                          const std::string_view help) -> void {
+  std::format_to(std::back_inserter(out), "# HELP {} {}\n# TYPE {} {}\n",
+                 name, help, name, type);
+}
+
+inline auto to_seconds(const std::uint64_t ns) -> double {
+  return static_cast<double>(ns) * 1e-9;
+}
+
+// the samples of a summary of `timing`, with the `labels` (`name="value"`
+// pairs, comma separated) of its series.
+inline auto append_timing(std::string& out, const std::string_view name,
+                          const std::string_view labels,
+                          const TimingMetrics& timing) -> void {
+  const auto separator = std::empty(labels) ? "" : ",";
+  const auto quantiles = std::array{
+      std::pair{"0.5", timing.window.p50},
+      std::pair{"0.9", timing.window.p90},
+      std::pair{"0.99", timing.window.p99},
+      std::pair{"0.999", timing.window.p999},
+  };
+  for (const auto& [quantile, value] : quantiles) {
+    std::format_to(std::back_inserter(out), "{}{{{}{}quantile=\"{}\"}} {}\n",
+                   name, labels, separator, quantile, to_seconds(value));
+  }
+  const auto braces = std::empty(labels) ? std::string{}
+                                         : std::format("{{{}}}", labels);
+  std::format_to(std::back_inserter(out), "{}_sum{} {}\n{}_count{} {}\n", name,
+                 braces, to_seconds(timing.sum), name, braces, timing.count);
+}
+
+inline auto append_window_max(std::string& out, const std::string_view name,
+                              const std::string_view labels,
+                              const TimingMetrics& timing) -> void {
+  if (std::empty(labels)) {
+    std::format_to(std::back_inserter(out), "{} {}\n", name,
+                   to_seconds(timing.window.max));
+  } else {
+    std::format_to(std::back_inserter(out), "{}{{{}}} {}\n", name, labels,
+                   to_seconds(timing.window.max));
+  }
+}
+
+inline auto stage_labels(std::string& out, const std::string_view stage)
+    -> void {
+  out = "stage=\"";
+  append_label_value(out, stage);
+  out += '"';
+}
+
+inline auto system_labels(std::string& out, const std::string_view stage,
+                          const std::string_view system) -> void {
+  stage_labels(out, stage);
+  out += ",system=\"";
+  append_label_value(out, system);
+  out += '"';
+}
+
+}  // namespace detail
+
+/// @brief Copies the `FrameStats` (with the durations of the systems, if it
+/// times them), `PerfStats` and `MemoryStats` of `world`, those that are
+/// resources, and its number of entities into `out`.
+inline auto collect_metrics(const World& world, MetricsSnapshot& out)
+    -> void {
+  const auto& resources = world.resources();
+  ++out.sequence;
+
+  // assigned in place, so that the strings keep their capacity.
+  auto n_stages = std::size_t{0};
+  auto n_system_times = std::size_t{0};
+  auto n_systems = std::size_t{0};
+  out.frame.window = {};
+  out.frame.count = out.frame.sum = 0u;
+  if (auto frames = resources.get<FrameStats>(); frames.has_value()) {
+    const auto& stats = **frames;
+    detail::collect_timing(out.frame, stats.frame());
+    for (auto i = std::size_t{0}; i < stats.stage_count(); ++i) {
+      if (const auto* const stage = stats.stage(i); stage != nullptr) {
+        if (n_stages == std::size(out.stages)) {
+          out.stages.emplace_back();
+        }
+        detail::collect_timing(out.stages[n_stages++], *stage);
+      }
+    }
+    for (const auto& stage : stats.systems()) {
+      for (const auto& system : stage.systems) {
+        if (n_system_times == std::size(out.system_times)) {
+          out.system_times.emplace_back();
+        }
+        auto& metrics = out.system_times[n_system_times++];
+        metrics.stage = stage.stage;
+        detail::collect_timing(metrics.timing, *system);
+      }
+    }
+  }
+  out.stages.resize(n_stages);
+  out.system_times.resize(n_system_times);
+
+  out.perf_events = {};
+  if (auto perf = resources.get<PerfStats>(); perf.has_value()) {
+    const auto& stats = **perf;
+    out.perf_events = stats.support().available;
+    for (const auto& stage : stats.stages()) {
+      for (const auto& system : stage.systems) {
+        if (n_systems == std::size(out.systems)) {
+          out.systems.emplace_back();
+        }
+        auto& metrics = out.systems[n_systems++];
+        metrics.stage = stage.stage.name;
+        metrics.name = system.name;
+        metrics.total = system.total;
+      }
+    }
+  }
+  out.systems.resize(n_systems);
+
+  out.entities = world.registry().alive();
+
+  if (auto memory = resources.get<MemoryStats>(); memory.has_value()) {
+    const auto& entries = (*memory)->entries();
+    out.memory.assign(std::begin(entries), std::end(entries));
+  } else {
+    out.memory.clear();
+  }
+}
+
+/// @brief Appends `snapshot` to `out` in the Prometheus text exposition
+/// format. Durations are in seconds.
+inline auto write_prometheus(std::string& out, const MetricsSnapshot& snapshot)
+    -> void {
+  using detail::append_header;
+  using detail::append_label_value;
+
+  append_header(out, "nova_frame_seconds", "summary",
+                "Time spent in Scheduler::update, over the last frames.");
+  detail::append_timing(out, "nova_frame_seconds", "", snapshot.frame);
+  append_header(out, "nova_frame_max_seconds", "gauge",
+                "Longest Scheduler::update of the last frames.");
+  detail::append_window_max(out, "nova_frame_max_seconds", "",
+                            snapshot.frame);
+
+  auto labels = std::string{};
+  if (not std::empty(snapshot.stages)) {
+    append_header(out, "nova_stage_seconds", "summary",
+                  "Time spent in each stage, over the last frames.");
+    for (const auto& stage : snapshot.stages) {
+      detail::stage_labels(labels, stage.name);
+      detail::append_timing(out, "nova_stage_seconds", labels, stage);
+    }
+    append_header(out, "nova_stage_max_seconds", "gauge",
+                  "Longest run of each stage in the last frames.");
+    for (const auto& stage : snapshot.stages) {
+      detail::stage_labels(labels, stage.name);
+      detail::append_window_max(out, "nova_stage_max_seconds", labels, stage);
+    }
+  }
+
+  if (not std::empty(snapshot.system_times)) {
+    append_header(out, "nova_system_seconds", "summary",
+                  "Time spent in each system, over the last frames.");
+    for (const auto& system : snapshot.system_times) {
+      detail::system_labels(labels, system.stage, system.timing.name);
+      detail::append_timing(out, "nova_system_seconds", labels,
+                            system.timing);
+    }
+  }
+
+  if (not std::empty(snapshot.systems)) {
+    for (auto i = std::size_t{0}; i < perf_event_count; ++i) {
+      if (not snapshot.perf_events[i]) {
+        continue;
+      }
+      const auto event = static_cast<PerfEvent>(i);
+      // the task clock is the CPU time of the system, in nanoseconds.
+      const auto is_time = event == PerfEvent::task_clock;
+      const auto name =
+          is_time ? std::string{"nova_system_cpu_seconds_total"}
+                  : std::format("nova_system_{}_total", perf_event_name(event));
+      append_header(out, name, "counter",
+                    is_time ? "CPU time spent in each system."
+                            : "Hardware events counted in each system.");
+      for (const auto& system : snapshot.systems) {
+        detail::system_labels(labels, system.stage, system.name);
+        const auto value = system.total[event];
+        if (is_time) {
+          std::format_to(std::back_inserter(out), "{}{{{}}} {}\n", name,
+                         labels, detail::to_seconds(value));
+        } else {
+          std::format_to(std::back_inserter(out), "{}{{{}}} {}\n", name,
+                         labels, value);
+        }
+      }
+    }
+  }
+
+  append_header(out, "nova_entities", "gauge", "Entities alive.");
+  std::format_to(std::back_inserter(out), "nova_entities {}\n",
+                 snapshot.entities);
+
+  if (not std::empty(snapshot.memory)) {
+    struct UsageMetric {
+      std::string_view name;
+      std::string_view help;
+      std::size_t MemoryUsage::*bytes;
+    };
+    for (const auto& metric :
+         {UsageMetric{"nova_memory_used_bytes", "Bytes used by live data.",
+                      &MemoryUsage::used_bytes},
+          UsageMetric{"nova_memory_reserved_bytes",
+                      "Bytes allocated for live data.",
+                      &MemoryUsage::reserved_bytes}}) {
+      append_header(out, metric.name, "gauge", metric.help);
+      for (const auto& entry : snapshot.memory) {
+        std::format_to(std::back_inserter(out),
+                       "{}{{category=\"{}\",name=\"", metric.name,
+                       category_name(entry.category));
+        append_label_value(out, entry.name);
+        std::format_to(std::back_inserter(out), "\"}} {}\n",
+                       entry.usage.*metric.bytes);
+      }
+    }
+    append_header(out, "nova_pool_components", "gauge",
+                  "Components in each pool.");
+    for (const auto& entry : snapshot.memory) {
+      if (entry.category != MemoryCategory::component) {
+        continue;
+      }
+      out += "nova_pool_components{component=\"";
+      append_label_value(out, entry.name);
+      std::format_to(std::back_inserter(out), "\"}} {}\n", entry.size);
+    }
+  }
+}
+
+}  // namespace nova
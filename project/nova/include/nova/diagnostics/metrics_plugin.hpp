@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <nova/app/app.hpp>
+#include <nova/app/core_stages.hpp>
+#include <nova/system/system.hpp>
+#include <nova/system/system_builder.hpp>
+#include <nova/world.hpp>
+
+#include "frame_stats.hpp"
+#include "memory_stats.hpp"
+#include "metrics_server.hpp"
+#include "perf_stats.hpp"
+
+namespace nova {
+
+struct PublishMetricsSystem {};
+
+/// @brief Publishes a `MetricsSnapshot` of `world` when the `MetricsServer`
+/// is due, and has the `MemoryStats` collected for the next one.
+inline auto publish_metrics(World& world) -> void {
+  auto& resources = world.resources();
+  auto server = resources.get<MetricsServer>();
+  if (not server.has_value() or not (*server)->publish_due()) {
+    return;
+  }
+  collect_metrics(world, (*server)->snapshot());
+  if ((*server)->publish()) {
+    if (auto memory = resources.get<MemoryStats>(); memory.has_value()) {
+      (*memory)->request_update();
+    }
+  }
+}
+
+inline auto stop_metrics_server(Resource<MetricsServer> server) -> void {
+  server->stop();
+}
+
+/// @brief Serves the frame, stage and system times, the number of entities
+/// and the memory of the pools in the Prometheus text format, at
+/// `http://127.0.0.1:9464/metrics`.
+///
+/// Adds a `FrameStats` timing stages and systems, a `MemoryStats` and a
+/// `MetricsServer`, unless they are resources already; e.g. to listen on
+/// another port or publish more often, insert the `MetricsServer` before
+/// adding the plugin:
+/// ```cpp
+/// app.insert_resource<MetricsServer>(9100u, std::chrono::milliseconds{250})
+///     .add_plugin(MetricsPlugin{});
+/// ```
+///
+/// The CPU time and hardware counters of every system are opt-in, as
+/// reading them costs system calls around every system: they are served
+/// too when a `PerfStats` is a resource.
+///
+/// The snapshot is taken at the end of the frame, and the memory stats are
+/// collected by the scheduler once the frame is over.
+struct MetricsPlugin {
+  auto operator()(App& app) -> void {
+    auto& resources = app.world.resources();
+    resources.try_add<FrameStats>(600u, StageTiming::on, SystemTiming::on);
+    resources.try_add<MemoryStats>();
+    resources.try_add<MetricsServer>();
+    app.scheduler.observe<FrameStats>();
+    app.scheduler.observe<PerfStats>();
+    app.scheduler.observe<MemoryStats>();
+    app.add_system_to_stage<stages::Last>(
+           system(publish_metrics).label<PublishMetricsSystem>())
+        .add_teardown_system(stop_metrics_server);
+  }
+};
+
+}  // namespace nova
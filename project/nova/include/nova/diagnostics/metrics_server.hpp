@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+#include "metrics.hpp"
+#include "nova_export.h"
+
+namespace nova {
+
+/// @brief Serves the latest `MetricsSnapshot` in the Prometheus text format
+/// at `http://<address>:<port>/metrics`, from a dedicated thread.
+///
+/// Snapshots are double buffered: the simulation fills `snapshot()` and
+/// `publish()`es it, which swaps it with the one the server thread reads
+/// scrapes from. Both threads only hold the lock for that swap, and
+/// `publish()` gives up rather than wait for it, so the simulation never
+/// blocks on a scrape; a scrape may see a snapshot a publish late.
+///
+/// Requests are served one at a time, and a client has a second to send its
+/// request and another to read the response, so a stalled one cannot hold
+/// up the others or `stop()`. Only POSIX sockets are supported: on other
+/// platforms, constructing the server throws.
+class MetricsServer {
+  std::chrono::nanoseconds period_;
+  std::mutex mutex_{};
+  // owned by the simulation thread.
+  MetricsSnapshot back_{};
+  // the last published snapshot, swapped under `mutex_`.
+  MetricsSnapshot ready_{};
+  bool fresh_ = false;
+  // owned by the server thread.
+  MetricsSnapshot front_{};
+  std::chrono::steady_clock::time_point last_publish_{};
+  std::atomic<std::uint64_t> scrapes_ = 0u;
+  int socket_ = -1;
+  std::uint16_t port_ = 0u;
+  std::jthread thread_{};
+
+  NOVA_EXPORT auto serve(const std::stop_token& stop) -> void;
+
+  // the latest published snapshot. Server thread only.
+  auto latest() -> const MetricsSnapshot& {
+    auto lock = std::scoped_lock{mutex_};
+    if (fresh_) {
+      std::swap(front_, ready_);
+      fresh_ = false;
+    }
+    return front_;
+  }
+
+ public:
+  /// @brief Listens on `address`, the loopback interface by default, and
+  /// `port`, any free one if zero. Publishes at most once every `period`.
+  /// Throws a `nova_exception` if the socket cannot be bound.
+  NOVA_EXPORT explicit(true) MetricsServer(
+      std::uint16_t port = 9464u,
+      std::chrono::nanoseconds period = std::chrono::seconds{1},
+      std::string_view address = "127.0.0.1");
+
+  MetricsServer(MetricsServer&&) = delete;
+  MetricsServer(MetricsServer const&) = delete;
+  MetricsServer& operator=(MetricsServer&&) = delete;
+  MetricsServer& operator=(MetricsServer const&) = delete;
+
+  NOVA_EXPORT ~MetricsServer();
+
+  /// @brief The port the server listens on.
+  [[nodiscard]] auto port() const noexcept -> std::uint16_t { return port_; }
+
+  /// @brief Whether `period` elapsed since the last `publish()`.
+  [[nodiscard]] auto publish_due() const noexcept -> bool {
+    return std::chrono::steady_clock::now() - last_publish_ >= period_;
+  }
+
+  /// @brief The snapshot to fill before the next `publish()`. Only the
+  /// simulation thread may touch it.
+  [[nodiscard]] auto snapshot() noexcept -> MetricsSnapshot& { return back_; }
+
+  /// @brief Hands `snapshot()` over to the server thread, unless it is taking
+  /// the previous one right now. Never blocks.
+  auto publish() -> bool {
+    auto lock = std::unique_lock{mutex_, std::try_to_lock};
+    if (not lock.owns_lock()) {
+      return false;
+    }
+    std::swap(back_, ready_);
+    fresh_ = true;
+    last_publish_ = std::chrono::steady_clock::now();
+    return true;
+  }
+
+  /// @brief The number of requests served so far.
+  [[nodiscard]] auto scrapes() const noexcept -> std::uint64_t {
+    return scrapes_.load(std::memory_order_relaxed);
+  }
+
+  /// @brief Closes the socket and joins the server thread.
+  NOVA_EXPORT auto stop() -> void;
+};
+
+}  // namespace nova
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "nova_export.h"
+
+namespace nova {
+
+/// @brief The events `read_perf_counters` counts, in user space only.
+enum class PerfEvent : std::uint8_t {
+  cycles,
+  instructions,
+  // last level cache misses.
+  llc_misses,
+  branch_misses,
+  // the time the thread ran on a CPU, in nanoseconds. A software event, so
+  // usually available where the hardware ones are not (e.g. in virtual
+  // machines without a virtual PMU).
+  task_clock,
+};
+
+inline constexpr auto perf_event_count = std::size_t{5};
+
+[[nodiscard]] constexpr auto perf_event_name(const PerfEvent event) noexcept
+    -> std::string_view {
+  switch (event) {
+    case PerfEvent::cycles:
+      return "cycles";
+    case PerfEvent::instructions:
+      return "instructions";
+    case PerfEvent::llc_misses:
+      return "llc_misses";
+    case PerfEvent::branch_misses:
+      return "branch_misses";
+    case PerfEvent::task_clock:
+      return "task_clock";
+  }
+  return "unknown";
+}
+
+/// @brief The value of every `PerfEvent`. Unavailable events stay zero.
+struct PerfCounts {
+  std::array<std::uint64_t, perf_event_count> values{};
+
+  [[nodiscard]] constexpr auto operator[](const PerfEvent event) const noexcept
+      -> std::uint64_t {
+    return values[static_cast<std::size_t>(event)];
+  }
+
+  [[nodiscard]] constexpr auto operator[](const PerfEvent event) noexcept
+      -> std::uint64_t& {
+    return values[static_cast<std::size_t>(event)];
+  }
+
+  constexpr auto operator+=(const PerfCounts& other) noexcept -> PerfCounts& {
+    for (auto i = std::size_t{0}; i < perf_event_count; ++i) {
+      values[i] += other.values[i];
+    }
+    return *this;
+  }
+
+  constexpr auto operator-=(const PerfCounts& other) noexcept -> PerfCounts& {
+    for (auto i = std::size_t{0}; i < perf_event_count; ++i) {
+      values[i] -= other.values[i];
+    }
+    return *this;
+  }
+
+  [[nodiscard]] friend constexpr auto operator+(PerfCounts lhs,
+                                                const PerfCounts& rhs)
+      -> PerfCounts {
+    return lhs += rhs;
+  }
+
+  [[nodiscard]] friend constexpr auto operator-(PerfCounts lhs,
+                                                const PerfCounts& rhs)
+      -> PerfCounts {
+    return lhs -= rhs;
+  }
+
+  /// @brief An `n`th of every count, rounded down.
+  [[nodiscard]] friend constexpr auto operator/(PerfCounts lhs,
+                                                const std::uint64_t n)
+      -> PerfCounts {
+    for (auto& value : lhs.values) {
+      value /= n;
+    }
+    return lhs;
+  }
+
+  constexpr auto operator==(const PerfCounts&) const -> bool = default;
+};
+
+/// @brief Which events the calling thread can count.
+struct PerfSupport {
+  std::array<bool, perf_event_count> available{};
+  // why the first unavailable event could not be opened, empty when all
+  // of them were.
+  std::string error{};
+
+  [[nodiscard]] constexpr auto supports(const PerfEvent event) const noexcept
+      -> bool {
+    return available[static_cast<std::size_t>(event)];
+  }
+
+  [[nodiscard]] constexpr auto any() const noexcept -> bool {
+    for (const auto available_event : available) {
+      if (available_event) {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+/// @brief The events the calling thread can count. Opens its counters if
+/// they are not yet.
+///
+/// Counters come from `perf_event_open` on Linux, and are never available
+/// elsewhere. Each event the kernel refuses (no PMU, a restrictive
+/// `perf_event_paranoid`, a seccomp filter...) is left out, and reads zero.
+[[nodiscard]] NOVA_EXPORT auto perf_support() -> PerfSupport;
+
+/// @brief The events the calling thread counted since its counters were
+/// opened, on its first call. Counting runs in user space only, and costs one
+/// system call per read.
+[[nodiscard]] NOVA_EXPORT auto read_perf_counters() noexcept -> PerfCounts;
+
+}  // namespace nova
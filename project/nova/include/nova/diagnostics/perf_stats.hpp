@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <nova/scheduler/observer.hpp>
+#include <nova/system/system_data.hpp>
+#include <span>
+#include <string_view>
+
+#include "perf_counters.hpp"
+#include "stage_counters.hpp"
+
+namespace nova {
+
+/// @brief The performance counters of a system, or of a whole stage.
+using PerfRecord = CounterRecord<PerfCounts>;
+using StagePerf = StageCounters<PerfCounts>;
+
+/// @brief The instructions retired per cycle, or zero when cycles were not
+/// counted. Low values hint at a memory bound system.
+[[nodiscard]] constexpr auto instructions_per_cycle(
+    const PerfCounts& counts) noexcept -> double {
+  const auto cycles = counts[PerfEvent::cycles];
+  return cycles == 0u ? 0.0
+                      : static_cast<double>(counts[PerfEvent::instructions]) /
+                            static_cast<double>(cycles);
+}
+
+/// @brief Counts the `PerfEvent`s of every system and stage during
+/// `Scheduler::update`, while the scheduler `observe`s `PerfStats` and the
+/// `PerfStats` is a resource.
+///
+/// Every system is measured on the thread that runs it, so systems running
+/// in parallel on a `TaskPool` do not count each other. Fused kernels are
+/// measured as the single pass they run as, and the counts are shared
+/// evenly between them. The events the kernel does not permit read zero:
+/// see `support()`.
+class PerfStats final : public SchedulerObserver {
+  detail::StageCountersTable<PerfCounts> table_{};
+  detail::StageSampler<PerfCounts, read_perf_counters> sampler_{};
+  PerfSupport support_ = perf_support();
+  std::uint64_t frames_ = 0u;
+
+ public:
+  /// @brief The events the calling thread could count when the stats were
+  /// created.
+  [[nodiscard]] auto support() const noexcept -> const PerfSupport& {
+    return support_;
+  }
+
+  /// @brief Starts a frame of `n_stages` stages.
+  auto begin_frame(const std::size_t n_stages) -> void {
+    table_.begin_frame(n_stages);
+  }
+
+  /// @brief Matches the records of stage `index` to its `systems`. Only
+  /// allocates when the stage changed.
+  auto prepare_stage(const std::size_t index, const std::string_view name,
+                     std::span<const System> systems) -> void {
+    table_.prepare_stage(index, name, systems);
+  }
+
+  /// @brief Adds to the counters of system `system` of stage `stage`.
+  auto add_system(const std::size_t stage, const std::size_t system,
+                  const PerfCounts& counts) noexcept -> void {
+    table_.add_system(stage, system, counts);
+  }
+
+  /// @brief Adds to the counters of the scheduler while running stage
+  /// `stage`, outside of its systems.
+  auto add_scheduler(const std::size_t stage,
+                     const PerfCounts& counts) noexcept -> void {
+    table_.add_scheduler(stage, counts);
+  }
+
+  auto end_frame() -> void {
+    table_.end_frame();
+    ++frames_;
+  }
+
+  [[nodiscard]] auto observes_systems() const noexcept -> bool override {
+    return true;
+  }
+
+  auto on_frame_begin(const std::size_t n_stages) -> void override {
+    begin_frame(n_stages);
+  }
+
+  auto on_stage_begin(const std::size_t index, const std::string_view name,
+                      std::span<const System> systems) -> void override {
+    prepare_stage(index, name, systems);
+    sampler_.begin_stage(std::size(systems));
+  }
+
+  auto on_systems_begin(const std::size_t /*stage*/, const std::size_t first,
+                        const std::size_t /*count*/) noexcept
+      -> void override {
+    sampler_.begin_systems(first);
+  }
+
+  auto on_systems_end(const std::size_t stage, const std::size_t first,
+                      const std::size_t count) noexcept -> void override {
+    table_.add_systems(stage, first, count,
+                       sampler_.end_systems(first));
+  }
+
+  auto on_stage_end(const std::size_t index) -> void override {
+    add_scheduler(index, sampler_.end_stage());
+  }
+
+  auto on_frame_end(World& /*world*/, const Scheduler& /*scheduler*/)
+      -> void override {
+    end_frame();
+  }
+
+  /// @brief The number of frames counted so far.
+  [[nodiscard]] auto frames() const noexcept -> std::uint64_t {
+    return frames_;
+  }
+
+  [[nodiscard]] auto stages() const noexcept -> std::span<const StagePerf> {
+    return table_.stages();
+  }
+
+  /// @brief Forgets the totals and the frame count.
+  auto reset() noexcept -> void {
+    table_.reset();
+    frames_ = 0u;
+  }
+};
+
+}  // namespace nova
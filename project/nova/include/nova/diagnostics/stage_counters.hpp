@@ -0,0 +1,202 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <format>
+#include <functional>
+#include <nova/system/system_data.hpp>
+#include <nova/util/type.hpp>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace nova {
+
+/// @brief What a system, or a whole stage, was measured to use.
+template <typename TCounts>
+struct CounterRecord {
+  std::string name{};
+  // during the last frame.
+  TCounts frame{};
+  // during every measured frame.
+  TCounts total{};
+};
+
+template <typename TCounts>
+struct StageCounters {
+  // the stage as a whole: its systems, and the scheduler running them.
+  CounterRecord<TCounts> stage{};
+  // the scheduler, outside of the systems.
+  CounterRecord<TCounts> scheduler{};
+  std::vector<CounterRecord<TCounts>> systems{};
+  // the ids of the systems, to detect that the stage changed.
+  std::vector<id_type> ids{};
+};
+
+namespace detail {
+
+/// @brief The name of system `index` of a stage in the stats: its type, and
+/// its index in the stage when other systems of the stage have the same type,
+/// e.g. functions of the same signature.
+inline auto system_record_name(std::span<const System> systems,
+                               const std::size_t index) -> std::string {
+  const auto name = systems[index].meta.id.name();
+  const auto same_type = [&](const System& system) {
+    return system.meta.id.name() == name;
+  };
+  return std::ranges::count_if(systems, same_type) > 1
+             ? std::format("{}#{}", name, index)
+             : std::string{name};
+}
+
+/// @brief The counters of every stage and system of a scheduler, fed while
+/// it updates. Systems may run on any thread: each system has its own slot,
+/// which only the thread running it writes to.
+template <typename TCounts>
+class StageCountersTable {
+  std::vector<StageCounters<TCounts>> stages_{};
+
+ public:
+  /// @brief Starts a frame of `n_stages` stages.
+  auto begin_frame(const std::size_t n_stages) -> void {
+    stages_.resize(n_stages);
+    for (auto& stage : stages_) {
+      stage.stage.frame = {};
+      stage.scheduler.frame = {};
+      for (auto& system : stage.systems) {
+        system.frame = {};
+      }
+    }
+  }
+
+  /// @brief Matches the records of stage `index` to its `systems`. Only
+  /// allocates when the stage changed.
+  auto prepare_stage(const std::size_t index, const std::string_view name,
+                     std::span<const System> systems) -> void {
+    auto& stage = stages_[index];
+    const auto same = std::ranges::equal(
+        stage.ids, systems, std::equal_to{}, {},
+        [](const System& system) { return system.meta.id.id(); });
+    if (same and stage.stage.name == name) {
+      return;
+    }
+    stage = StageCounters<TCounts>{
+        .stage = CounterRecord<TCounts>{.name = std::string{name}},
+    };
+    for (auto i = std::size_t{0}; i < std::size(systems); ++i) {
+      stage.systems.push_back(
+          CounterRecord<TCounts>{.name = system_record_name(systems, i)});
+      stage.ids.push_back(systems[i].meta.id.id());
+    }
+  }
+
+  auto add_system(const std::size_t stage, const std::size_t system,
+                  const TCounts& counts) noexcept -> void {
+    auto& record = stages_[stage].systems[system];
+    record.frame += counts;
+    record.total += counts;
+  }
+
+  /// @brief Shares `counts` evenly between systems `[first, first + count)`
+  /// of stage `stage`, e.g. kernels measured in a single fused pass. The
+  /// first system gets the remainder.
+  auto add_systems(const std::size_t stage, const std::size_t first,
+                   const std::size_t count, const TCounts& counts) noexcept
+      -> void {
+    if (count == 1u) {
+      add_system(stage, first, counts);
+      return;
+    }
+    const auto share = counts / count;
+    auto rest = counts;
+    for (auto i = first + 1u; i < first + count; ++i) {
+      add_system(stage, i, share);
+      rest -= share;
+    }
+    add_system(stage, first, rest);
+  }
+
+  auto add_scheduler(const std::size_t stage, const TCounts& counts) noexcept
+      -> void {
+    auto& record = stages_[stage].scheduler;
+    record.frame += counts;
+    record.total += counts;
+  }
+
+  /// @brief Sums the stages up.
+  auto end_frame() -> void {
+    for (auto& stage : stages_) {
+      stage.stage.frame = stage.scheduler.frame;
+      for (const auto& system : stage.systems) {
+        stage.stage.frame += system.frame;
+      }
+      stage.stage.total += stage.stage.frame;
+    }
+  }
+
+  [[nodiscard]] auto stages() const noexcept
+      -> std::span<const StageCounters<TCounts>> {
+    return stages_;
+  }
+
+  /// @brief Forgets the totals.
+  auto reset() noexcept -> void {
+    for (auto& stage : stages_) {
+      stage.stage.total = {};
+      stage.scheduler.total = {};
+      for (auto& system : stage.systems) {
+        system.total = {};
+      }
+    }
+  }
+};
+
+/// @brief Measures the systems of a stage, and the scheduler outside of
+/// them, with `read()`, a per-thread counter read around them.
+///
+/// Systems may run on any thread: each batch of systems has its own slot,
+/// which only the thread running it writes to. The calling thread's reading
+/// spans the whole stage, so the systems it ran itself are taken out of it.
+template <typename TCounts, auto read>
+class StageSampler {
+  std::vector<TCounts> starts_{};
+  std::thread::id caller_{};
+  TCounts stage_start_{};
+  TCounts on_caller_{};
+
+ public:
+  /// @brief Starts a stage of `n_systems` systems on the calling thread.
+  /// Only allocates when the stage grew, before reading the counter.
+  auto begin_stage(const std::size_t n_systems) -> void {
+    starts_.resize(n_systems);
+    caller_ = std::this_thread::get_id();
+    on_caller_ = {};
+    stage_start_ = read();
+  }
+
+  auto begin_systems(const std::size_t first) noexcept -> void {
+    starts_[first] = read();
+  }
+
+  /// @brief What the systems starting at `first` counted.
+  [[nodiscard]] auto end_systems(const std::size_t first) noexcept
+      -> TCounts {
+    const auto counts = read() - starts_[first];
+    if (std::this_thread::get_id() == caller_) {
+      on_caller_ += counts;
+    }
+    return counts;
+  }
+
+  /// @brief What the scheduler counted during the stage, outside of its
+  /// systems.
+  [[nodiscard]] auto end_stage() const noexcept -> TCounts {
+    return read() - stage_start_ - on_caller_;
+  }
+};
+
+}  // namespace detail
+
+}  // namespace nova
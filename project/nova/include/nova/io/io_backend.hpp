@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "nova_export.h"
+
+namespace nova {
+
+class TaskPool;
+
+namespace detail {
+
+enum class IoOpKind : std::uint8_t {
+  read,
+  write,
+};
+
+/// @brief A read or write of `size` bytes at `offset`. The buffer must stay
+/// alive until the completion of the operation is reaped.
+struct IoOp {
+  std::uint64_t id{};
+  IoOpKind kind = IoOpKind::read;
+  int fd = -1;
+  std::uint64_t offset{};
+  std::byte* data = nullptr;
+  std::uint32_t size{};
+};
+
+/// @brief The completion of the operation `id`: the number of bytes
+/// transferred, or a negated `errno`. Operations cut short are resumed, so
+/// fewer bytes than asked are only transferred at the end of the file.
+struct IoEvent {
+  std::uint64_t id{};
+  std::int32_t result{};
+};
+
+/// @brief Executes batches of file operations asynchronously.
+///
+/// Backends are used from a single thread: operations are submitted and
+/// their completions reaped by whoever owns the backend.
+class IoBackend {
+ public:
+  virtual ~IoBackend() = default;
+
+  [[nodiscard]] virtual auto name() const noexcept -> std::string_view = 0;
+
+  /// @brief Starts every operation of `ops`, as one batch when possible.
+  virtual auto submit(std::span<const IoOp> ops) -> void = 0;
+
+  /// @brief Appends the completions available to `out`. When `wait` is set
+  /// and operations are in flight, blocks until at least one completes.
+  virtual auto reap(std::vector<IoEvent>& out, bool wait) -> void = 0;
+
+  /// @brief The number of operations submitted and not reaped yet.
+  [[nodiscard]] virtual auto in_flight() const noexcept -> std::size_t = 0;
+};
+
+}  // namespace detail
+
+/// @brief An io_uring backend with rings of `entries` submissions, or null
+/// when io_uring is not available (not Linux, too old a kernel, or forbidden
+/// by a seccomp policy).
+[[nodiscard]] NOVA_EXPORT auto make_uring_backend(std::uint32_t entries = 256u)
+    -> std::unique_ptr<detail::IoBackend>;
+
+/// @brief A backend running blocking reads and writes on the task pool, or
+/// inline on submission without one.
+[[nodiscard]] NOVA_EXPORT auto make_threaded_backend(TaskPool* pool = nullptr)
+    -> std::unique_ptr<detail::IoBackend>;
+
+/// @brief The io_uring backend when available, the threaded one otherwise.
+[[nodiscard]] NOVA_EXPORT auto make_io_backend(TaskPool* pool = nullptr,
+                                               std::uint32_t entries = 256u)
+    -> std::unique_ptr<detail::IoBackend>;
+
+}  // namespace nova
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <utility>
+
+#include "nova_export.h"
+
+namespace nova {
+
+enum class IoMode : std::uint8_t {
+  read,
+  // creates the file, or truncates it.
+  write,
+  // creates the file if needed, without truncating it.
+  read_write,
+};
+
+/// @brief An open file to submit reads and writes on through an `IoQueue`.
+class IoFile {
+  int fd_ = -1;
+
+  NOVA_EXPORT auto close() noexcept -> void;
+
+ public:
+  IoFile() noexcept = default;
+  explicit(true) IoFile(const int fd) noexcept : fd_(fd) {}
+
+  IoFile(IoFile&& other) noexcept : fd_(std::exchange(other.fd_, -1)) {}
+  IoFile& operator=(IoFile&& other) noexcept {
+    if (this != &other) {
+      close();
+      fd_ = std::exchange(other.fd_, -1);
+    }
+    return *this;
+  }
+  IoFile(IoFile const&) = delete;
+  IoFile& operator=(IoFile const&) = delete;
+
+  ~IoFile() { close(); }
+
+  /// @brief Opens the file at `path`. Throws a `nova_exception` on failure.
+  [[nodiscard]] NOVA_EXPORT static auto open(const std::filesystem::path& path,
+                                             IoMode mode = IoMode::read)
+      -> IoFile;
+
+  /// @brief The size of the file, in bytes.
+  [[nodiscard]] NOVA_EXPORT auto size() const -> std::uint64_t;
+
+  [[nodiscard]] auto fd() const noexcept -> int { return fd_; }
+
+  [[nodiscard]] auto is_open() const noexcept -> bool { return fd_ >= 0; }
+};
+
+}  // namespace nova
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <nova/app/app.hpp>
+#include <nova/app/core_stages.hpp>
+#include <nova/system/system.hpp>
+#include <nova/system/system_builder.hpp>
+#include <nova/task/task_pool.hpp>
+
+#include "io_queue.hpp"
+
+namespace nova {
+
+struct PollIoSystem {};
+struct SubmitIoSystem {};
+
+inline auto poll_io(Resource<IoQueue> io) -> void { io->poll(); }
+
+inline auto submit_io(Resource<IoQueue> io) -> void { io->submit(); }
+
+inline auto drain_io(Resource<IoQueue> io) -> void { io->wait_all(); }
+
+/// @brief Adds an `IoQueue` resource, backed by io_uring when available and
+/// by blocking calls on the `TaskPool` otherwise (add the `TaskPoolPlugin`
+/// first).
+///
+/// The reads and writes queued during a frame are submitted as one batch in
+/// the last stage, and their completions are polled in the first stage of
+/// the next frames:
+/// ```cpp
+/// auto stream(Resource<IoQueue> io, Resource<Streamer> streamer) -> void {
+///   for (auto& chunk : streamer->chunks) {
+///     if (auto result = io->take(chunk.ticket)) { ... }
+///   }
+///   streamer->next.ticket = io->read(streamer->file, offset, size);
+/// }
+/// ```
+///
+/// The backend can be chosen by inserting an `IoQueue` before adding the
+/// plugin.
+struct IoPlugin {
+  auto operator()(App& app) -> void {
+    auto& resources = app.world.resources();
+    auto pool = resources.get<TaskPool>();
+    resources.try_add<IoQueue>(pool.has_value() ? &**pool : nullptr);
+    app.add_system_to_stage<stages::First>(
+           system(poll_io).label<PollIoSystem>())
+        .add_system_to_stage<stages::Last>(
+            system(submit_io).label<SubmitIoSystem>())
+        .add_teardown_system(drain_io);
+  }
+};
+
+}  // namespace nova
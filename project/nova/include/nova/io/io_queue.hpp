@@ -0,0 +1,215 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <limits>
+#include <memory>
+#include <nova/util/common.hpp>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "io_backend.hpp"
+#include "io_file.hpp"
+
+namespace nova {
+
+/// @brief Refers to an operation submitted on an `IoQueue`.
+struct IoTicket {
+  std::uint64_t id{};
+
+  constexpr auto operator<=>(const IoTicket&) const = default;
+};
+
+/// @brief The outcome of a read or write.
+struct IoResult {
+  IoTicket ticket{};
+  // the `errno` of the operation, 0 if it succeeded.
+  int error{};
+  std::size_t transferred{};
+  // the bytes read, or the buffer that was written so it can be reused.
+  std::vector<std::byte> data{};
+
+  [[nodiscard]] auto ok() const noexcept -> bool { return error == 0; }
+
+  [[nodiscard]] auto message() const -> std::string {
+    return std::generic_category().message(error);
+  }
+};
+
+/// @brief Reads and writes files asynchronously, in batches.
+///
+/// `read` and `write` only queue operations, which `submit()` hands to the
+/// backend as a single batch: with io_uring, the whole batch costs one
+/// system call and no thread blocks on the disk. `poll()` collects the
+/// completions without blocking, and their results are claimed with `take`.
+/// The `IoPlugin` submits at the end of every frame and polls at the start
+/// of the next one.
+///
+/// The queue owns the buffers of the operations in flight, and waits for
+/// them to complete when it is destroyed.
+class IoQueue {
+  struct InFlight {
+    detail::IoOpKind kind;
+    std::vector<std::byte> buffer;
+  };
+
+  std::unique_ptr<detail::IoBackend> backend_;
+  std::vector<detail::IoOp> batch_{};
+  std::unordered_map<std::uint64_t, InFlight> in_flight_{};
+  std::unordered_map<std::uint64_t, IoResult> completed_{};
+  std::vector<detail::IoEvent> events_{};
+  std::uint64_t next_id_ = 0u;
+
+  auto enqueue(const detail::IoOpKind kind, const IoFile& file,
+               const std::uint64_t offset, std::vector<std::byte> buffer)
+      -> IoTicket {
+    if (not file.is_open()) [[unlikely]] {
+      throw nova_exception{"IoQueue: the file is not open"};
+    }
+    if (std::size(buffer) > std::numeric_limits<std::uint32_t>::max())
+        [[unlikely]] {
+      throw nova_exception{std::format(
+          "IoQueue: cannot transfer {} bytes at once", std::size(buffer))};
+    }
+
+    const auto id = next_id_++;
+    auto& op =
+        in_flight_.emplace(id, InFlight{kind, MOV(buffer)}).first->second;
+    batch_.push_back(detail::IoOp{
+        .id = id,
+        .kind = kind,
+        .fd = file.fd(),
+        .offset = offset,
+        .data = std::data(op.buffer),
+        .size = static_cast<std::uint32_t>(std::size(op.buffer)),
+    });
+    return IoTicket{id};
+  }
+
+  auto complete() -> std::size_t {
+    for (const auto& event : events_) {
+      auto node = in_flight_.extract(event.id);
+      auto result = IoResult{
+          .ticket = IoTicket{event.id},
+          .error = event.result < 0 ? -event.result : 0,
+          .transferred =
+              static_cast<std::size_t>(std::max(event.result, std::int32_t{0})),
+          .data = MOV(node.mapped().buffer),
+      };
+      if (node.mapped().kind == detail::IoOpKind::read) {
+        result.data.resize(result.transferred);
+      }
+      completed_.insert_or_assign(event.id, MOV(result));
+    }
+    const auto n = std::size(events_);
+    events_.clear();
+    return n;
+  }
+
+  auto drain() -> void {
+    while (backend_->in_flight() > 0u) {
+      backend_->reap(events_, true);
+      complete();
+    }
+  }
+
+ public:
+  explicit(true) IoQueue(std::unique_ptr<detail::IoBackend> backend)
+      : backend_(MOV(backend)) {
+    if (backend_ == nullptr) [[unlikely]] {
+      throw nova_exception{"IoQueue: no backend"};
+    }
+  }
+
+  /// @brief Uses io_uring when available, and blocking calls on `pool`
+  /// otherwise.
+  explicit(true) IoQueue(TaskPool* const pool = nullptr,
+                         const std::uint32_t entries = 256u)
+      : IoQueue(make_io_backend(pool, entries)) {}
+
+  IoQueue(IoQueue&&) noexcept = default;
+  IoQueue(IoQueue const&) = delete;
+  IoQueue& operator=(IoQueue&&) = delete;
+  IoQueue& operator=(IoQueue const&) = delete;
+
+  ~IoQueue() {
+    if (backend_ != nullptr) {
+      // the backend may still be writing to the buffers.
+      batch_.clear();
+      drain();
+    }
+  }
+
+  [[nodiscard]] auto backend_name() const noexcept -> std::string_view {
+    return backend_->name();
+  }
+
+  /// @brief Queues a read of `size` bytes at `offset`. Every backend reads
+  /// until the buffer is full, so only reads past the end of the file, or
+  /// failing ones, transfer fewer bytes.
+  auto read(const IoFile& file, const std::uint64_t offset,
+            const std::size_t size) -> IoTicket {
+    return enqueue(detail::IoOpKind::read, file, offset,
+                   std::vector<std::byte>(size));
+  }
+
+  /// @brief Queues a write of `data` at `offset`. Every backend writes the
+  /// whole buffer unless the write fails.
+  auto write(const IoFile& file, const std::uint64_t offset,
+             std::vector<std::byte> data) -> IoTicket {
+    return enqueue(detail::IoOpKind::write, file, offset, MOV(data));
+  }
+
+  /// @brief Submits the queued operations as one batch, and returns how
+  /// many there were.
+  auto submit() -> std::size_t {
+    const auto n = std::size(batch_);
+    if (n > 0u) {
+      backend_->submit(batch_);
+      batch_.clear();
+    }
+    return n;
+  }
+
+  /// @brief Submits the queued operations and collects the completed ones
+  /// without blocking. Returns the number of operations that completed.
+  auto poll() -> std::size_t {
+    submit();
+    backend_->reap(events_, false);
+    return complete();
+  }
+
+  /// @brief Submits the queued operations and blocks until every operation
+  /// completed.
+  auto wait_all() -> void {
+    submit();
+    drain();
+  }
+
+  /// @brief Whether the result of `ticket` is ready to be taken.
+  [[nodiscard]] auto done(const IoTicket ticket) const -> bool {
+    return completed_.contains(ticket.id);
+  }
+
+  /// @brief Claims the result of `ticket`, if it completed.
+  [[nodiscard]] auto take(const IoTicket ticket) -> std::optional<IoResult> {
+    auto node = completed_.extract(ticket.id);
+    if (node.empty()) {
+      return std::nullopt;
+    }
+    return MOV(node.mapped());
+  }
+
+  /// @brief The number of operations queued or in flight.
+  [[nodiscard]] auto pending() const noexcept -> std::size_t {
+    return std::size(in_flight_);
+  }
+};
+
+}  // namespace nova
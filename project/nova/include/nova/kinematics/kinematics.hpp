@@ -0,0 +1,111 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <nova/resource/resource.hpp>
+#include <nova/system/view.hpp>
+#include <nova/time/time.hpp>
+#include <span>
+#include <type_traits>
+
+#include "simd.hpp"
+
+namespace nova {
+
+struct Position {
+  float x{};
+  float y{};
+};
+
+struct Velocity {
+  float dx{};
+  float dy{};
+};
+
+struct Acceleration {
+  float ddx{};
+  float ddy{};
+};
+
+namespace detail {
+
+template <typename T>
+[[nodiscard]] auto as_floats(const std::span<T> components) noexcept {
+  static_assert(sizeof(std::remove_const_t<T>) == 2u * sizeof(float) and
+                    std::is_standard_layout_v<std::remove_const_t<T>>,
+                "kinematics components must be two packed floats");
+  using float_t = std::conditional_t<std::is_const_v<T>, const float, float>;
+  return std::span<float_t>{reinterpret_cast<float_t*>(std::data(components)),
+                            2u * std::size(components)};
+}
+
+// chunks shorter than this are gathered into blocks instead.
+inline constexpr auto min_simd_chunk = std::size_t{16};
+// the entities gathered before the kernel runs on them.
+inline constexpr auto gather_block = std::size_t{256};
+
+// `y += dt * x` over every contiguous chunk of the view, both components
+// handled as flat float arrays.
+//
+// Pools in different orders (e.g. only some entities with a velocity have an
+// acceleration) break the view into chunks too short for the vector width;
+// those are gathered into a block on the stack, integrated there and
+// scattered back. The kernel is elementwise, so the results are the same.
+template <typename TX, typename TY, typename TView>
+auto integrate_chunks(const TView& view, const float dt) -> void {
+  auto xs = std::array<float, 2u * gather_block>{};
+  auto ys = std::array<float, 2u * gather_block>{};
+  auto targets = std::array<float*, gather_block>{};
+  auto n_gathered = std::size_t{0};
+
+  const auto flush = [&] {
+    simd::axpy(dt, std::data(xs), std::data(ys), 2u * n_gathered);
+    for (auto i = std::size_t{0}; i < n_gathered; ++i) {
+      targets[i][0] = ys[2u * i];
+      targets[i][1] = ys[2u * i + 1u];
+    }
+    n_gathered = 0u;
+  };
+
+  for (const auto& chunk : view.chunks()) {
+    const auto x = as_floats(chunk.template get<const TX>());
+    const auto y = as_floats(chunk.template get<TY>());
+    if (chunk.size() >= min_simd_chunk) {
+      simd::axpy(dt, std::data(x), std::data(y), std::size(y));
+      continue;
+    }
+    for (auto i = std::size_t{0}; i < chunk.size(); ++i) {
+      xs[2u * n_gathered] = x[2u * i];
+      xs[2u * n_gathered + 1u] = x[2u * i + 1u];
+      ys[2u * n_gathered] = y[2u * i];
+      ys[2u * n_gathered + 1u] = y[2u * i + 1u];
+      targets[n_gathered] = std::data(y) + 2u * i;
+      if (++n_gathered == gather_block) {
+        flush();
+      }
+    }
+  }
+  if (n_gathered != 0u) {
+    flush();
+  }
+}
+
+}  // namespace detail
+
+/// @brief Integrates the velocity of every entity with an acceleration.
+inline auto integrate_velocity(Resource<const Time> time,
+                               View<With<const Acceleration, Velocity>> view)
+    -> void {
+  detail::integrate_chunks<Acceleration, Velocity>(
+      view, time->delta_seconds<float>());
+}
+
+/// @brief Integrates the position of every entity with a velocity.
+inline auto integrate_position(Resource<const Time> time,
+                               View<With<const Velocity, Position>> view)
+    -> void {
+  detail::integrate_chunks<Velocity, Position>(view,
+                                               time->delta_seconds<float>());
+}
+
+}  // namespace nova
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <nova/app/app.hpp>
+#include <nova/system/system_builder.hpp>
+
+#include "kinematics.hpp"
+
+namespace nova {
+
+struct IntegrateVelocitySystem {};
+struct IntegratePositionSystem {};
+
+/// @brief Adds explicit Euler integration of `Position`, `Velocity` and
+/// `Acceleration` to the update stage, vectorized with the widest instruction
+/// set the CPU supports (see `nova::simd`). Requires the `TimePlugin`.
+struct KinematicsPlugin {
+  auto operator()(App& app) -> void {
+    app.add_system(
+           system(integrate_velocity).label<IntegrateVelocitySystem>())
+        .add_system(system(integrate_position)
+                        .label<IntegratePositionSystem>()
+                        .after<IntegrateVelocitySystem>());
+  }
+};
+
+}  // namespace nova
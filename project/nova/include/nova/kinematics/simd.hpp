@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+#include "nova_export.h"
+
+namespace nova::simd {
+
+/// @brief The instruction sets the kinematics kernels are compiled for.
+enum class Isa {
+  scalar,
+  sse2,
+  avx2,
+  avx512,
+};
+
+[[nodiscard]] constexpr auto isa_name(const Isa isa) noexcept
+    -> std::string_view {
+  switch (isa) {
+    case Isa::scalar:
+      return "scalar";
+    case Isa::sse2:
+      return "sse2";
+    case Isa::avx2:
+      return "avx2";
+    case Isa::avx512:
+      return "avx512";
+  }
+  return "unknown";
+}
+
+/// @brief Whether the running CPU (and this build) supports `isa`.
+[[nodiscard]] NOVA_EXPORT auto supports(Isa isa) noexcept -> bool;
+
+/// @brief The widest instruction set supported by the running CPU, detected
+/// once.
+[[nodiscard]] NOVA_EXPORT auto best_isa() noexcept -> Isa;
+
+/// @brief Computes `y[i] = y[i] + a * x[i]` for every `i` in `[0, n)` with the
+/// given instruction set, which must be supported.
+///
+/// Every path rounds the product before the sum (no fused multiply-add), so
+/// they all produce bit-identical results.
+NOVA_EXPORT auto axpy(Isa isa, float a, const float* x, float* y,
+                      std::size_t n) noexcept -> void;
+
+/// @brief `axpy` with the best supported instruction set.
+NOVA_EXPORT auto axpy(float a, const float* x, float* y, std::size_t n) noexcept
+    -> void;
+
+}  // namespace nova::simd
@@ -4,6 +4,7 @@
 #include <entt/entt.hpp>
 #include <nova/util/common.hpp>
 #include <nova/util/meta.hpp>
+#include <nova/util/type.hpp>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -3,6 +3,12 @@
 #include "app/app.hpp"
 #include "app/core_stages.hpp"
 #include "app/default_plugins.hpp"
+#include "asset/asset_plugin.hpp"
+#include "diagnostics/metrics_plugin.hpp"
+#include "io/io_plugin.hpp"
+#include "soa/soa_plugin.hpp"
 #include "system/system.hpp"
 #include "system/system_builder.hpp"
+#include "task/task_pool_plugin.hpp"
+#include "task/tasks.hpp"
 #include "world.hpp"
\ No newline at end of file
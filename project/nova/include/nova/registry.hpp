@@ -1,15 +1,101 @@
 #pragma once
 
+#include <cstddef>
 #include <entt/entt.hpp>
+#include <ranges>
+#include <type_traits>
+#include <span>
+#include <utility>
+#include <vector>
 
 #include "bundle/bundle.hpp"
 #include "debug/debug.hpp"
 #include "util/common.hpp"
+#include "util/hash.hpp"
 #include "util/reflection.hpp"
 
 namespace nova {
 
+/// @brief The size of a component, zero if it is empty, and the number of
+/// components per page of its pool.
+struct ComponentLayout {
+  std::size_t size{};
+  std::size_t page_size{};
+};
+
+template <typename T>
+[[nodiscard]] constexpr auto component_layout() noexcept -> ComponentLayout {
+  return ComponentLayout{
+      .size = std::is_empty_v<T> ? 0u : sizeof(T),
+      .page_size = entt::component_traits<T>::page_size,
+  };
+}
+
 struct Registry : entt::registry {
+ private:
+  // the layouts of the pools reached through `storage<T>`, which the type
+  // erased pools do not tell.
+  hash::hash_map_t<entt::id_type, ComponentLayout> layouts_{};
+
+  // Inserts the member of every bundle selected by `project` (which maps a
+  // bundle of `bundles` to the member) into its storage, recursing into
+  // nested bundles.
+  template <typename TComponent, typename TRange, typename TProject>
+  auto insert_bundle_column(std::span<const entt::entity> entities,
+                            TRange& bundles, TProject project) -> void {
+    if constexpr (concepts::bundle<TComponent>) {
+      this->insert_bundle_columns<TComponent>(entities, bundles, MOV(project));
+    } else {
+      auto& storage = this->storage<TComponent>();
+      storage.reserve(std::size(storage) + std::size(entities));
+      if constexpr (std::is_empty_v<TComponent>) {
+        this->insert<TComponent>(std::begin(entities), std::end(entities));
+      } else {
+        auto column = bundles | std::views::transform(MOV(project));
+        this->insert<TComponent>(std::begin(entities), std::end(entities),
+                                 std::ranges::begin(column));
+      }
+    }
+  }
+
+  template <typename TBundle, typename TRange, typename TProject>
+  auto insert_bundle_columns(std::span<const entt::entity> entities,
+                             TRange& bundles, TProject project) -> void {
+    [&]<typename... TMembers, std::size_t... Is>(type_list<TMembers...>,
+                                                 std::index_sequence<Is...>) {
+      (this->insert_bundle_column<TMembers>(
+           entities, bundles,
+           [project](auto&& bundle) -> decltype(auto) {
+             return std::get<Is>(
+                 reflect::get_member_references(project(FWD(bundle))));
+           }),
+       ...);
+    }
+    (reflect::member_type_list<TBundle>{},
+     std::make_index_sequence<reflect::member_count<TBundle>>{});
+  }
+
+ public:
+  using entt::registry::storage;
+
+  /// @brief The pool of `T`, created if missing, and its layout recorded
+  /// for the `MemoryStats`. Bundles spawned in batches, prefabs and the
+  /// views of systems reach their pools through it; pools only ever created
+  /// by `emplace` and the like are left out.
+  template <typename T>
+  [[nodiscard]] decltype(auto) storage(
+      const entt::id_type id = entt::type_hash<T>::value()) {
+    layouts_.try_emplace(entt::type_hash<T>::value(), component_layout<T>());
+    return entt::registry::storage<T>(id);
+  }
+
+  /// @brief The layout recorded for the pool of the component `id`, or null.
+  [[nodiscard]] auto layout(const entt::id_type id) const
+      -> const ComponentLayout* {
+    const auto iter = layouts_.find(id);
+    return iter != std::end(layouts_) ? &iter->second : nullptr;
+  }
+
   template <typename TBundle>
   requires(concepts::bundle<std::remove_cvref_t<TBundle>>) auto emplace_bundle(
       const entt::entity e, TBundle&& bundle) -> void {
@@ -23,6 +109,47 @@ struct Registry : entt::registry {
     });
   }
 
+  /// @brief Creates one entity per bundle in `bundles`.
+  /// Every storage touched by the bundle (including nested bundles) is
+  /// reserved once and filled with a single range insert, which is much
+  /// cheaper than calling `emplace_bundle` for each entity.
+  ///
+  /// @tparam TBundle The bundle type.
+  /// @param bundles A sized range of bundles.
+  /// @return The created entities, in the same order as `bundles`.
+  template <concepts::bundle TBundle, std::ranges::sized_range TRange>
+  requires(std::is_same_v<TBundle,
+                          std::remove_cvref_t<std::ranges::range_value_t<
+                              TRange>>>) auto spawn_batch(TRange&& bundles)
+      -> std::vector<entt::entity> {
+    if constexpr (not std::is_lvalue_reference_v<
+                      std::ranges::range_reference_t<TRange>>) {
+      // the columns reference the bundles' members, so bundles that are
+      // generated on the fly have to be materialized first.
+      auto materialized =
+          reserved<std::vector<TBundle>>(std::ranges::size(bundles));
+      for (auto&& bundle : bundles) {
+        materialized.push_back(FWD(bundle));
+      }
+      return this->spawn_batch<TBundle>(materialized);
+    } else {
+      auto entities = std::vector<entt::entity>(std::ranges::size(bundles));
+      this->create(std::begin(entities), std::end(entities));
+      this->insert_bundle_columns<TBundle>(
+          entities, bundles,
+          [](auto& bundle) -> decltype(auto) { return bundle; });
+      return entities;
+    }
+  }
+
+  template <std::ranges::sized_range TRange>
+  requires(concepts::bundle<std::remove_cvref_t<
+               std::ranges::range_value_t<TRange>>>) auto spawn_batch(
+      TRange&& bundles) -> std::vector<entt::entity> {
+    using bundle_t = std::remove_cvref_t<std::ranges::range_value_t<TRange>>;
+    return this->spawn_batch<bundle_t>(FWD(bundles));
+  }
+
   /// @brief Erases the bundle for a given entity.
   /// If the bundle does not exist for the entity, this is UB.
   /// Consider using `remove_bundle<TBundle>` if you are unsure if the
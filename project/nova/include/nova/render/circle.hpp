@@ -0,0 +1,58 @@
+#pragma once
+
+#include <entt/entt.hpp>
+#include <nova/kinematics/kinematics.hpp>
+#include <nova/system/view.hpp>
+#include <span>
+#include <vector>
+
+#include "circle_batch.hpp"
+#include "vertex.hpp"
+
+namespace nova {
+
+/// @brief A filled circle centered on the entity's `Position`.
+/// Plain data: the drawable is only produced at draw time, by the render
+/// extraction (see `RenderPlugin`).
+struct Circle {
+  float radius{};
+  Color color{};
+};
+
+/// @brief Gathers every circle into `instances`, in view order.
+template <typename TView>
+auto gather_circles(const TView& view, std::vector<CircleInstance>& instances)
+    -> void {
+  instances.clear();
+  for (const auto& chunk : view.chunks()) {
+    const auto positions = chunk.template get<const Position>();
+    const auto circles = chunk.template get<const Circle>();
+    for (auto i = std::size_t{0}; i < chunk.size(); ++i) {
+      instances.push_back(CircleInstance{
+          .x = positions[i].x,
+          .y = positions[i].y,
+          .radius = circles[i].radius,
+          .color = circles[i].color,
+      });
+    }
+  }
+}
+
+/// @brief Gathers the circles of `entities`, which must all be in `view`.
+template <typename TView>
+auto gather_circles(const TView& view, std::span<const entt::entity> entities,
+                    std::vector<CircleInstance>& instances) -> void {
+  instances.resize(std::size(entities));
+  for (auto i = std::size_t{0}; i < std::size(entities); ++i) {
+    const auto& [pos, circle] =
+        view.template get<const Position, const Circle>(entities[i]);
+    instances[i] = CircleInstance{
+        .x = pos.x,
+        .y = pos.y,
+        .radius = circle.radius,
+        .color = circle.color,
+    };
+  }
+}
+
+}  // namespace nova
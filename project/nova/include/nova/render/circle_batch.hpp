@@ -0,0 +1,121 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <numbers>
+#include <nova/task/task_pool.hpp>
+#include <nova/util/common.hpp>
+#include <span>
+#include <vector>
+
+#include "vertex.hpp"
+
+namespace nova {
+
+/// @brief What the renderer needs to know about a circle.
+struct CircleInstance {
+  float x{};
+  float y{};
+  float radius{};
+  Color color{};
+};
+
+/// @brief Tessellates circles into a single triangle list, to be submitted
+/// to the backend in one draw call.
+///
+/// The buffer is sized once for every instance and each instance writes its
+/// own fixed range of vertices, so large batches are built in parallel
+/// without any synchronization. No windowing or graphics API is involved.
+class CircleBatch {
+  // Instances tessellated by each parallel task.
+  static constexpr std::size_t BLOCK_SIZE = 1'024u;
+
+  std::size_t segments_;
+  // `(cos, sin)` of the angle of each point of the unit circle, closing on
+  // the first point.
+  std::vector<float> unit_x_{};
+  std::vector<float> unit_y_{};
+  std::vector<Vertex> vertices_{};
+
+  auto tessellate(const CircleInstance& circle,
+                  Vertex* const out) const noexcept -> void {
+    const auto center =
+        Vertex{.x = circle.x, .y = circle.y, .color = circle.color};
+    auto* vertex = out;
+    for (auto i = std::size_t{0}; i < segments_; ++i) {
+      *vertex++ = center;
+      *vertex++ = Vertex{
+          .x = circle.x + circle.radius * unit_x_[i],
+          .y = circle.y + circle.radius * unit_y_[i],
+          .color = circle.color,
+      };
+      *vertex++ = Vertex{
+          .x = circle.x + circle.radius * unit_x_[i + 1u],
+          .y = circle.y + circle.radius * unit_y_[i + 1u],
+          .color = circle.color,
+      };
+    }
+  }
+
+ public:
+  explicit(true) CircleBatch(const std::size_t segments = 16u)
+      : segments_(segments) {
+    if (segments < 3u) [[unlikely]] {
+      throw nova_exception{std::format(
+          "CircleBatch: a circle needs at least 3 segments, got {}",
+          segments)};
+    }
+
+    unit_x_.reserve(segments + 1u);
+    unit_y_.reserve(segments + 1u);
+    for (auto i = std::size_t{0}; i <= segments; ++i) {
+      const auto angle = 2.0 * std::numbers::pi *
+                         static_cast<double>(i % segments) /
+                         static_cast<double>(segments);
+      unit_x_.push_back(static_cast<float>(std::cos(angle)));
+      unit_y_.push_back(static_cast<float>(std::sin(angle)));
+    }
+  }
+
+  [[nodiscard]] auto segments() const noexcept -> std::size_t {
+    return segments_;
+  }
+
+  [[nodiscard]] auto vertices_per_circle() const noexcept -> std::size_t {
+    return 3u * segments_;
+  }
+
+  /// @brief The triangle list of the last `build`.
+  [[nodiscard]] auto vertices() const noexcept -> std::span<const Vertex> {
+    return vertices_;
+  }
+
+  /// @brief Replaces the batch with the triangles of `circles`, in order.
+  /// With a task pool, blocks of circles are tessellated in parallel.
+  auto build(std::span<const CircleInstance> circles,
+             TaskPool* const pool = nullptr) -> void {
+    const auto n = std::size(circles);
+    vertices_.resize(n * vertices_per_circle());
+
+    const auto build_block = [&](const std::size_t block) {
+      const auto first = block * BLOCK_SIZE;
+      const auto last = std::min(n, first + BLOCK_SIZE);
+      for (auto i = first; i < last; ++i) {
+        tessellate(circles[i],
+                   std::data(vertices_) + i * vertices_per_circle());
+      }
+    };
+
+    const auto n_blocks = (n + BLOCK_SIZE - 1u) / BLOCK_SIZE;
+    if (pool != nullptr and n_blocks > 1u) {
+      pool->parallel_for(n_blocks, build_block);
+    } else {
+      for (auto block = std::size_t{0}; block < n_blocks; ++block) {
+        build_block(block);
+      }
+    }
+  }
+};
+
+}  // namespace nova
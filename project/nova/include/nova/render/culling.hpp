@@ -0,0 +1,74 @@
+#pragma once
+
+#include <entt/entt.hpp>
+#include <nova/kinematics/kinematics.hpp>
+#include <nova/resource/resource.hpp>
+#include <nova/system/view.hpp>
+#include <nova/world.hpp>
+#include <vector>
+
+#include "circle.hpp"
+
+namespace nova {
+
+/// @brief The visible region of the world, in world coordinates.
+struct Viewport {
+  float min_x{};
+  float min_y{};
+  float max_x{};
+  float max_y{};
+};
+
+/// @brief The entities that passed culling this frame, in view order.
+struct VisibleList {
+  std::vector<entt::entity> entities{};
+};
+
+/// @brief Writes the circles of `view` that overlap `viewport` into
+/// `visible`.
+///
+/// Each chunk of the view is tested without branches: the visibility of every
+/// circle is computed from its position and radius, and the entity is always
+/// written to the next slot of the list, which only advances when the circle
+/// is visible.
+template <typename TView>
+auto cull(const TView& view, const Viewport& viewport,
+          std::vector<entt::entity>& visible) -> void {
+  visible.resize(view.size_hint());
+  auto* const out = std::data(visible);
+  auto count = std::size_t{0};
+
+  for (const auto& chunk : view.chunks()) {
+    const auto positions = chunk.template get<const Position>();
+    const auto circles = chunk.template get<const Circle>();
+    for (auto i = std::size_t{0}; i < chunk.size(); ++i) {
+      const auto x = positions[i].x;
+      const auto y = positions[i].y;
+      const auto r = circles[i].radius;
+      const auto inside =
+          static_cast<std::size_t>(x + r >= viewport.min_x) &
+          static_cast<std::size_t>(x - r <= viewport.max_x) &
+          static_cast<std::size_t>(y + r >= viewport.min_y) &
+          static_cast<std::size_t>(y - r <= viewport.max_y);
+      out[count] = chunk.entities[i];
+      count += inside;
+    }
+  }
+
+  visible.resize(count);
+}
+
+/// @brief Fills the `VisibleList` with the circles overlapping the
+/// `Viewport`, or with every circle when there is no viewport.
+inline auto cull_circles(Optional<Resource<const Viewport>> viewport,
+                         Resource<VisibleList> visible,
+                         View<With<const Position, const Circle>> view)
+    -> void {
+  if (viewport.has_value()) {
+    cull(view, **viewport, visible->entities);
+  } else {
+    visible->entities.assign(std::begin(view), std::end(view));
+  }
+}
+
+}  // namespace nova
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "vertex.hpp"
+
+namespace nova {
+
+/// @brief Everything the render thread needs to draw one frame, copied out of
+/// the world by the extraction systems.
+struct RenderFrame {
+  /// @brief The position of the frame in the submission order.
+  std::uint64_t index{};
+  /// @brief A triangle list.
+  std::vector<Vertex> vertices{};
+};
+
+/// @brief The graphics API behind a `RenderThread`.
+///
+/// Every member function is called on the render thread, so thread-affine
+/// calls (e.g. making an OpenGL context current) belong here.
+class RenderBackend {
+ public:
+  virtual ~RenderBackend() = default;
+
+  /// @brief Called once, before the first frame.
+  virtual auto activate() -> void {}
+
+  /// @brief Draws and presents `frame`. May block (e.g. on vsync).
+  virtual auto draw(const RenderFrame& frame) -> void = 0;
+
+  /// @brief Called once, after the last frame.
+  virtual auto deactivate() -> void {}
+};
+
+/// @brief A backend without a window, which records what it is asked to draw.
+/// Presenting can be made to take some time, to stand in for vsync.
+class HeadlessBackend final : public RenderBackend {
+ public:
+  struct Draw {
+    std::uint64_t index{};
+    std::size_t vertex_count{};
+    std::thread::id thread{};
+  };
+
+ private:
+  std::chrono::microseconds present_time_;
+  mutable std::mutex mutex_{};
+  std::thread::id render_thread_{};
+  std::vector<Draw> draws_{};
+
+ public:
+  explicit(true) HeadlessBackend(
+      const std::chrono::microseconds present_time = {})
+      : present_time_(present_time) {}
+
+  auto activate() -> void override {
+    auto lock = std::scoped_lock{mutex_};
+    render_thread_ = std::this_thread::get_id();
+  }
+
+  auto draw(const RenderFrame& frame) -> void override {
+    if (present_time_.count() > 0) {
+      std::this_thread::sleep_for(present_time_);
+    }
+    auto lock = std::scoped_lock{mutex_};
+    draws_.push_back(Draw{
+        .index = frame.index,
+        .vertex_count = std::size(frame.vertices),
+        .thread = std::this_thread::get_id(),
+    });
+  }
+
+  /// @brief The thread `activate()` was called on.
+  [[nodiscard]] auto render_thread() const -> std::thread::id {
+    auto lock = std::scoped_lock{mutex_};
+    return render_thread_;
+  }
+
+  /// @brief The frames drawn so far, in order.
+  [[nodiscard]] auto draws() const -> std::vector<Draw> {
+    auto lock = std::scoped_lock{mutex_};
+    return draws_;
+  }
+};
+
+}  // namespace nova
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <nova/app/app.hpp>
+#include <nova/app/core_stages.hpp>
+#include <nova/resource/resource.hpp>
+#include <nova/system/system.hpp>
+#include <nova/system/system_builder.hpp>
+#include <nova/task/task_pool.hpp>
+#include <nova/world.hpp>
+#include <vector>
+
+#include "circle.hpp"
+#include "circle_batch.hpp"
+#include "culling.hpp"
+#include "render_thread.hpp"
+
+namespace nova {
+
+struct CullCirclesSystem {};
+struct ExtractCirclesSystem {};
+struct SubmitFrameSystem {};
+
+/// @brief Render extraction: rebuilds the `CircleBatch` from the circles that
+/// passed culling.
+inline auto extract_circles(Resource<CircleBatch> batch,
+                            Resource<const VisibleList> visible,
+                            Optional<Resource<TaskPool>> pool,
+                            Local<std::vector<CircleInstance>> instances,
+                            View<With<const Position, const Circle>> view)
+    -> void {
+  gather_circles(view, visible->entities, *instances);
+  batch->build(*instances,
+               pool.map([](auto p) { return &*p; }).value_or(nullptr));
+}
+
+/// @brief Culls every `Circle` against the `Viewport` (when there is one)
+/// and extracts the visible ones into a `CircleBatch`, in the post update
+/// stage. Drawing systems should run after `ExtractCirclesSystem` and submit
+/// the batch.
+struct RenderPlugin {
+  auto operator()(App& app) -> void {
+    app.world.resources().try_add<CircleBatch>();
+    app.insert_resource<VisibleList>()
+        .add_system_to_stage<stages::PostUpdate>(
+            system(cull_circles).label<CullCirclesSystem>())
+        .add_system_to_stage<stages::PostUpdate>(
+            system(extract_circles)
+                .label<ExtractCirclesSystem>()
+                .after<CullCirclesSystem>());
+  }
+};
+
+/// @brief Copies the circle batch into the frame being extracted and hands
+/// it over to the render thread.
+inline auto submit_frame(Resource<RenderThread> render_thread,
+                         Resource<const CircleBatch> batch) -> void {
+  const auto vertices = batch->vertices();
+  render_thread->frame().vertices.assign(std::begin(vertices),
+                                         std::end(vertices));
+  render_thread->submit();
+}
+
+inline auto stop_render_thread(Resource<RenderThread> render_thread) -> void {
+  render_thread->stop();
+}
+
+/// @brief The `RenderPlugin`, with frames drawn by a `RenderThread` while
+/// the next frame is simulated. The `RenderThread` resource must be inserted
+/// first, with the backend to draw with:
+/// ```cpp
+/// app.insert_resource<RenderThread>(std::make_unique<HeadlessBackend>())
+///     .add_plugin(PipelinedRenderPlugin{});
+/// ```
+struct PipelinedRenderPlugin {
+  auto operator()(App& app) -> void {
+    app.add_plugin(RenderPlugin{})
+        .add_system_to_stage<stages::PostUpdate>(
+            system(submit_frame)
+                .label<SubmitFrameSystem>()
+                .after<ExtractCirclesSystem>())
+        .add_teardown_system(stop_render_thread);
+  }
+};
+
+}  // namespace nova
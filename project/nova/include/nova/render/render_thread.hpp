@@ -0,0 +1,164 @@
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <nova/util/common.hpp>
+#include <thread>
+#include <utility>
+
+#include "render_backend.hpp"
+
+namespace nova {
+
+/// @brief Draws frames on a dedicated thread, one frame behind the
+/// simulation.
+///
+/// Frames are double buffered: the simulation fills `frame()` while the
+/// render thread draws the previously submitted frame, and `submit()` swaps
+/// the two buffers once the render thread is done. The simulation therefore
+/// runs at most one frame ahead, and a backend blocking on vsync no longer
+/// stalls it. The buffers are swapped rather than copied, so their capacity
+/// is reused from one frame to the next.
+///
+/// The backend is only ever used on the render thread. Exceptions it throws
+/// are rethrown on the simulation thread by the next `submit()` or
+/// `wait_idle()`.
+class RenderThread {
+  std::unique_ptr<RenderBackend> backend_;
+  std::mutex mutex_{};
+  std::condition_variable cv_{};
+  // owned by the simulation thread.
+  RenderFrame back_{};
+  // owned by the render thread while `pending_`.
+  RenderFrame front_{};
+  std::uint64_t submitted_ = 0u;
+  bool pending_ = false;
+  bool stopping_ = false;
+  std::exception_ptr error_{};
+  std::jthread thread_{};
+
+  auto fail() -> void {
+    auto lock = std::scoped_lock{mutex_};
+    if (not error_) {
+      error_ = std::current_exception();
+    }
+  }
+
+  auto rethrow_error(std::unique_lock<std::mutex>& lock) -> void {
+    if (auto error = std::exchange(error_, nullptr)) {
+      lock.unlock();
+      std::rethrow_exception(MOV(error));
+    }
+  }
+
+  auto render_loop() -> void {
+    auto active = true;
+    try {
+      backend_->activate();
+    } catch (...) {
+      fail();
+      active = false;
+    }
+
+    for (;;) {
+      {
+        auto lock = std::unique_lock{mutex_};
+        cv_.wait(lock, [&] { return stopping_ or pending_; });
+        if (not pending_) {
+          break;
+        }
+      }
+
+      if (active) {
+        try {
+          backend_->draw(front_);
+        } catch (...) {
+          fail();
+        }
+      }
+
+      {
+        auto lock = std::scoped_lock{mutex_};
+        pending_ = false;
+      }
+      cv_.notify_all();
+    }
+
+    if (active) {
+      try {
+        backend_->deactivate();
+      } catch (...) {
+        fail();
+      }
+    }
+  }
+
+ public:
+  explicit(true) RenderThread(std::unique_ptr<RenderBackend> backend)
+      : backend_(MOV(backend)) {
+    if (backend_ == nullptr) [[unlikely]] {
+      throw nova_exception{"RenderThread: no backend"};
+    }
+    thread_ = std::jthread{[this] { render_loop(); }};
+  }
+
+  RenderThread(RenderThread&&) = delete;
+  RenderThread(RenderThread const&) = delete;
+  RenderThread& operator=(RenderThread&&) = delete;
+  RenderThread& operator=(RenderThread const&) = delete;
+
+  ~RenderThread() { stop(); }
+
+  /// @brief The frame being extracted. Only the simulation thread may touch
+  /// it, between two calls to `submit()`.
+  [[nodiscard]] auto frame() noexcept -> RenderFrame& { return back_; }
+
+  /// @brief Hands `frame()` over to the render thread, once it is done with
+  /// the previous frame, and gives the simulation a buffer to fill next.
+  auto submit() -> void {
+    {
+      auto lock = std::unique_lock{mutex_};
+      cv_.wait(lock, [&] { return not pending_; });
+      rethrow_error(lock);
+      if (stopping_) [[unlikely]] {
+        throw nova_exception{"RenderThread: submit after stop"};
+      }
+      back_.index = submitted_++;
+      std::swap(front_, back_);
+      pending_ = true;
+    }
+    cv_.notify_all();
+  }
+
+  /// @brief Blocks until every submitted frame is drawn.
+  auto wait_idle() -> void {
+    auto lock = std::unique_lock{mutex_};
+    cv_.wait(lock, [&] { return not pending_; });
+    rethrow_error(lock);
+  }
+
+  /// @brief The number of frames submitted so far.
+  [[nodiscard]] auto submitted() noexcept -> std::uint64_t {
+    auto lock = std::scoped_lock{mutex_};
+    return submitted_;
+  }
+
+  [[nodiscard]] auto backend() noexcept -> RenderBackend& { return *backend_; }
+
+  /// @brief Draws the frame in flight, if any, and joins the render thread.
+  /// The backend is not used anymore afterwards.
+  auto stop() -> void {
+    {
+      auto lock = std::scoped_lock{mutex_};
+      stopping_ = true;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+};
+
+}  // namespace nova
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+
+namespace nova {
+
+struct Color {
+  std::uint8_t r{};
+  std::uint8_t g{};
+  std::uint8_t b{};
+  std::uint8_t a{255u};
+
+  constexpr auto operator==(const Color&) const -> bool = default;
+};
+
+/// @brief A 2D vertex, laid out like the vertices of common 2D renderers
+/// (position, color, texture coordinates; e.g. `sf::Vertex`) so a buffer of
+/// them can be handed to the backend without conversion.
+struct Vertex {
+  float x{};
+  float y{};
+  Color color{};
+  float u{};
+  float v{};
+};
+
+static_assert(sizeof(Vertex) == 5u * sizeof(float));
+
+}  // namespace nova
@@ -5,6 +5,7 @@
 #include <nova/util/common.hpp>
 #include <nova/util/type_map.hpp>
 #include <numeric>
+#include <thread>
 #include <tl/optional.hpp>
 
 namespace nova {
@@ -56,8 +57,19 @@ struct Local : detail::ResourceBase<T> {
   using detail::ResourceBase<T>::ResourceBase;
 };
 
+/// @brief A resource that may only be used on the main thread, such as a
+/// window or a graphics context. Systems taking a `NonSend<T>` are always run
+/// on the thread that runs the scheduler.
+template <typename T>
+struct NonSend : detail::ResourceBase<T> {
+  using detail::ResourceBase<T>::ResourceBase;
+};
+
 class Resources {
   TypeMap resources_;
+  // stored apart so that they cannot be reached through `Resource<T>`.
+  TypeMap non_send_;
+  std::thread::id main_thread_{};
 
  public:
   // Resources
@@ -110,10 +122,67 @@ class Resources {
     return get<T>();
   }
 
-  auto clear() -> void { resources_.clear(); }
+  // Main thread only resources
+
+  template <typename T, typename... Args>
+  auto try_add_non_send(Args&&... args) -> std::pair<NonSend<T>, bool> {
+    static_assert(not std::is_reference_v<T>,
+                  "resources cannot be reference types.");
+    main_thread_ = std::this_thread::get_id();
+    auto [resource, inserted] =
+        non_send_.try_add<std::remove_const_t<T>>(FWD(args)...);
+    return std::pair{NonSend<T>{resource}, inserted};
+  }
+
+  /// @brief Inserts a main thread only resource. The calling thread becomes
+  /// the main thread.
+  template <typename T, typename... Args>
+  auto set_non_send(Args&&... args) -> NonSend<T> {
+    static_assert(not std::is_reference_v<T>,
+                  "resources cannot be reference types.");
+    main_thread_ = std::this_thread::get_id();
+    T& resource = non_send_.set<std::remove_const_t<T>>(FWD(args)...);
+    return NonSend<T>{resource};
+  }
+
+  template <typename T>
+  auto remove_non_send() -> tl::optional<T> {
+    return non_send_.remove<T>();
+  }
+
+  template <typename T>
+  [[nodiscard]] auto contains_non_send() const -> bool {
+    return non_send_.contains<std::remove_cvref_t<T>>();
+  }
+
+  template <typename T>
+  [[nodiscard]] auto get_non_send() -> tl::optional<NonSend<T>> {
+    static_assert(not std::is_reference_v<T>,
+                  "resources cannot be reference types.");
+    return non_send_.get<std::remove_const_t<T>>().map(
+        [](T& value) { return NonSend<T>{value}; });
+  }
+
+  /// @brief The thread the main thread only resources were inserted from.
+  [[nodiscard]] auto main_thread() const noexcept -> std::thread::id {
+    return main_thread_;
+  }
+
+  auto clear() -> void {
+    resources_.clear();
+    non_send_.clear();
+  }
 
   [[nodiscard]] auto size() const noexcept -> std::size_t {
-    return std::size(resources_);
+    return std::size(resources_) + std::size(non_send_);
+  }
+
+  /// @brief Calls `func(type_id, value)` for every resource, main thread
+  /// only ones included. `value` is the `void_ptr` holding the resource.
+  template <typename TFunc>
+  auto for_each(TFunc&& func) const -> void {
+    resources_.for_each(func);
+    non_send_.for_each(func);
   }
 };
 
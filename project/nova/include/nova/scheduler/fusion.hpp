@@ -0,0 +1,171 @@
+#pragma once
+
+#include <algorithm>
+#include <entt/entt.hpp>
+#include <nova/system/system_data.hpp>
+#include <nova/util/common.hpp>
+#include <nova/util/type.hpp>
+#include <span>
+#include <tl/optional.hpp>
+#include <vector>
+
+namespace nova {
+
+namespace detail {
+
+// Number of entities each fused kernel processes before handing over to the
+// next kernel in the group. Small enough that the block's components are
+// still in cache when the next kernel touches them.
+inline constexpr std::size_t FUSED_BLOCK_SIZE = 256u;
+
+/// @brief A run of consecutive systems within a stage.
+/// When `driver` is set, the systems are kernels that all share a component
+/// and are run as a single pass over that component's storage.
+struct SystemBatch {
+  std::size_t first{};
+  std::size_t count{};
+  tl::optional<SystemKernel::storage_func_t> driver{};
+};
+
+/// @brief Groups the (already sorted) systems of a stage into batches.
+/// Consecutive kernel systems are fused as long as every kernel in the group
+/// shares at least one component with all the others.
+inline auto plan_batches(std::span<const System> systems)
+    -> std::vector<SystemBatch> {
+  auto batches = reserved<std::vector<SystemBatch>>(std::size(systems));
+
+  for (auto first = std::size_t{0}; first < std::size(systems);) {
+    const auto& head = systems[first];
+    if (not head.kernel.has_value()) {
+      batches.push_back(SystemBatch{.first = first, .count = 1u});
+      ++first;
+      continue;
+    }
+
+    auto shared = head.kernel->components;
+    auto last = first + 1u;
+    for (; last < std::size(systems) and systems[last].kernel.has_value();
+         ++last) {
+      const auto& components = systems[last].kernel->components;
+      auto remaining = shared;
+      std::erase_if(remaining, [&](const auto& component) -> bool {
+        return std::ranges::none_of(components, [&](const auto& other) {
+          return other.id == component.id;
+        });
+      });
+
+      if (std::empty(remaining)) {
+        break;
+      }
+      shared = MOV(remaining);
+    }
+
+    auto batch = SystemBatch{.first = first, .count = last - first};
+    if (batch.count > 1u) {
+      batch.driver = shared.front().storage;
+    }
+    batches.push_back(MOV(batch));
+    first = last;
+  }
+
+  return batches;
+}
+
+/// @brief Runs systems `[first, first + count)` of a stage by calling
+/// `func`. The scheduler swaps it for a probe that reports them to its
+/// observers, e.g. to measure them.
+struct RunSystem {
+  // whether fused kernels must be run one pass after the other, to be
+  // reported one by one.
+  [[nodiscard]] static constexpr auto splits_fused_batches() noexcept
+      -> bool {
+    return false;
+  }
+
+  template <typename TFunc>
+  constexpr auto operator()(const std::size_t, const std::size_t,
+                            TFunc&& func) const -> void {
+    FWD(func)();
+  }
+};
+
+// Calls `func(block)` for every block of `FUSED_BLOCK_SIZE` entities of the
+// driver storage.
+template <typename TFunc>
+auto for_each_block(const SystemKernel::storage_func_t driver,
+                    void* const world_ptr, TFunc&& func) -> void {
+  const auto& storage = driver(world_ptr);
+  const auto entities =
+      std::span<const entt::entity>{storage.data(), storage.size()};
+  for (auto offset = std::size_t{0}; offset < std::size(entities);
+       offset += FUSED_BLOCK_SIZE) {
+    func(entities.subspan(
+        offset, std::min(FUSED_BLOCK_SIZE, std::size(entities) - offset)));
+  }
+}
+
+/// @brief Runs a group of kernels as a single pass over the driver storage.
+/// Each block of entities is handed to every kernel in order, so each entity
+/// still observes the kernels in their declared order.
+inline auto run_fused(std::span<System> systems,
+                      const SystemKernel::storage_func_t driver,
+                      void* const world_ptr) -> void {
+  for (auto& system : systems) {
+    system.kernel->prepare_func(system.meta, system.data.data(), world_ptr);
+  }
+  for_each_block(driver, world_ptr, [&](const auto block) {
+    for (auto& system : systems) {
+      system.kernel->block_func(system.data.data(), world_ptr, block);
+    }
+  });
+  for (auto& system : systems) {
+    system.kernel->finish_func(system.meta, system.data.data(), world_ptr);
+  }
+}
+
+/// @brief Runs a group of kernels one after the other, each over every block
+/// of the driver storage, so that `probe` reports each kernel once rather
+/// than around every block. Entities still observe the kernels in their
+/// declared order.
+template <typename TProbe>
+auto run_fused_split(std::span<System> systems,
+                     const SystemKernel::storage_func_t driver,
+                     void* const world_ptr, const std::size_t first,
+                     const TProbe& probe) -> void {
+  for (auto i = std::size_t{0}; i < std::size(systems); ++i) {
+    auto& system = systems[i];
+    probe(first + i, 1u, [&] {
+      system.kernel->prepare_func(system.meta, system.data.data(), world_ptr);
+      for_each_block(driver, world_ptr, [&](const auto block) {
+        system.kernel->block_func(system.data.data(), world_ptr, block);
+      });
+      system.kernel->finish_func(system.meta, system.data.data(), world_ptr);
+    });
+  }
+}
+
+/// @brief Runs a batch, reporting its systems to `probe` by their index in
+/// the stage. A fused batch is reported as a whole, as it runs, unless the
+/// probe splits fused batches.
+template <typename TProbe = RunSystem>
+auto run_batch(std::span<System> systems, const SystemBatch& batch,
+               void* const world_ptr, const TProbe& probe = {}) -> void {
+  const auto batch_systems = systems.subspan(batch.first, batch.count);
+  if (batch.driver.has_value()) {
+    if (probe.splits_fused_batches()) {
+      run_fused_split(batch_systems, *batch.driver, world_ptr, batch.first,
+                      probe);
+    } else {
+      probe(batch.first, batch.count,
+            [&] { run_fused(batch_systems, *batch.driver, world_ptr); });
+    }
+  } else {
+    for (auto i = std::size_t{0}; i < std::size(batch_systems); ++i) {
+      probe(batch.first + i, 1u, [&] { batch_systems[i].run(world_ptr); });
+    }
+  }
+}
+
+}  // namespace detail
+
+}  // namespace nova
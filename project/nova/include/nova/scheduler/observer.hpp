@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <nova/system/system_data.hpp>
+#include <nova/util/common.hpp>
+#include <ranges>
+#include <span>
+#include <string_view>
+
+namespace nova {
+
+class World;
+struct Scheduler;
+
+/// @brief Follows the frames, stages and systems `Scheduler::update` runs,
+/// e.g. to measure them. The scheduler reports to the observers that are
+/// resources of the world it updates, among the types it was told to
+/// `observe`.
+///
+/// Hooks are called in the order the types were registered, and the `end`
+/// ones in reverse, so that an observer's `end` hooks see those registered
+/// after it complete.
+class SchedulerObserver {
+ public:
+  virtual ~SchedulerObserver() = default;
+
+  /// @brief Whether to report every system run through `on_systems_begin`
+  /// and `on_systems_end`, which costs a pair of virtual calls per system.
+  [[nodiscard]] virtual auto observes_systems() const noexcept -> bool {
+    return false;
+  }
+
+  /// @brief Whether fused kernels must be reported one by one. They then run
+  /// one full pass after the other instead of block by block, which changes
+  /// how they execute: only for observers that must tell the kernels apart,
+  /// e.g. to name the one that allocates.
+  [[nodiscard]] virtual auto splits_fused_batches() const noexcept -> bool {
+    return false;
+  }
+
+  /// @brief Starts a frame of `n_stages` stages.
+  virtual auto on_frame_begin(const std::size_t /*n_stages*/) -> void {}
+
+  /// @brief Starts stage `index`, about to run `systems`.
+  virtual auto on_stage_begin(const std::size_t /*index*/,
+                              const std::string_view /*name*/,
+                              std::span<const System> /*systems*/) -> void {}
+
+  /// @brief Systems `[first, first + count)` of stage `stage` are about to
+  /// run, on the calling thread, which may be any thread of a `TaskPool`.
+  /// `count` is more than one for kernels fused into a single pass.
+  virtual auto on_systems_begin(const std::size_t /*stage*/,
+                                const std::size_t /*first*/,
+                                const std::size_t /*count*/) noexcept
+      -> void {}
+
+  /// @brief Systems `[first, first + count)` of stage `stage` ran, on the
+  /// calling thread.
+  virtual auto on_systems_end(const std::size_t /*stage*/,
+                              const std::size_t /*first*/,
+                              const std::size_t /*count*/) noexcept -> void {}
+
+  /// @brief Stage `index` ran.
+  virtual auto on_stage_end(const std::size_t /*index*/) -> void {}
+
+  /// @brief The frame ran `scheduler`'s stages over `world`.
+  virtual auto on_frame_end(World& /*world*/, const Scheduler& /*scheduler*/)
+      -> void {}
+};
+
+namespace detail {
+
+// the observer of some type among the resources of a world, or null.
+using find_observer_t = auto (*)(World&) -> SchedulerObserver*;
+
+/// @brief Reports the systems of stage `stage` to `observers`, in place of
+/// `RunSystem`.
+struct ObserverProbe {
+  std::span<SchedulerObserver* const> observers{};
+  std::size_t stage{};
+  bool split_fused{};
+
+  [[nodiscard]] auto splits_fused_batches() const noexcept -> bool {
+    return split_fused;
+  }
+
+  template <typename TFunc>
+  auto operator()(const std::size_t first, const std::size_t count,
+                  TFunc&& func) const -> void {
+    for (auto* const observer : observers) {
+      observer->on_systems_begin(stage, first, count);
+    }
+    FWD(func)();
+    for (auto* const observer : observers | std::views::reverse) {
+      observer->on_systems_end(stage, first, count);
+    }
+  }
+};
+
+}  // namespace detail
+
+}  // namespace nova
@@ -1,20 +1,32 @@
 #pragma once
 
+#include <algorithm>
+#include <chrono>
+#include <concepts>
 #include <exception>
 #include <format>
 #include <functional>
+#include <memory>
 #include <nova/label/label.hpp>
 #include <nova/resource/resource.hpp>
 #include <nova/system/system_data.hpp>
+#include <nova/task/task_pool.hpp>
 #include <nova/util/common.hpp>
 #include <nova/world.hpp>
+#include <range/v3/view/concat.hpp>
+#include <range/v3/view/move.hpp>
 #include <range/v3/view/tail.hpp>
 #include <range/v3/view/take.hpp>
 #include <range/v3/view/zip.hpp>
+#include <ranges>
+#include <span>
+#include <string_view>
 #include <type_traits>
 #include <vector>
 
+#include "fusion.hpp"
 #include "graph.hpp"
+#include "observer.hpp"
 #include "stage.hpp"
 
 namespace nova {
@@ -32,10 +44,263 @@ struct SystemsContainer {
   std::vector<SystemSchedulingData> meta{};
 };
 
+template <typename TResult>
+auto unwrap_dependency_cycle_error(const auto& name, TResult&& result,
+                                   auto get_name_fn) {
+  if (result.has_value()) {
+    return *FWD(result);
+  } else {
+    const auto& cycle = result.error().cycle;
+    auto message = std::format("Found a dependnecy cycle in {}:\n", name);
+    for (const auto& index : cycle | ranges::views::tail) {
+      std::format_to(std::back_inserter(message),
+                     "- `{}`\n wants to be after\n", get_name_fn(index));
+    }
+    for (const auto& index : cycle | ranges::views::take(1)) {
+      std::format_to(std::back_inserter(message), "- `{}`\n",
+                     get_name_fn(index));
+    }
+    throw nova_exception{std::move(message)};
+  }
+}
+
+// sorts `repr` and `meta` in dependency order and returns, for each sorted
+// element, the length of the longest dependency chain leading to it.
+template <typename TMeta, typename T>
+auto sort_by_dependencies(const auto& name, std::vector<TMeta>& meta,
+                          std::vector<T>& repr, auto get_name_fn)
+    -> std::vector<std::size_t> {
+  const auto graph = build_dependency_graph(meta);
+  auto sorted_order = unwrap_dependency_cycle_error(
+      name, topological_order(graph), get_name_fn);
+
+  const auto n = std::size(repr);
+  auto sorted_repr = reserved<std::vector<T>>(n);
+  auto sorted_meta = reserved<std::vector<TMeta>>(n);
+  auto depths = std::vector<std::size_t>(n, 0u);
+  auto levels = reserved<std::vector<std::size_t>>(n);
+
+  for (const auto index : sorted_order) {
+    for (const auto dependency : graph.at(index) | std::views::keys) {
+      depths[index] = std::max(depths[index], depths[dependency] + 1u);
+    }
+    levels.push_back(depths[index]);
+    sorted_repr.push_back(MOV(repr[index]));
+    sorted_meta.push_back(MOV(meta[index]));
+  }
+
+  repr.swap(sorted_repr);
+  meta.swap(sorted_meta);
+  return levels;
+}
+
+inline auto get_system_name(const std::vector<System>& systems) {
+  return [&](const auto index) -> std::string_view {
+    return systems[index].meta.id.name();
+  };
+}
+
+// Inserts a system into an already sorted container without re-sorting it.
+// The system is placed after the last system it has to run after, as long as
+// that is still before the first system it has to run before. Otherwise the
+// whole container is re-sorted.
+inline auto insert_sorted(const std::string& name, SystemsContainer& container,
+                          System system, SystemSchedulingData meta) -> void {
+  const auto has_label = [](const Labels& labels, const Label& label) -> bool {
+    return nova::contains(labels, equals(label));
+  };
+  const auto has_any_label = [&](const Labels& labels,
+                                 const Labels& wanted) -> bool {
+    return std::ranges::any_of(
+        wanted, [&](const auto& label) { return has_label(labels, label); });
+  };
+
+  for (const auto& label :
+       ranges::views::concat(meta.ordering.after, meta.ordering.before)) {
+    const auto exists =
+        has_label(meta.labels, label) or
+        std::ranges::any_of(container.meta, [&](const auto& other) {
+          return has_label(other.labels, label);
+        });
+    if (not exists) {
+      throw nova_exception{std::format(
+          "unable to find label `{}` while building dependency graph",
+          label.name)};
+    }
+  }
+
+  const auto n = std::size(container.systems);
+  auto lower = std::size_t{0};
+  auto upper = n;
+  for (auto index = std::size_t{0}; index < n; ++index) {
+    const auto& other = container.meta[index];
+    if (has_any_label(other.labels, meta.ordering.after) or
+        has_any_label(meta.labels, other.ordering.before)) {
+      lower = std::max(lower, index + 1u);
+    }
+    if (has_any_label(other.labels, meta.ordering.before) or
+        has_any_label(meta.labels, other.ordering.after)) {
+      upper = std::min(upper, index);
+    }
+  }
+
+  if (lower <= upper) {
+    const auto offset = static_cast<std::ptrdiff_t>(upper);
+    container.systems.insert(std::begin(container.systems) + offset,
+                             MOV(system));
+    container.meta.insert(std::begin(container.meta) + offset, MOV(meta));
+    return;
+  }
+
+  container.systems.push_back(MOV(system));
+  container.meta.push_back(MOV(meta));
+  try {
+    sort_by_dependencies(name, container.meta, container.systems,
+                         get_system_name(container.systems));
+  } catch (...) {
+    container.systems.pop_back();
+    container.meta.pop_back();
+    throw;
+  }
+}
+
+// Keeps only the systems of `container` whose state is one of `kept`, in
+// that order. Undoes insertions, given the states from before them.
+inline auto restore_systems(SystemsContainer& container,
+                            std::span<const void* const> kept) -> void {
+  auto restored = SystemsContainer{};
+  restored.systems.reserve(std::size(kept));
+  restored.meta.reserve(std::size(kept));
+  for (const auto* const data : kept) {
+    const auto found = std::ranges::find(
+        container.systems, data,
+        [](const System& system) { return system.data.cdata(); });
+    const auto index = static_cast<std::size_t>(
+        std::distance(std::begin(container.systems), found));
+    restored.systems.push_back(MOV(container.systems[index]));
+    restored.meta.push_back(MOV(container.meta[index]));
+  }
+  container = MOV(restored);
+}
+
+/// @brief A run of consecutive batches of a stage that are not ordered
+/// relative to each other and have no conflicting access, so they can run
+/// concurrently.
+struct BatchGroup {
+  std::size_t first{};
+  std::size_t count{};
+  // the batches (indices in the stage) that must run on the main thread.
+  std::vector<std::size_t> main_thread{};
+  // the batches that can run on any thread.
+  std::vector<std::size_t> any_thread{};
+};
+
+/// @brief Splits the (already sorted and batched) systems of a stage into
+/// groups of batches that may run concurrently.
+inline auto plan_groups(const SystemsContainer& container,
+                        std::span<const SystemBatch> batches)
+    -> std::vector<BatchGroup> {
+  const auto refers_to = [](const SystemSchedulingData& from,
+                            const SystemSchedulingData& to) -> bool {
+    return std::ranges::any_of(to.labels, [&](const auto& label) {
+      return nova::contains(from.ordering.after, equals(label)) or
+             nova::contains(from.ordering.before, equals(label));
+    });
+  };
+  const auto ordered = [&](const SystemBatch& lhs,
+                           const SystemBatch& rhs) -> bool {
+    for (auto i = lhs.first; i < lhs.first + lhs.count; ++i) {
+      for (auto j = rhs.first; j < rhs.first + rhs.count; ++j) {
+        if (refers_to(container.meta[i], container.meta[j]) or
+            refers_to(container.meta[j], container.meta[i])) {
+          return true;
+        }
+      }
+    }
+    return false;
+  };
+
+  auto accesses = reserved<std::vector<Access>>(std::size(batches));
+  for (const auto& batch : batches) {
+    auto access = Access{};
+    for (auto i = batch.first; i < batch.first + batch.count; ++i) {
+      auto system_access = container.meta[i].access;
+      access.merge(MOV(system_access));
+    }
+    accesses.push_back(MOV(access));
+  }
+
+  auto groups = std::vector<BatchGroup>{};
+  for (auto first = std::size_t{0}; first < std::size(batches);) {
+    auto group = BatchGroup{.first = first};
+    auto last = first;
+    for (; last < std::size(batches); ++last) {
+      const auto compatible = [&](const std::size_t member) {
+        return not accesses[member].conflicts_with(accesses[last]) and
+               not ordered(batches[member], batches[last]);
+      };
+      if (not std::ranges::all_of(std::views::iota(first, last), compatible)) {
+        break;
+      }
+      (accesses[last].main_thread ? group.main_thread : group.any_thread)
+          .push_back(last);
+    }
+    group.count = last - first;
+    groups.push_back(MOV(group));
+    first = last;
+  }
+  return groups;
+}
+
+/// @brief Runs a group of batches, those pinned to the main thread on the
+/// calling thread and the others on the task pool. The calling thread joins
+/// the others once done with its own, so the group never waits on work
+/// queued on the pool before it.
+template <typename TProbe = RunSystem>
+auto run_group(std::span<System> systems, std::span<const SystemBatch> batches,
+               const BatchGroup& group, void* const world_ptr, TaskPool& pool,
+               const TProbe& probe = {}) -> void {
+  const auto run_any_thread = [&](const std::size_t index) {
+    run_batch(systems, batches[group.any_thread[index]], world_ptr, probe);
+  };
+  const auto run_main_thread = [&] {
+    for (const auto index : group.main_thread) {
+      run_batch(systems, batches[index], world_ptr, probe);
+    }
+  };
+
+  if (std::empty(group.main_thread) and group.count == 1u) {
+    run_any_thread(0u);
+  } else if (std::empty(group.main_thread)) {
+    pool.parallel_for(std::size(group.any_thread), run_any_thread);
+  } else if (std::empty(group.any_thread)) {
+    run_main_thread();
+  } else {
+    pool.parallel_for(std::size(group.any_thread), run_any_thread,
+                      run_main_thread);
+  }
+}
+
 }  // namespace detail
 
 struct Stage {
   detail::SystemsContainer systems{};
+  std::vector<detail::SystemBatch> batches{};
+  std::vector<detail::BatchGroup> groups{};
+
+  /// @brief Plans the batches and groups of the (sorted) systems.
+  auto plan() -> void {
+    batches = detail::plan_batches(systems.systems);
+    groups = detail::plan_groups(systems, batches);
+  }
+
+  /// @brief Creates the component pools the systems use, which they would
+  /// otherwise create while running concurrently.
+  auto assure_pools(void* const world_ptr) const -> void {
+    for (const auto& system : systems.systems) {
+      system.assure_pools(world_ptr);
+    }
+  }
 };
 
 struct Stages {
@@ -43,6 +308,22 @@ struct Stages {
   std::vector<StageMeta> meta{};
 };
 
+/// @brief How long each phase of `Scheduler::initialize_systems` took.
+struct InitializationReport {
+  using duration_t = std::chrono::duration<double>;
+
+  // sorting the stages by their ordering.
+  duration_t sort_stages{};
+  // sorting the systems of every stage (and startup/teardown) by their
+  // ordering and planning the stages' batches.
+  duration_t sort_systems{};
+  // initializing the state of every system.
+  duration_t initialize_systems{};
+  duration_t total{};
+  // the number of threads the work was spread across.
+  std::size_t thread_count{1u};
+};
+
 struct Scheduler {
   detail::SystemsContainer startup_systems{};
   Stages stages{};
@@ -51,6 +332,13 @@ struct Scheduler {
   tl::optional<Label> first_stage{};
   tl::optional<Label> last_stage{};
 
+  InitializationReport initialization_report{};
+  // set once `initialize_systems` ran, from then on systems can only be
+  // added through `insert_system_to_stage`.
+  bool initialized{false};
+  // finds the observers `update` reports to, see `observe`.
+  std::vector<detail::find_observer_t> observer_lookups{};
+
   auto stage_count() const -> std::size_t { return std::size(stages.stages); }
   auto system_count() const -> std::size_t {
     const auto n_startup = std::size(startup_systems.systems);
@@ -167,16 +455,30 @@ struct Scheduler {
     }
   }
 
-  template <concepts::into_label_ref TStageLabel, typename TSystem>
-  auto add_system_to_stage(TSystem&& system, TStageLabel&& label = {}) -> void {
-    const auto label_ref = to_label_ref(FWD(label));
+  auto find_stage_index(const LabelRef label_ref) const
+      -> tl::optional<std::size_t> {
     if (const auto stage = std::ranges::find(
-            std::as_const(stages.meta), label_ref,
+            stages.meta, label_ref,
             [](const auto& meta) -> const auto& { return meta.primary_label; });
         stage != std::cend(stages.meta)) {
-      const auto index = static_cast<std::size_t>(
+      return static_cast<std::size_t>(
           std::distance(std::cbegin(stages.meta), stage));
-      add_system_impl(FWD(system), stages.stages[index].systems);
+    }
+    return {};
+  }
+
+  template <concepts::into_label_ref TStageLabel, typename TSystem>
+  auto add_system_to_stage(TSystem&& system, TStageLabel&& label = {}) -> void {
+    const auto label_ref = to_label_ref(FWD(label));
+    if (initialized) {
+      throw nova_exception{std::format(
+          "add_system_to_stage: the scheduler is already initialized, use "
+          "`insert_system_to_stage` to add systems to stage `{}`",
+          label_ref.name)};
+    }
+
+    if (const auto index = find_stage_index(label_ref); index.has_value()) {
+      add_system_impl(FWD(system), stages.stages[*index].systems);
     } else {
       throw nova_exception{std::format(
           "add_system_to_stage: could not find stage with primary label: `{}`",
@@ -184,62 +486,198 @@ struct Scheduler {
     }
   }
 
+  /// @brief Adds a system to a stage of an already initialized scheduler.
+  /// The system is slotted into the stage's existing order when its ordering
+  /// allows it, otherwise only that stage is re-sorted. Only the new system's
+  /// state is initialized. A system set is inserted as a whole, or not at all
+  /// if this throws.
+  /// If the scheduler is not initialized yet, this is `add_system_to_stage`.
+  ///
+  /// NOTE: must not be called while the scheduler updates, e.g. from a
+  /// system, as that invalidates the systems being run.
+  template <concepts::into_label_ref TStageLabel, typename TSystem>
+  auto insert_system_to_stage(World& world, TSystem&& system,
+                              TStageLabel&& label = {}) -> void {
+    if (not initialized) {
+      add_system_to_stage(FWD(system), FWD(label));
+      return;
+    }
+
+    const auto label_ref = to_label_ref(FWD(label));
+    const auto index = find_stage_index(label_ref);
+    if (not index.has_value()) {
+      throw nova_exception{std::format(
+          "insert_system_to_stage: could not find stage with primary label: "
+          "`{}`",
+          label_ref.name)};
+    }
+
+    auto& stage = stages.stages[*index];
+    const auto name = std::format("stage:`{}` - systems",
+                                  stages.meta[*index].primary_label.name);
+
+    auto inserted = detail::SystemsContainer{};
+    add_system_impl(FWD(system), inserted);
+
+    // a system set is inserted as a whole: if one of its systems cannot be,
+    // those already inserted are taken out again.
+    auto before = reserved<std::vector<const void*>>(
+        std::size(stage.systems.systems));
+    for (const auto& existing : stage.systems.systems) {
+      before.push_back(existing.data.cdata());
+    }
+
+    auto* const world_ptr = static_cast<void*>(&world);
+    try {
+      for (auto&& [new_system, new_meta] :
+           ranges::views::zip(inserted.systems, inserted.meta) |
+               ranges::views::move) {
+        new_system.assure_pools(world_ptr);
+        new_system.initialize(world_ptr);
+        detail::insert_sorted(name, stage.systems, MOV(new_system),
+                              MOV(new_meta));
+      }
+    } catch (...) {
+      detail::restore_systems(stage.systems, before);
+      throw;
+    }
+
+    stage.plan();
+  }
+
+  /// @brief Removes every system with the given label from a stage.
+  /// Throws, without removing anything, if a remaining system of the stage is
+  /// ordered relative to a label only the removed systems have.
+  ///
+  /// @return The number of removed systems.
+  template <concepts::into_label TLabel, concepts::into_label_ref TStageLabel>
+  auto remove_systems_from_stage(TLabel&& label, TStageLabel&& stage_label = {})
+      -> std::size_t {
+    const auto removed_label = to_label(FWD(label));
+    const auto stage_ref = to_label_ref(FWD(stage_label));
+    const auto index = find_stage_index(stage_ref);
+    if (not index.has_value()) {
+      throw nova_exception{std::format(
+          "remove_systems_from_stage: could not find stage with primary "
+          "label: `{}`",
+          stage_ref.name)};
+    }
+
+    auto& stage = stages.stages[*index];
+    auto& meta = stage.systems.meta;
+    const auto is_removed = [&](const auto& system_meta) -> bool {
+      return nova::contains(system_meta.labels, equals(removed_label));
+    };
+
+    for (const auto& remaining :
+         meta | std::views::filter(std::not_fn(is_removed))) {
+      for (const auto& ordered : ranges::views::concat(
+               remaining.ordering.after, remaining.ordering.before)) {
+        const auto still_provided =
+            std::ranges::any_of(meta, [&](const auto& other) {
+              return not is_removed(other) and
+                     nova::contains(other.labels, equals(ordered));
+            });
+        if (not still_provided) {
+          throw nova_exception{std::format(
+              "remove_systems_from_stage: cannot remove `{}` from stage `{}` "
+              "as a remaining system is ordered relative to `{}`",
+              removed_label.name, stage_ref.name, ordered.name)};
+        }
+      }
+    }
+
+    auto kept = detail::SystemsContainer{};
+    kept.systems.reserve(std::size(stage.systems.systems));
+    kept.meta.reserve(std::size(meta));
+    for (auto&& [system, system_meta] :
+         ranges::views::zip(stage.systems.systems, meta) |
+             ranges::views::move) {
+      if (not is_removed(system_meta)) {
+        kept.systems.push_back(MOV(system));
+        kept.meta.push_back(MOV(system_meta));
+      }
+    }
+
+    const auto n_removed =
+        std::size(stage.systems.systems) - std::size(kept.systems);
+    stage.systems = MOV(kept);
+    stage.plan();
+    return n_removed;
+  }
+
+  /// @brief Adds a system that runs once, before the first update.
+  /// Throws once the scheduler is initialized.
   template <typename TSystem>
   auto add_startup_system(TSystem&& system) -> void {
+    if (initialized) {
+      throw nova_exception{
+          "add_startup_system: the scheduler is already initialized"};
+    }
     add_system_impl(FWD(system), startup_systems);
   }
 
+  /// @brief Adds a system that runs once, after the last update.
+  /// Throws once the scheduler is initialized, as the system's state would
+  /// never be.
   template <typename TSystem>
   auto add_teardown_system(TSystem&& system) -> void {
+    if (initialized) {
+      throw nova_exception{
+          "add_teardown_system: the scheduler is already initialized"};
+    }
     add_system_impl(FWD(system), teardown_systems);
   }
 
-  auto initialize_systems(World& world) {
-    constexpr auto unwrap_dependency_cycle_error = [](const auto& name,
-                                                      auto&& result,
-                                                      auto get_name_fn) {
-      if (result.has_value()) {
-        return *FWD(result);
-      } else {
-        const auto& cycle = result.error().cycle;
-        auto message = std::format("Found a dependnecy cycle in {}:\n", name);
-        for (const auto& index : cycle | ranges::views::tail) {
-          std::format_to(std::back_inserter(message),
-                         "- `{}`\n wants to be after\n", get_name_fn(index));
-        }
-        for (const auto& index : cycle | ranges::views::take(1)) {
-          std::format_to(std::back_inserter(message), "- `{}`\n",
-                         get_name_fn(index));
-        }
-        throw nova_exception{std::move(message)};
-      }
+  /// @brief Has `update` report to the `T` resource of the world it updates,
+  /// whenever there is one. Registering a type twice has no effect.
+  template <std::derived_from<SchedulerObserver> T>
+  auto observe() -> void {
+    auto* const lookup = +[](World& world) -> SchedulerObserver* {
+      auto found = world.resources().get<T>();
+      return found.has_value() ? std::addressof(**found) : nullptr;
     };
+    if (std::ranges::find(observer_lookups, lookup) ==
+        std::end(observer_lookups)) {
+      observer_lookups.push_back(lookup);
+    }
+  }
 
-    const auto sort = [&]<typename TMeta, typename T>(
-                          const auto& name, std::vector<TMeta>& meta,
-                          std::vector<T>& repr, auto get_name_fn) {
-      const auto graph = build_dependency_graph(meta);
-      auto sorted_order = unwrap_dependency_cycle_error(
-          name, topological_order(graph), get_name_fn);
+  /// @brief Sorts every stage and system by their ordering and initializes
+  /// each system's state, one after the other on the calling thread.
+  auto initialize_systems(World& world) -> const InitializationReport& {
+    return initialize_systems_impl(
+        world, 1u, [](const std::size_t n, auto&& func) {
+          for (auto i = std::size_t{0}; i < n; ++i) {
+            func(i);
+          }
+        });
+  }
 
-      const auto n = std::size(repr);
-      auto sorted_repr = reserved<std::vector<T>>(n);
-      auto sorted_meta = reserved<std::vector<TMeta>>(n);
+  /// @brief Same as `initialize_systems(world)`, but sorts the systems of each
+  /// stage and initializes the systems' state in parallel on `pool`.
+  /// A system's state is only initialized once the state of every system it
+  /// is ordered after (within the same stage) has been initialized.
+  ///
+  /// NOTE: `nova::from_world<T>` specializations used by system state (e.g.
+  /// `Local<T>`) may be invoked concurrently and must not modify the `World`.
+  auto initialize_systems(World& world, TaskPool& pool)
+      -> const InitializationReport& {
+    return initialize_systems_impl(
+        world, pool.thread_count() + 1u,
+        [&](const std::size_t n, auto&& func) {
+          pool.parallel_for(n, FWD(func));
+        });
+  }
 
-      for (const auto index : sorted_order) {
-        sorted_repr.push_back(MOV(repr[index]));
-        sorted_meta.push_back(MOV(meta[index]));
-      }
+ private:
+  template <typename TForEach>
+  auto initialize_systems_impl(World& world, const std::size_t thread_count,
+                               TForEach&& for_each_index)
+      -> const InitializationReport& {
+    using clock_t = std::chrono::steady_clock;
 
-      repr.swap(sorted_repr);
-      meta.swap(sorted_meta);
-    };
-
-    const auto get_system_name = [](const auto& systems) {
-      return [&](const auto index) -> std::string_view {
-        return systems[index].meta.id.name();
-      };
-    };
+    using detail::get_system_name;
 
     const auto get_stage_name = [](const auto& stage_meta) {
       return [&](const auto index) -> const auto& {
@@ -247,36 +685,153 @@ struct Scheduler {
       };
     };
 
-    sort("startup_systems", startup_systems.meta, startup_systems.systems,
-         get_system_name(startup_systems.systems));
-    sort("teardown_systems", teardown_systems.meta, teardown_systems.systems,
-         get_system_name(teardown_systems.systems));
+    const auto elapsed_since = [](const auto start) {
+      return std::chrono::duration_cast<InitializationReport::duration_t>(
+          clock_t::now() - start);
+    };
 
-    for (auto&& [stage, meta] :
-         ranges::views::zip(stages.stages, stages.meta)) {
-      sort(std::format("stage:`{}` - systems", meta.primary_label.name),
-           stage.systems.meta, stage.systems.systems,
-           get_system_name(stage.systems.systems));
-    }
+    auto report = InitializationReport{.thread_count = thread_count};
+    const auto start = clock_t::now();
+
+    detail::sort_by_dependencies("stages", stages.meta, stages.stages,
+                                 get_stage_name(stages.meta));
+    report.sort_stages = elapsed_since(start);
+
+    // [startup, teardown, stages...]
+    const auto n_containers = std::size(stages.stages) + 2u;
+    const auto container = [&](const std::size_t index) -> auto& {
+      switch (index) {
+        case 0u:
+          return startup_systems;
+        case 1u:
+          return teardown_systems;
+        default:
+          return stages.stages[index - 2u].systems;
+      }
+    };
+    const auto container_name = [&](const std::size_t index) -> std::string {
+      switch (index) {
+        case 0u:
+          return "startup_systems";
+        case 1u:
+          return "teardown_systems";
+        default:
+          return std::format("stage:`{}` - systems",
+                             stages.meta[index - 2u].primary_label.name);
+      }
+    };
 
-    sort("stages", stages.meta, stages.stages, get_stage_name(stages.meta));
+    const auto sort_start = clock_t::now();
+    auto levels = std::vector<std::vector<std::size_t>>(n_containers);
+    for_each_index(n_containers, [&](const std::size_t index) {
+      auto& systems = container(index);
+      levels[index] = detail::sort_by_dependencies(
+          container_name(index), systems.meta, systems.systems,
+          get_system_name(systems.systems));
+      if (index >= 2u) {
+        auto& stage = stages.stages[index - 2u];
+        stage.plan();
+      }
+    });
+    report.sort_systems = elapsed_since(sort_start);
 
+    // initialize systems, level by level.
+    const auto initialize_start = clock_t::now();
     auto* const world_ptr = static_cast<void*>(&world);
 
-    // initialize systems
-    for (auto& startup_system : startup_systems.systems) {
-      startup_system.initialize(world_ptr);
+    // the pools are created up front, as systems initialized or run
+    // concurrently must not create them.
+    for (auto index = std::size_t{0}; index < n_containers; ++index) {
+      for (const auto& system : container(index).systems) {
+        system.assure_pools(world_ptr);
+      }
     }
-    for (auto& stage : stages.stages) {
-      for (auto& system : stage.systems.systems) {
-        system.initialize(world_ptr);
+
+    auto pending = reserved<std::vector<std::pair<std::size_t, System*>>>(
+        system_count());
+    for (auto index = std::size_t{0}; index < n_containers; ++index) {
+      for (auto&& [level, system] :
+           ranges::views::zip(levels[index], container(index).systems)) {
+        pending.emplace_back(level, std::addressof(system));
       }
     }
-    for (auto& teardown_system : teardown_systems.systems) {
-      teardown_system.initialize(world_ptr);
+    std::ranges::stable_sort(pending, std::less{},
+                             [](const auto& entry) { return entry.first; });
+
+    for (auto first = std::begin(pending); first != std::end(pending);) {
+      const auto last =
+          std::find_if(first, std::end(pending), [&](const auto& entry) {
+            return entry.first != first->first;
+          });
+      const auto level = std::span{first, last};
+      for_each_index(std::size(level), [&](const std::size_t index) {
+        level[index].second->initialize(world_ptr);
+      });
+      first = last;
+    }
+    report.initialize_systems = elapsed_since(initialize_start);
+    report.total = elapsed_since(start);
+
+    initialization_report = report;
+    initialized = true;
+    return initialization_report;
+  }
+
+  // the observers found for the current `update`, and those of them that
+  // observe every system. Kept to reuse their memory.
+  std::vector<SchedulerObserver*> observers_{};
+  std::vector<SchedulerObserver*> system_observers_{};
+  bool split_fused_ = false;
+
+  // finds the observers among the resources of `world`, and whether there
+  // are any.
+  auto find_observers(World& world) -> bool {
+    observers_.clear();
+    system_observers_.clear();
+    split_fused_ = false;
+    for (const auto lookup : observer_lookups) {
+      if (auto* const observer = lookup(world); observer != nullptr) {
+        observers_.push_back(observer);
+        if (observer->observes_systems()) {
+          system_observers_.push_back(observer);
+          split_fused_ = split_fused_ or observer->splits_fused_batches();
+        }
+      }
     }
+    return not std::empty(observers_);
   }
 
+  // runs `run_stage(stage, probe)` for every stage, reporting the frame, the
+  // stages and, through the probe, the systems to the observers found.
+  template <typename TRunStage>
+  auto update_observed(World& world, TRunStage&& run_stage) -> void {
+    const auto observers = std::span<SchedulerObserver* const>{observers_};
+    for (auto* const observer : observers) {
+      observer->on_frame_begin(std::size(stages.stages));
+    }
+    for (auto i = std::size_t{0}; i < std::size(stages.stages); ++i) {
+      auto& stage = stages.stages[i];
+      const auto& name = stages.meta[i].primary_label.name;
+      for (auto* const observer : observers) {
+        observer->on_stage_begin(i, name, stage.systems.systems);
+      }
+      if (std::empty(system_observers_)) {
+        run_stage(stage, detail::RunSystem{});
+      } else {
+        run_stage(stage, detail::ObserverProbe{.observers = system_observers_,
+                                               .stage = i,
+                                               .split_fused = split_fused_});
+      }
+      for (auto* const observer : observers | std::views::reverse) {
+        observer->on_stage_end(i);
+      }
+    }
+    for (auto* const observer : observers | std::views::reverse) {
+      observer->on_frame_end(world, *this);
+    }
+  }
+
+ public:
   auto startup(World& world) {
     for (auto& system : startup_systems.systems) {
       system.run(static_cast<void*>(std::addressof(world)));
@@ -284,9 +839,48 @@ struct Scheduler {
   }
 
   auto update(World& world) {
+    if (find_observers(world)) {
+      update_observed(world, [&](Stage& stage, const auto& probe) {
+        for (const auto& batch : stage.batches) {
+          detail::run_batch(stage.systems.systems, batch,
+                            static_cast<void*>(std::addressof(world)), probe);
+        }
+      });
+      return;
+    }
+
+    for (auto& stage : stages.stages) {
+      for (const auto& batch : stage.batches) {
+        detail::run_batch(stage.systems.systems, batch,
+                          static_cast<void*>(std::addressof(world)));
+      }
+    }
+  }
+
+  /// @brief Same as `update(world)`, but the systems of a stage that are
+  /// neither ordered relative to each other nor have conflicting access run
+  /// concurrently on `pool`. Systems that must run on the main thread (e.g.
+  /// those taking a `NonSend<T>`) run on the calling thread meanwhile.
+  auto update(World& world, TaskPool& pool) {
+    auto* const world_ptr = static_cast<void*>(std::addressof(world));
+    // a previous stage may have replaced the registry (e.g. loading a
+    // snapshot), so the pools are made sure of before every stage.
+    if (find_observers(world)) {
+      update_observed(world, [&](Stage& stage, const auto& probe) {
+        stage.assure_pools(world_ptr);
+        for (const auto& group : stage.groups) {
+          detail::run_group(stage.systems.systems, stage.batches, group,
+                            world_ptr, pool, probe);
+        }
+      });
+      return;
+    }
+
     for (auto& stage : stages.stages) {
-      for (auto& system : stage.systems.systems) {
-        system.run(static_cast<void*>(std::addressof(world)));
+      stage.assure_pools(world_ptr);
+      for (const auto& group : stage.groups) {
+        detail::run_group(stage.systems.systems, stage.batches, group,
+                          world_ptr, pool);
       }
     }
   }
@@ -296,6 +890,31 @@ struct Scheduler {
       system.run(static_cast<void*>(std::addressof(world)));
     }
   }
+
+  /// @brief Calls `func(system)` for every system, startup and teardown
+  /// systems included.
+  template <typename TFunc>
+  auto for_each_system(TFunc&& func) const -> void {
+    std::ranges::for_each(startup_systems.systems, func);
+    for (const auto& stage : stages.stages) {
+      std::ranges::for_each(stage.systems.systems, func);
+    }
+    std::ranges::for_each(teardown_systems.systems, func);
+  }
+
+  /// @brief Calls `func(name, systems)` for every stage, startup and
+  /// teardown systems included as stages named `startup` and `teardown`.
+  template <typename TFunc>
+  auto for_each_stage(TFunc&& func) const -> void {
+    func(std::string_view{"startup"},
+         std::span<const System>{startup_systems.systems});
+    for (auto i = std::size_t{0}; i < std::size(stages.stages); ++i) {
+      func(std::string_view{stages.meta[i].primary_label.name},
+           std::span<const System>{stages.stages[i].systems.systems});
+    }
+    func(std::string_view{"teardown"},
+         std::span<const System>{teardown_systems.systems});
+  }
 };
 
 }  // namespace nova
@@ -0,0 +1,480 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <entt/entt.hpp>
+#include <format>
+#include <nova/registry.hpp>
+#include <nova/util/common.hpp>
+#include <nova/util/reflection.hpp>
+#include <nova/util/type.hpp>
+#include <nova/util/void_ptr.hpp>
+#include <nova/world.hpp>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace nova {
+
+namespace detail {
+
+inline constexpr std::uint32_t SNAPSHOT_MAGIC = 0x4e4f5641;  // "NOVA"
+inline constexpr std::uint32_t SNAPSHOT_VERSION = 1u;
+
+class SnapshotWriter {
+  std::vector<std::byte>& out_;
+
+ public:
+  explicit(true) SnapshotWriter(std::vector<std::byte>& out) : out_(out) {}
+
+  auto size() const noexcept -> std::size_t { return std::size(out_); }
+
+  // grows the output by `n` bytes and returns where they start.
+  auto grow(const std::size_t n) -> std::byte* {
+    const auto offset = std::size(out_);
+    out_.resize(offset + n);
+    return std::data(out_) + offset;
+  }
+
+  auto write_bytes(const void* const data, const std::size_t n) -> void {
+    if (n != 0u) {
+      std::memcpy(grow(n), data, n);
+    }
+  }
+
+  template <typename T>
+  requires(std::is_trivially_copyable_v<T>) auto write(const T& value)
+      -> void {
+    write_bytes(std::addressof(value), sizeof(T));
+  }
+
+  // overwrites a previously written value, used to patch section lengths.
+  template <typename T>
+  requires(std::is_trivially_copyable_v<T>) auto write_at(
+      const std::size_t offset, const T& value) -> void {
+    std::memcpy(std::data(out_) + offset, std::addressof(value), sizeof(T));
+  }
+};
+
+class SnapshotReader {
+  std::span<const std::byte> bytes_;
+  std::size_t offset_{};
+
+ public:
+  explicit(true) SnapshotReader(std::span<const std::byte> bytes)
+      : bytes_(bytes) {}
+
+  auto empty() const noexcept -> bool { return offset_ == std::size(bytes_); }
+
+  auto remaining() const noexcept -> std::size_t {
+    return std::size(bytes_) - offset_;
+  }
+
+  // reads the number of elements of a sequence, each taking at least
+  // `element_size` bytes, and checks that the data can hold them before
+  // anything is allocated for them.
+  auto read_count(const std::size_t element_size) -> std::size_t {
+    const auto count = read<std::uint64_t>();
+    if (count > remaining() / std::max<std::size_t>(element_size, 1u))
+        [[unlikely]] {
+      throw nova_exception{std::format(
+          "snapshot: corrupt data, {} elements of {} bytes do not fit in the "
+          "{} bytes left at offset {}",
+          count, element_size, remaining(), offset_)};
+    }
+    return static_cast<std::size_t>(count);
+  }
+
+  auto take(const std::size_t n) -> std::span<const std::byte> {
+    if (n > std::size(bytes_) - offset_) [[unlikely]] {
+      throw nova_exception{std::format(
+          "snapshot: unexpected end of data, wanted {} bytes at offset {} of {}",
+          n, offset_, std::size(bytes_))};
+    }
+    const auto taken = bytes_.subspan(offset_, n);
+    offset_ += n;
+    return taken;
+  }
+
+  auto read_bytes(void* const data, const std::size_t n) -> void {
+    if (n != 0u) {
+      std::memcpy(data, std::data(take(n)), n);
+    }
+  }
+
+  template <typename T>
+  requires(std::is_trivially_copyable_v<T>) auto read() -> T {
+    auto value = T{};
+    read_bytes(std::addressof(value), sizeof(T));
+    return value;
+  }
+};
+
+template <typename T>
+struct is_vector : std::false_type {};
+template <typename T, typename TAlloc>
+struct is_vector<std::vector<T, TAlloc>> : std::true_type {};
+
+template <typename T>
+auto write_value(SnapshotWriter& writer, const T& value) -> void;
+template <typename T>
+auto read_value(SnapshotReader& reader, T& value) -> void;
+
+// the fewest bytes a value of type `T` takes in a snapshot.
+template <typename T>
+constexpr auto min_serialized_size() -> std::size_t {
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    return sizeof(T);
+  } else if constexpr (std::is_same_v<T, std::string> or is_vector<T>::value) {
+    return sizeof(std::uint64_t);
+  } else {
+    return 1u;
+  }
+}
+
+template <typename TContainer>
+auto write_sequence(SnapshotWriter& writer, const TContainer& container)
+    -> void {
+  using value_t = typename TContainer::value_type;
+  writer.write(static_cast<std::uint64_t>(std::size(container)));
+  if constexpr (std::is_trivially_copyable_v<value_t>) {
+    writer.write_bytes(std::data(container),
+                       std::size(container) * sizeof(value_t));
+  } else {
+    for (const auto& element : container) {
+      write_value(writer, element);
+    }
+  }
+}
+
+template <typename TContainer>
+auto read_sequence(SnapshotReader& reader, TContainer& container) -> void {
+  using value_t = typename TContainer::value_type;
+  container.resize(reader.read_count(min_serialized_size<value_t>()));
+  if constexpr (std::is_trivially_copyable_v<value_t>) {
+    reader.read_bytes(std::data(container),
+                      std::size(container) * sizeof(value_t));
+  } else {
+    for (auto& element : container) {
+      read_value(reader, element);
+    }
+  }
+}
+
+template <typename T>
+auto write_value(SnapshotWriter& writer, const T& value) -> void {
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    writer.write(value);
+  } else if constexpr (std::is_same_v<T, std::string> or is_vector<T>::value) {
+    write_sequence(writer, value);
+  } else if constexpr (concepts::aggregate<T>) {
+    reflect::for_each(value, [&](const auto& member) {
+      write_value(writer, member);
+    });
+  } else {
+    static_assert(always_false<T>{},
+                  "snapshot: type must be trivially copyable, a std::string, "
+                  "a std::vector or an aggregate of those");
+  }
+}
+
+template <typename T>
+auto read_value(SnapshotReader& reader, T& value) -> void {
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    reader.read_bytes(std::addressof(value), sizeof(T));
+  } else if constexpr (std::is_same_v<T, std::string> or is_vector<T>::value) {
+    read_sequence(reader, value);
+  } else if constexpr (concepts::aggregate<T>) {
+    reflect::for_each(value,
+                      [&](auto& member) { read_value(reader, member); });
+  } else {
+    static_assert(always_false<T>{},
+                  "snapshot: type must be trivially copyable, a std::string, "
+                  "a std::vector or an aggregate of those");
+  }
+}
+
+// The entities of a storage, minus the tombstones left by in-place deletion.
+inline auto packed_entities(const entt::sparse_set& storage)
+    -> std::vector<entt::entity> {
+  auto entities = reserved<std::vector<entt::entity>>(std::size(storage));
+  const auto packed =
+      std::span<const entt::entity>{storage.data(), std::size(storage)};
+  for (const auto entity : packed) {
+    if (entity != entt::tombstone) {
+      entities.push_back(entity);
+    }
+  }
+  return entities;
+}
+
+template <typename T>
+auto save_component(const World& world, SnapshotWriter& writer) -> void {
+  const auto& storage = world.registry().storage<T>();
+  const auto entities = packed_entities(storage);
+  write_sequence(writer, entities);
+
+  if constexpr (std::is_empty_v<T>) {
+    return;
+  } else if constexpr (std::is_trivially_copyable_v<T>) {
+    // the components are copied page by page, skipping tombstones, in the
+    // same (packed) order as the entities.
+    constexpr auto page_size = entt::component_traits<T>::page_size;
+    const auto packed =
+        std::span<const entt::entity>{storage.data(), std::size(storage)};
+    const auto pages = storage.raw();
+    auto* column = writer.grow(std::size(entities) * sizeof(T));
+    for (auto first = std::size_t{0}; first < std::size(packed);) {
+      if (packed[first] == entt::tombstone) {
+        ++first;
+        continue;
+      }
+      const auto page_end =
+          std::min((first / page_size + 1u) * page_size, std::size(packed));
+      auto last = first + 1u;
+      while (last < page_end and packed[last] != entt::tombstone) {
+        ++last;
+      }
+      const auto n_bytes = (last - first) * sizeof(T);
+      std::memcpy(column, pages[first / page_size] + first % page_size,
+                  n_bytes);
+      column += n_bytes;
+      first = last;
+    }
+  } else {
+    for (const auto entity : entities) {
+      write_value(writer, storage.get(entity));
+    }
+  }
+}
+
+// What a snapshot restores, kept aside until all of it was read.
+struct SnapshotStaging {
+  struct Resource {
+    // the restored value, or null if the resource has to be removed.
+    void_ptr value{};
+    auto (*apply)(World&, void_ptr&) -> void;
+  };
+
+  Registry registry{};
+  std::vector<Resource> resources{};
+};
+
+template <typename T>
+auto load_component(SnapshotStaging& staging, SnapshotReader& reader)
+    -> void {
+  auto entities = std::vector<entt::entity>{};
+  read_sequence(reader, entities);
+
+  auto& registry = staging.registry;
+  registry.storage<T>().reserve(std::size(entities));
+
+  if constexpr (std::is_empty_v<T>) {
+    registry.insert<T>(std::begin(entities), std::end(entities));
+  } else {
+    if (std::size(entities) >
+        reader.remaining() / min_serialized_size<T>()) [[unlikely]] {
+      throw nova_exception{std::format(
+          "snapshot: corrupt data, {} components do not fit in the {} bytes "
+          "left",
+          std::size(entities), reader.remaining())};
+    }
+    auto values = std::vector<T>(std::size(entities));
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      reader.read_bytes(std::data(values), std::size(values) * sizeof(T));
+    } else {
+      for (auto& value : values) {
+        read_value(reader, value);
+      }
+    }
+    registry.insert<T>(std::begin(entities), std::end(entities),
+                       std::begin(values));
+  }
+}
+
+template <typename T>
+auto save_resource(const World& world, SnapshotWriter& writer) -> void {
+  const auto resource = world.resources().get<T>();
+  writer.write(static_cast<std::uint8_t>(resource.has_value()));
+  if (resource.has_value()) {
+    write_value(writer, **resource);
+  }
+}
+
+template <typename T>
+auto apply_resource(World& world, void_ptr& value) -> void {
+  if (value.data() != nullptr) {
+    world.resources().set<T>(MOV(*static_cast<T*>(value.data())));
+  } else {
+    world.resources().remove<T>();
+  }
+}
+
+template <typename T>
+auto load_resource(SnapshotStaging& staging, SnapshotReader& reader)
+    -> void {
+  auto& staged = staging.resources.emplace_back(
+      SnapshotStaging::Resource{.apply = apply_resource<T>});
+  if (reader.read<std::uint8_t>() != 0u) {
+    staged.value = void_ptr::create<T>();
+    read_value(reader, *static_cast<T*>(staged.value.data()));
+  }
+}
+
+}  // namespace detail
+
+/// @brief Saves and restores the state of a `World` to a compact binary
+/// format.
+///
+/// Only the registered components and resources are part of the snapshot.
+/// Trivially copyable types are written as raw blocks, aggregates are written
+/// member by member through reflection, `std::string` and `std::vector` are
+/// supported as members.
+/// Restored types must be default constructible.
+///
+/// ```cpp
+/// const auto snapshot = nova::Snapshot{}
+///                           .component<position>()
+///                           .component<velocity>()
+///                           .resource<Score>();
+/// const auto bytes = snapshot.save(world);
+/// snapshot.load(world, bytes);
+/// ```
+class Snapshot {
+  struct Section {
+    TypeId id;
+    auto (*save)(const World&, detail::SnapshotWriter&) -> void;
+    auto (*load)(detail::SnapshotStaging&, detail::SnapshotReader&) -> void;
+  };
+
+  std::vector<Section> components_{};
+  std::vector<Section> resources_{};
+
+  static auto write_sections(const World& world, detail::SnapshotWriter& writer,
+                             const std::vector<Section>& sections) -> void {
+    writer.write(static_cast<std::uint32_t>(std::size(sections)));
+    for (const auto& section : sections) {
+      writer.write(section.id.id());
+      const auto length_offset = writer.size();
+      writer.write(std::uint64_t{0});
+      section.save(world, writer);
+      writer.write_at(length_offset, static_cast<std::uint64_t>(
+                                         writer.size() - length_offset -
+                                         sizeof(std::uint64_t)));
+    }
+  }
+
+  static auto read_sections(detail::SnapshotStaging& staging,
+                            detail::SnapshotReader& reader,
+                            const std::vector<Section>& sections) -> void {
+    const auto n_sections = reader.read<std::uint32_t>();
+    for (auto i = std::uint32_t{0}; i < n_sections; ++i) {
+      const auto id = reader.read<id_type>();
+      const auto length = reader.read<std::uint64_t>();
+      auto payload = detail::SnapshotReader{
+          reader.take(static_cast<std::size_t>(length))};
+
+      // sections that are not registered are skipped.
+      if (const auto section = std::ranges::find(
+              sections, id,
+              [](const auto& section) { return section.id.id(); });
+          section != std::end(sections)) {
+        section->load(staging, payload);
+      }
+    }
+  }
+
+ public:
+  template <typename T>
+  auto component() & -> Snapshot& {
+    static_assert(std::is_same_v<T, std::remove_cvref_t<T>>);
+    components_.push_back(Section{
+        .id = type_id<T>(),
+        .save = detail::save_component<T>,
+        .load = detail::load_component<T>,
+    });
+    return *this;
+  }
+
+  template <typename T>
+  auto component() && -> Snapshot&& {
+    return MOV(component<T>());
+  }
+
+  template <typename T>
+  auto resource() & -> Snapshot& {
+    static_assert(std::is_same_v<T, std::remove_cvref_t<T>>);
+    resources_.push_back(Section{
+        .id = type_id<T>(),
+        .save = detail::save_resource<T>,
+        .load = detail::load_resource<T>,
+    });
+    return *this;
+  }
+
+  template <typename T>
+  auto resource() && -> Snapshot&& {
+    return MOV(resource<T>());
+  }
+
+  /// @brief Appends the snapshot of `world` to `out`.
+  auto save(const World& world, std::vector<std::byte>& out) const -> void {
+    auto writer = detail::SnapshotWriter{out};
+    writer.write(detail::SNAPSHOT_MAGIC);
+    writer.write(detail::SNAPSHOT_VERSION);
+
+    const auto& registry = world.registry();
+    writer.write(static_cast<std::uint64_t>(registry.size()));
+    writer.write_bytes(registry.data(), registry.size() * sizeof(entt::entity));
+    writer.write(registry.released());
+
+    write_sections(world, writer, components_);
+    write_sections(world, writer, resources_);
+  }
+
+  [[nodiscard]] auto save(const World& world) const -> std::vector<std::byte> {
+    auto out = std::vector<std::byte>{};
+    save(world, out);
+    return out;
+  }
+
+  /// @brief Restores a snapshot created by `save`.
+  /// The registry of `world` is replaced entirely, entity identifiers (and
+  /// their versions) are kept. Registered resources are overwritten, or
+  /// removed if they did not exist when the snapshot was taken.
+  /// The whole snapshot is read before `world` is touched: if the data is
+  /// truncated or corrupt, this throws and `world` is left as it was.
+  auto load(World& world, std::span<const std::byte> bytes) const -> void {
+    auto reader = detail::SnapshotReader{bytes};
+    if (reader.read<std::uint32_t>() != detail::SNAPSHOT_MAGIC) {
+      throw nova_exception{"snapshot: data is not a nova snapshot"};
+    }
+    if (const auto version = reader.read<std::uint32_t>();
+        version != detail::SNAPSHOT_VERSION) {
+      throw nova_exception{std::format(
+          "snapshot: unsupported version {}, expected {}", version,
+          detail::SNAPSHOT_VERSION)};
+    }
+
+    auto entities = std::vector<entt::entity>(
+        reader.read_count(sizeof(entt::entity)));
+    reader.read_bytes(std::data(entities),
+                      std::size(entities) * sizeof(entt::entity));
+    const auto released = reader.read<entt::entity>();
+
+    auto staging = detail::SnapshotStaging{};
+    staging.registry.assign(std::begin(entities), std::end(entities),
+                            released);
+    read_sections(staging, reader, components_);
+    read_sections(staging, reader, resources_);
+
+    world.registry() = MOV(staging.registry);
+    for (auto& resource : staging.resources) {
+      resource.apply(world, resource.value);
+    }
+  }
+};
+
+}  // namespace nova
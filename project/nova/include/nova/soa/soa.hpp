@@ -0,0 +1,55 @@
+#pragma once
+
+#include <nova/resource/resource.hpp>
+#include <nova/system/system.hpp>
+#include <nova/util/common.hpp>
+#include <type_traits>
+
+#include "soa_storage.hpp"
+
+namespace nova {
+
+/// @brief System parameter giving access to the `SoaStorage` of `T`.
+/// `Soa<const T>` only reads the storage.
+///
+/// Access is declared on the component `T` itself, so a `Soa<T>` conflicts
+/// with a mutable `View` over `T` like any other component access.
+template <typename T>
+struct Soa : detail::ResourceBase<
+                 std::conditional_t<std::is_const_v<T>,
+                                    const SoaStorage<std::remove_const_t<T>>,
+                                    SoaStorage<std::remove_const_t<T>>>> {
+  using detail::ResourceBase<
+      std::conditional_t<std::is_const_v<T>,
+                         const SoaStorage<std::remove_const_t<T>>,
+                         SoaStorage<std::remove_const_t<T>>>>::ResourceBase;
+};
+
+template <typename T>
+struct system_param<Soa<T>> {
+  using storage_t = SoaStorage<std::remove_const_t<T>>;
+
+  static auto param(SystemMeta const&, World& world) -> Soa<T> {
+    if (auto storage = world.resources().get<storage_t>();
+        not storage.has_value()) [[unlikely]] {
+      throw missing_resource<storage_t>{};
+    } else {
+      return Soa<T>{**storage};
+    }
+  }
+
+  static constexpr auto access() -> Access {
+    constexpr auto access = type_id<component_param<std::remove_const_t<T>>>();
+    if constexpr (std::is_const_v<T>) {
+      return Access{
+          .read_only = std::vector<TypeId>{access},
+      };
+    } else {
+      return Access{
+          .read_write = std::vector<TypeId>{access},
+      };
+    }
+  }
+};
+
+}  // namespace nova
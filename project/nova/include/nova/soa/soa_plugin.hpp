@@ -0,0 +1,18 @@
+#pragma once
+
+#include <nova/app/app.hpp>
+
+#include "soa.hpp"
+
+namespace nova {
+
+/// @brief Inserts an empty `SoaStorage` for each of `TComponents`, which can
+/// then be used through the `Soa<T>` system parameter.
+template <concepts::soa_component... TComponents>
+struct SoaPlugin {
+  auto operator()(App& app) -> void {
+    (app.insert_resource<SoaStorage<TComponents>>(), ...);
+  }
+};
+
+}  // namespace nova
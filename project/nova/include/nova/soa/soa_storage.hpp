@@ -0,0 +1,286 @@
+#pragma once
+
+#include <entt/entt.hpp>
+#include <format>
+#include <limits>
+#include <nova/util/aligned_allocator.hpp>
+#include <nova/util/common.hpp>
+#include <nova/util/meta.hpp>
+#include <nova/util/reflection.hpp>
+#include <nova/util/type.hpp>
+#include <ranges>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace nova {
+
+namespace concepts {
+template <typename T>
+concept soa_component = aggregate<T> and not std::is_empty_v<T> and
+    std::is_same_v<T, std::remove_cvref_t<T>>;
+}
+
+namespace detail {
+
+template <typename TFields>
+struct soa_traits;
+
+template <typename... TFields>
+struct soa_traits<type_list<TFields...>> {
+  using columns_t =
+      std::tuple<std::vector<TFields, aligned_allocator<TFields>>...>;
+  using reference_t = std::tuple<TFields&...>;
+  using const_reference_t = std::tuple<const TFields&...>;
+};
+
+}  // namespace detail
+
+/// @brief A struct-of-arrays storage for a reflectable aggregate component.
+/// Every member of `T` is stored in its own cache line aligned array, all of
+/// them kept in the same order as `entities()`, so a loop over `field<I>()`
+/// spans vectorizes without gathering.
+///
+/// Elements are accessed through proxies, tuples of references to the fields
+/// of an entity, which can be destructured:
+/// ```cpp
+/// for (auto [entity, dx, dy] : velocities.each()) { ... }
+/// ```
+///
+/// The storage is not owned by the registry: entities destroyed through the
+/// registry must be removed explicitly, or pruned with `prune()`. An entity
+/// destroyed and not pruned yet is evicted when its recycled identifier (a
+/// newer version of it) is emplaced.
+template <concepts::soa_component T>
+class SoaStorage {
+  using fields_t = reflect::member_type_list<T>;
+  using traits_t = detail::soa_traits<fields_t>;
+
+  static constexpr auto n_fields = reflect::member_count<T>;
+  static constexpr auto npos = std::numeric_limits<std::size_t>::max();
+
+  std::vector<entt::entity> dense_{};
+  // indexed by the entity's identifier, without its version.
+  std::vector<std::size_t> sparse_{};
+  typename traits_t::columns_t columns_{};
+
+  [[nodiscard]] static constexpr auto slot(const entt::entity e) noexcept
+      -> std::size_t {
+    return static_cast<std::size_t>(entt::to_entity(e));
+  }
+
+  template <typename TFunc>
+  auto for_each_column(TFunc&& func) -> void {
+    std::apply([&](auto&... columns) { (func(columns), ...); }, columns_);
+  }
+
+  auto swap_at(const std::size_t lhs, const std::size_t rhs) -> void {
+    if (lhs == rhs) {
+      return;
+    }
+    std::swap(sparse_[slot(dense_[lhs])], sparse_[slot(dense_[rhs])]);
+    std::swap(dense_[lhs], dense_[rhs]);
+    for_each_column(
+        [lhs, rhs](auto& column) { std::swap(column[lhs], column[rhs]); });
+  }
+
+  // removes the element at `position`, moving the last element into its place.
+  auto erase_at(const std::size_t position) -> void {
+    const auto e = dense_[position];
+    swap_at(position, size() - 1u);
+    sparse_[slot(e)] = npos;
+    dense_.pop_back();
+    for_each_column([](auto& column) { column.pop_back(); });
+  }
+
+  auto push(const entt::entity e, const T& value) -> void {
+    if (slot(e) >= std::size(sparse_)) {
+      sparse_.resize(slot(e) + 1u, npos);
+    }
+    sparse_[slot(e)] = std::size(dense_);
+    dense_.push_back(e);
+
+    [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      const auto members = reflect::get_member_references(value);
+      (std::get<Is>(columns_).push_back(std::get<Is>(members)), ...);
+    }
+    (std::make_index_sequence<n_fields>{});
+  }
+
+ public:
+  using value_type = T;
+  using reference = typename traits_t::reference_t;
+  using const_reference = typename traits_t::const_reference_t;
+
+  template <std::size_t I>
+  using field_t = std::remove_reference_t<std::tuple_element_t<
+      I, decltype(reflect::get_member_references(std::declval<T&>()))>>;
+
+  [[nodiscard]] auto size() const noexcept -> std::size_t {
+    return std::size(dense_);
+  }
+
+  [[nodiscard]] auto empty() const noexcept -> bool {
+    return std::empty(dense_);
+  }
+
+  [[nodiscard]] auto contains(const entt::entity e) const noexcept -> bool {
+    return slot(e) < std::size(sparse_) and sparse_[slot(e)] != npos and
+           dense_[sparse_[slot(e)]] == e;
+  }
+
+  /// @brief The position of `e` in `entities()` and in every field.
+  [[nodiscard]] auto index(const entt::entity e) const -> std::size_t {
+    if (not contains(e)) [[unlikely]] {
+      throw nova_exception{
+          std::format("SoaStorage<{}>: entity {} has no such component",
+                      type_name<T>(), entt::to_integral(e))};
+    }
+    return sparse_[slot(e)];
+  }
+
+  auto reserve(const std::size_t n) -> void {
+    dense_.reserve(n);
+    for_each_column([n](auto& column) { column.reserve(n); });
+  }
+
+  auto emplace(const entt::entity e, const T& value = {}) -> reference {
+    if (contains(e)) [[unlikely]] {
+      throw nova_exception{
+          std::format("SoaStorage<{}>: entity {} already has the component",
+                      type_name<T>(), entt::to_integral(e))};
+    }
+    if (slot(e) < std::size(sparse_) and sparse_[slot(e)] != npos)
+        [[unlikely]] {
+      // the registry recycled the identifier of an entity that was destroyed
+      // without being removed from the storage.
+      erase_at(sparse_[slot(e)]);
+    }
+    push(e, value);
+    return get(e);
+  }
+
+  /// @brief Assigns `value` to every entity in `[first, last)`.
+  template <std::input_iterator TIt>
+  auto insert(TIt first, const TIt last, const T& value = {}) -> void {
+    if constexpr (std::forward_iterator<TIt>) {
+      reserve(size() + static_cast<std::size_t>(std::distance(first, last)));
+    }
+    for (; first != last; ++first) {
+      emplace(*first, value);
+    }
+  }
+
+  /// @brief Removes `e`, moving the last element into its place.
+  auto erase(const entt::entity e) -> void { erase_at(index(e)); }
+
+  /// @brief Removes `e` if it is in the storage.
+  /// @return Whether `e` was removed.
+  auto remove(const entt::entity e) -> bool {
+    if (not contains(e)) {
+      return false;
+    }
+    erase(e);
+    return true;
+  }
+
+  /// @brief Removes every entity that is no longer valid in `registry`.
+  /// @return The number of removed entities.
+  auto prune(const entt::registry& registry) -> std::size_t {
+    auto removed = std::size_t{0};
+    for (auto position = size(); position-- > 0u;) {
+      if (not registry.valid(dense_[position])) {
+        erase_at(position);
+        ++removed;
+      }
+    }
+    return removed;
+  }
+
+  auto clear() -> void {
+    dense_.clear();
+    sparse_.clear();
+    for_each_column([](auto& column) { column.clear(); });
+  }
+
+  [[nodiscard]] auto get(const entt::entity e) -> reference {
+    return at(index(e));
+  }
+
+  [[nodiscard]] auto get(const entt::entity e) const -> const_reference {
+    return at(index(e));
+  }
+
+  /// @brief The proxy of the element at `position`.
+  [[nodiscard]] auto at(const std::size_t position) -> reference {
+    return std::apply(
+        [position](auto&... columns) {
+          return reference{columns[position]...};
+        },
+        columns_);
+  }
+
+  [[nodiscard]] auto at(const std::size_t position) const -> const_reference {
+    return std::apply(
+        [position](const auto&... columns) {
+          return const_reference{columns[position]...};
+        },
+        columns_);
+  }
+
+  /// @brief A copy of the component of `e`.
+  [[nodiscard]] auto load(const entt::entity e) const -> T {
+    return std::apply([](const auto&... fields) { return T{fields...}; },
+                      get(e));
+  }
+
+  /// @brief The entities in the storage, in the same order as the fields.
+  [[nodiscard]] auto entities() const noexcept
+      -> std::span<const entt::entity> {
+    return dense_;
+  }
+
+  /// @brief The contiguous array of the `I`th member of `T`.
+  template <std::size_t I>
+  [[nodiscard]] auto field() noexcept -> std::span<field_t<I>> {
+    return std::get<I>(columns_);
+  }
+
+  template <std::size_t I>
+  [[nodiscard]] auto field() const noexcept -> std::span<const field_t<I>> {
+    return std::get<I>(columns_);
+  }
+
+  /// @brief Iterates over the storage, yielding `(entity, fields&...)`.
+  [[nodiscard]] auto each() {
+    return std::views::iota(std::size_t{0}, size()) |
+           std::views::transform([this](const std::size_t position) {
+             return std::tuple_cat(std::tuple{dense_[position]},
+                                   at(position));
+           });
+  }
+
+  [[nodiscard]] auto each() const {
+    return std::views::iota(std::size_t{0}, size()) |
+           std::views::transform([this](const std::size_t position) {
+             return std::tuple_cat(std::tuple{dense_[position]},
+                                   at(position));
+           });
+  }
+
+  /// @brief Reorders the storage so that the entities of `order` it contains
+  /// come first, in the same order. Sorting two storages against the same
+  /// entities lines up their fields, so they can be iterated with one index.
+  auto respect(std::span<const entt::entity> order) -> void {
+    auto position = std::size_t{0};
+    for (const auto e : order) {
+      if (contains(e)) {
+        swap_at(sparse_[slot(e)], position++);
+      }
+    }
+  }
+};
+
+}  // namespace nova
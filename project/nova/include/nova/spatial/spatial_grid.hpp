@@ -0,0 +1,243 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <entt/entt.hpp>
+#include <format>
+#include <nova/kinematics/kinematics.hpp>
+#include <nova/task/task_pool.hpp>
+#include <nova/util/common.hpp>
+#include <span>
+#include <vector>
+
+namespace nova {
+
+/// @brief A uniform grid over the `Position` of entities, for proximity
+/// queries.
+///
+/// Cells are hashed into as many buckets as there are entities, and the
+/// entities are stored contiguously bucket by bucket, so the grid is unbounded
+/// and its memory only depends on the number of entities. It is rebuilt from
+/// scratch every frame with a (parallel) counting sort.
+class SpatialGrid {
+ public:
+  struct Entry {
+    entt::entity entity{entt::null};
+    float x{};
+    float y{};
+  };
+
+ private:
+  // Above this many entities, `rebuild` splits the work across the task pool.
+  static constexpr std::size_t PARALLEL_THRESHOLD = 16'384u;
+  static constexpr std::size_t BLOCK_SIZE = 8'192u;
+
+  float cell_size_;
+  float inverse_cell_size_;
+  std::uint32_t bucket_mask_ = 0u;
+  // `offsets_[b]` is the first entry of bucket `b`, `offsets_[b + 1]` its end.
+  std::vector<std::uint32_t> offsets_{0u};
+  std::vector<Entry> entries_{};
+  // scratch buffers, kept to avoid reallocating every frame.
+  std::vector<Entry> staging_{};
+  std::vector<std::uint32_t> buckets_{};
+
+  [[nodiscard]] auto cell_of(const float coordinate) const noexcept
+      -> std::int32_t {
+    return static_cast<std::int32_t>(
+        std::floor(coordinate * inverse_cell_size_));
+  }
+
+  [[nodiscard]] auto bucket_of(const std::int32_t cx,
+                               const std::int32_t cy) const noexcept
+      -> std::uint32_t {
+    const auto hash = (static_cast<std::uint32_t>(cx) * 73'856'093u) ^
+                      (static_cast<std::uint32_t>(cy) * 19'349'663u);
+    return hash & bucket_mask_;
+  }
+
+  template <typename TFunc>
+  static auto for_each_block(TaskPool* const pool, const std::size_t n,
+                             TFunc&& func) -> void {
+    const auto n_blocks = (n + BLOCK_SIZE - 1u) / BLOCK_SIZE;
+    const auto run_block = [&](const std::size_t block) {
+      const auto first = block * BLOCK_SIZE;
+      func(first, std::min(n, first + BLOCK_SIZE));
+    };
+    if (pool != nullptr and n >= PARALLEL_THRESHOLD) {
+      pool->parallel_for(n_blocks, run_block);
+    } else {
+      for (auto block = std::size_t{0}; block < n_blocks; ++block) {
+        run_block(block);
+      }
+    }
+  }
+
+  template <typename TFunc>
+  auto visit_bucket(const std::uint32_t bucket, TFunc&& func) const -> void {
+    const auto first = std::begin(entries_) + offsets_[bucket];
+    const auto last = std::begin(entries_) + offsets_[bucket + 1u];
+    std::for_each(first, last, func);
+  }
+
+ public:
+  explicit(true) SpatialGrid(const float cell_size = 32.f)
+      : cell_size_(cell_size), inverse_cell_size_(1.f / cell_size) {
+    if (not(cell_size > 0.f)) [[unlikely]] {
+      throw nova_exception{
+          std::format("SpatialGrid: invalid cell size {}", cell_size)};
+    }
+  }
+
+  [[nodiscard]] auto cell_size() const noexcept -> float { return cell_size_; }
+
+  [[nodiscard]] auto size() const noexcept -> std::size_t {
+    return std::size(entries_);
+  }
+
+  /// @brief Every entity in the grid, grouped by bucket.
+  [[nodiscard]] auto entries() const noexcept -> std::span<const Entry> {
+    return entries_;
+  }
+
+  /// @brief Rebuilds the grid from the `Position` of every entity in `view`.
+  /// With a task pool, large grids are hashed and sorted in parallel.
+  template <typename TView>
+  auto rebuild(const TView& view, TaskPool* const pool = nullptr) -> void {
+    staging_.clear();
+    for (const auto& chunk : view.chunks()) {
+      const auto positions = chunk.template get<const Position>();
+      for (auto i = std::size_t{0}; i < chunk.size(); ++i) {
+        staging_.push_back(Entry{
+            .entity = chunk.entities[i],
+            .x = positions[i].x,
+            .y = positions[i].y,
+        });
+      }
+    }
+    rebuild(std::span<const Entry>{staging_}, pool);
+  }
+
+  /// @brief Rebuilds the grid from `input`.
+  auto rebuild(std::span<const Entry> input, TaskPool* const pool = nullptr)
+      -> void {
+    const auto n = std::size(input);
+    const auto n_buckets = std::bit_ceil(std::max<std::size_t>(n, 1u));
+    bucket_mask_ = static_cast<std::uint32_t>(n_buckets - 1u);
+
+    buckets_.resize(n);
+    offsets_.assign(n_buckets + 1u, 0u);
+    entries_.resize(n);
+
+    // 1. hash every entity to its bucket and count the bucket sizes.
+    for_each_block(pool, n, [&](const std::size_t first, const auto last) {
+      for (auto i = first; i < last; ++i) {
+        const auto bucket = bucket_of(cell_of(input[i].x), cell_of(input[i].y));
+        buckets_[i] = bucket;
+        std::atomic_ref{offsets_[bucket + 1u]}.fetch_add(
+            1u, std::memory_order_relaxed);
+      }
+    });
+
+    // 2. turn the sizes into offsets.
+    for (auto bucket = std::size_t{1}; bucket <= n_buckets; ++bucket) {
+      offsets_[bucket] += offsets_[bucket - 1u];
+    }
+
+    // 3. scatter the entities, using the start of each bucket as a cursor
+    // which ends up at the start of the next bucket.
+    for_each_block(pool, n, [&](const std::size_t first, const auto last) {
+      for (auto i = first; i < last; ++i) {
+        const auto slot = std::atomic_ref{offsets_[buckets_[i]]}.fetch_add(
+            1u, std::memory_order_relaxed);
+        entries_[slot] = input[i];
+      }
+    });
+
+    // 4. shift the cursors back to the start of their bucket.
+    std::shift_right(std::begin(offsets_), std::end(offsets_), 1);
+    offsets_.front() = 0u;
+  }
+
+  /// @brief Calls `func(entry)` for every entity inside the axis aligned box.
+  /// Does not allocate.
+  template <typename TFunc>
+  auto for_each_in_aabb(const float min_x, const float min_y,
+                        const float max_x, const float max_y,
+                        TFunc&& func) const -> void {
+    const auto inside = [&](const Entry& entry) {
+      if (entry.x >= min_x and entry.x <= max_x and entry.y >= min_y and
+          entry.y <= max_y) {
+        func(entry);
+      }
+    };
+
+    const auto cx0 = cell_of(min_x);
+    const auto cy0 = cell_of(min_y);
+    const auto cx1 = cell_of(max_x);
+    const auto cy1 = cell_of(max_y);
+    const auto n_cells =
+        static_cast<std::uint64_t>(std::int64_t{cx1} - cx0 + 1) *
+        static_cast<std::uint64_t>(std::int64_t{cy1} - cy0 + 1);
+
+    // a box covering more cells than there are buckets visits every bucket.
+    if (n_cells >= std::size(offsets_) - 1u) {
+      std::for_each(std::begin(entries_), std::end(entries_), inside);
+      return;
+    }
+
+    // distinct cells may share a bucket, so only the entries of the cell
+    // being visited are taken from its bucket: every entry is found once,
+    // without keeping track of the buckets already visited.
+    for (auto cy = cy0; cy <= cy1; ++cy) {
+      for (auto cx = cx0; cx <= cx1; ++cx) {
+        visit_bucket(bucket_of(cx, cy), [&](const Entry& entry) {
+          if (cell_of(entry.x) == cx and cell_of(entry.y) == cy) {
+            inside(entry);
+          }
+        });
+      }
+    }
+  }
+
+  /// @brief Calls `func(entry)` for every entity within `radius` of
+  /// `(x, y)`.
+  template <typename TFunc>
+  auto for_each_in_radius(const float x, const float y, const float radius,
+                          TFunc&& func) const -> void {
+    const auto radius_sq = radius * radius;
+    for_each_in_aabb(x - radius, y - radius, x + radius, y + radius,
+                     [&](const Entry& entry) {
+                       const auto dx = entry.x - x;
+                       const auto dy = entry.y - y;
+                       if (dx * dx + dy * dy <= radius_sq) {
+                         func(entry);
+                       }
+                     });
+  }
+
+  [[nodiscard]] auto query_aabb(const float min_x, const float min_y,
+                                const float max_x, const float max_y) const
+      -> std::vector<entt::entity> {
+    auto result = std::vector<entt::entity>{};
+    for_each_in_aabb(min_x, min_y, max_x, max_y, [&](const Entry& entry) {
+      result.push_back(entry.entity);
+    });
+    return result;
+  }
+
+  [[nodiscard]] auto query_radius(const float x, const float y,
+                                  const float radius) const
+      -> std::vector<entt::entity> {
+    auto result = std::vector<entt::entity>{};
+    for_each_in_radius(x, y, radius, [&](const Entry& entry) {
+      result.push_back(entry.entity);
+    });
+    return result;
+  }
+};
+
+}  // namespace nova
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <nova/app/app.hpp>
+#include <nova/app/core_stages.hpp>
+#include <nova/system/system.hpp>
+#include <nova/system/system_builder.hpp>
+
+#include "spatial_grid.hpp"
+
+namespace nova {
+
+struct SpatialGridSystem {};
+
+/// @brief Rebuilds the `SpatialGrid` from the current positions, in parallel
+/// when a `TaskPool` resource is available.
+inline auto update_spatial_grid(Resource<SpatialGrid> grid,
+                                Optional<Resource<TaskPool>> pool,
+                                View<With<const Position>> view) -> void {
+  grid->rebuild(view, pool.map([](auto p) { return &*p; }).value_or(nullptr));
+}
+
+/// @brief Maintains a `SpatialGrid` resource over every entity with a
+/// `Position`, rebuilt before the update stage. Systems query it through
+/// `Resource<const SpatialGrid>`.
+///
+/// The cell size can be chosen by inserting a `SpatialGrid` before adding the
+/// plugin; it should be about the typical query radius.
+struct SpatialGridPlugin {
+  auto operator()(App& app) -> void {
+    app.world.resources().try_add<SpatialGrid>();
+    app.add_system_to_stage<stages::PreUpdate>(
+        system(update_spatial_grid).label<SpatialGridSystem>());
+  }
+};
+
+}  // namespace nova
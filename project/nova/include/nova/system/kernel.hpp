@@ -0,0 +1,182 @@
+#pragma once
+
+#include <entt/entt.hpp>
+#include <functional>
+#include <nova/util/common.hpp>
+#include <nova/util/meta.hpp>
+#include <span>
+#include <tl/optional.hpp>
+#include <type_traits>
+
+#include "system.hpp"
+
+namespace nova {
+
+namespace detail {
+
+template <typename TArgs>
+struct kernel_view;
+
+template <typename... TComponents>
+struct kernel_view<args<TComponents...>> {
+  static_assert((std::is_lvalue_reference_v<TComponents> and ...),
+                "kernel arguments must be component references, e.g. "
+                "`velocity&` or `const acceleration&`");
+  static_assert(
+      (not std::is_empty_v<std::remove_cvref_t<TComponents>> and ...),
+      "kernel arguments cannot be empty (tag) components");
+
+  using type = View<With<std::remove_reference_t<TComponents>...>>;
+};
+
+// The per-entity callable returned by a kernel system.
+template <typename TSystem>
+using kernel_t = typename function_traits<TSystem>::result_t;
+
+template <typename TSystem>
+using kernel_view_t = typename kernel_view<args_t<kernel_t<TSystem>>>::type;
+
+template <typename TSystem>
+struct KernelSystemData {
+  SystemData<TSystem> system_data;
+  tl::optional<kernel_t<TSystem>> kernel{};
+  tl::optional<kernel_view_t<TSystem>> view{};
+};
+
+template <typename TKernel, typename TView, typename... TComponents>
+constexpr auto invoke_kernel(TKernel& kernel, TView& view,
+                             const entt::entity entity, args<TComponents...>)
+    -> void {
+  std::invoke(kernel, view.template get<std::remove_reference_t<TComponents>>(
+                          entity)...);
+}
+
+template <typename TSystem>
+auto type_erased_prepare_kernel_func(SystemMeta const& meta, void* const data,
+                                     void* const world_ptr) -> void {
+  auto& kernel_data = *static_cast<KernelSystemData<TSystem>*>(data);
+  auto& world = *static_cast<World*>(world_ptr);
+
+  kernel_data.kernel.reset();
+  kernel_data.kernel.emplace(invoke_system_impl<TSystem>(
+      meta, kernel_data.system_data, world, args_t<TSystem>{}));
+  kernel_data.view.emplace(
+      system_param<kernel_view_t<TSystem>>::param(meta, world));
+}
+
+template <typename TSystem>
+auto type_erased_finish_kernel_func(SystemMeta const&, void* const data,
+                                    void* const) -> void {
+  auto& kernel_data = *static_cast<KernelSystemData<TSystem>*>(data);
+  kernel_data.kernel.reset();
+  kernel_data.view.reset();
+}
+
+template <typename TSystem>
+auto type_erased_kernel_block_func(void* const data, void* const,
+                                   std::span<const entt::entity> entities)
+    -> void {
+  auto& kernel_data = *static_cast<KernelSystemData<TSystem>*>(data);
+  DEBUG_ASSERT(kernel_data.kernel.has_value(),
+               "kernel `{}` was not prepared before running a block",
+               type_name<TSystem>());
+
+  auto& kernel = *kernel_data.kernel;
+  auto& view = *kernel_data.view;
+  for (const auto entity : entities) {
+    if (view.contains(entity)) {
+      invoke_kernel(kernel, view, entity, args_t<kernel_t<TSystem>>{});
+    }
+  }
+}
+
+template <typename TSystem>
+auto type_erased_run_kernel_func(SystemMeta const& meta, void* const data,
+                                 void* const world_ptr) -> void {
+  type_erased_prepare_kernel_func<TSystem>(meta, data, world_ptr);
+
+  auto& kernel_data = *static_cast<KernelSystemData<TSystem>*>(data);
+  auto& kernel = *kernel_data.kernel;
+  auto& view = *kernel_data.view;
+  for (const auto entity : view) {
+    invoke_kernel(kernel, view, entity, args_t<kernel_t<TSystem>>{});
+  }
+
+  type_erased_finish_kernel_func<TSystem>(meta, data, world_ptr);
+}
+
+template <typename TSystem>
+auto type_erased_initialize_kernel_func(SystemMeta const& meta,
+                                        void* const data,
+                                        void* const world_ptr) -> void {
+  auto& kernel_data = *static_cast<KernelSystemData<TSystem>*>(data);
+  auto& world = *static_cast<World*>(world_ptr);
+  initialize_system_impl<TSystem>(meta, kernel_data.system_data, world,
+                                  args_t<TSystem>{});
+}
+
+template <typename TSystem>
+auto type_erased_assure_kernel_func(void* const world_ptr) -> void {
+  type_erased_assure_func<TSystem>(world_ptr);
+  system_param<kernel_view_t<TSystem>>::assure_pools(
+      *static_cast<World*>(world_ptr));
+}
+
+template <typename TComponent>
+auto kernel_component() -> SystemKernel::Component {
+  using component_t = std::remove_cvref_t<TComponent>;
+  return SystemKernel::Component{
+      .id = type_id<component_param<component_t>>(),
+      .storage = [](void* const world_ptr) -> const entt::sparse_set& {
+        auto& world = *static_cast<World*>(world_ptr);
+        return world.registry().storage<component_t>();
+      },
+  };
+}
+
+template <typename TSystem>
+auto create_kernel_system(TSystem&& system) -> System {
+  using system_t = std::remove_cvref_t<TSystem>;
+  using kernel_data_t = KernelSystemData<system_t>;
+
+  static_assert(not std::is_void_v<kernel_t<system_t>>,
+                "Kernel systems must return a per-entity callable");
+
+  auto components = [&]<typename... TComponents>(args<TComponents...>) {
+    return std::vector<SystemKernel::Component>{
+        kernel_component<TComponents>()...};
+  }(args_t<kernel_t<system_t>>{});
+
+  return System{
+      .run_func = type_erased_run_kernel_func<system_t>,
+      .initialize_func = type_erased_initialize_kernel_func<system_t>,
+      .data = void_ptr::create<kernel_data_t>(SystemData<system_t>{
+          .state = tl::nullopt,
+          .system = function_wrapper<system_t>{std::in_place, FWD(system)},
+      }),
+      .meta =
+          SystemMeta{
+              .id = type_id<system_t>(),
+          },
+      .kernel =
+          SystemKernel{
+              .prepare_func = type_erased_prepare_kernel_func<system_t>,
+              .block_func = type_erased_kernel_block_func<system_t>,
+              .finish_func = type_erased_finish_kernel_func<system_t>,
+              .components = MOV(components),
+          },
+      .assure_func = type_erased_assure_kernel_func<system_t>,
+  };
+}
+
+template <typename TSystem>
+constexpr auto get_kernel_access() -> Access {
+  using system_t = std::remove_cvref_t<TSystem>;
+  auto access = get_system_access<system_t>();
+  access.merge(system_param<kernel_view_t<system_t>>::access());
+  return access;
+}
+
+}  // namespace detail
+
+}  // namespace nova
@@ -9,10 +9,13 @@
 #include <nova/label/label.hpp>
 #include <nova/resource/resource.hpp>
 #include <nova/util/common.hpp>
+#include <nova/util/memory_usage.hpp>
 #include <nova/util/meta.hpp>
 #include <nova/util/type.hpp>
 #include <nova/world.hpp>
 #include <ranges>
+#include <thread>
+#include <tuple>
 
 #include "system_data.hpp"
 #include "view.hpp"
@@ -25,6 +28,9 @@ struct component_param {};
 template <typename TResource>
 struct resource_param {};
 
+template <typename TResource>
+struct non_send_param {};
+
 template <typename T>
 struct system_param_fetch;
 
@@ -119,6 +125,55 @@ struct system_param<Optional<Resource<T>>> {
   }
 };
 
+template <typename T>
+struct system_param<NonSend<T>> {
+  static auto param(SystemMeta const& meta, World& world) -> NonSend<T> {
+    if (auto resource = world.resources().get_non_send<T>();
+        not resource.has_value()) [[unlikely]] {
+      throw missing_resource<T>{};
+    } else {
+      NOVA_ASSERT(
+          std::this_thread::get_id() == world.resources().main_thread(),
+          "system `{}` accessed `NonSend<{}>` off the main thread",
+          meta.id.name(), type_name<T>());
+      return *std::move(resource);
+    }
+  }
+
+  static constexpr auto access() -> Access {
+    constexpr auto access = type_id<non_send_param<std::remove_const_t<T>>>();
+    if constexpr (std::is_const_v<T>) {
+      return Access{
+          .read_only = std::vector<TypeId>{access},
+          .main_thread = true,
+      };
+    } else {
+      return Access{
+          .read_write = std::vector<TypeId>{access},
+          .main_thread = true,
+      };
+    }
+  }
+};
+
+template <typename T>
+struct system_param<Optional<NonSend<T>>> {
+  static auto param(SystemMeta const& meta, World& world)
+      -> Optional<NonSend<T>> {
+    auto resource = world.resources().get_non_send<T>();
+    NOVA_ASSERT(not resource.has_value() or
+                    std::this_thread::get_id() ==
+                        world.resources().main_thread(),
+                "system `{}` accessed `NonSend<{}>` off the main thread",
+                meta.id.name(), type_name<T>());
+    return resource;
+  }
+
+  static constexpr auto access() -> Access {
+    return system_param<NonSend<T>>::access();
+  }
+};
+
 template <typename T>
 struct system_param<Local<T>> {
   using state_t = T;
@@ -150,6 +205,13 @@ struct system_param<View<With<TWith...>, Without<TWithout...>>> {
     return view_t{world.registry().view<TWith...>(entt::exclude<TWithout...>)};
   }
 
+  // building the view creates the pools it misses.
+  static auto assure_pools(World& world) -> void {
+    auto& registry = world.registry();
+    (registry.storage<std::remove_const_t<TWith>>(), ...);
+    (registry.storage<std::remove_const_t<TWithout>>(), ...);
+  }
+
   static constexpr auto access() -> Access {
     namespace views = std::ranges::views;
 
@@ -182,14 +244,19 @@ requires(std::is_same_v<std::remove_cvref_t<TWorld>, World>and
   }
 
   static constexpr auto access() -> Access {
-    // TODO: this is exclusive, so not too sure exactly what to do
+    // the world gives access to everything, main thread only resources
+    // included.
     if constexpr (std::is_const_v<std::remove_reference_t<TWorld>>) {
       return Access{
           .read_only = std::vector<TypeId>{type_id<World>()},
+          .main_thread = true,
+          .exclusive = true,
       };
     } else {
       return Access{
           .read_write = std::vector<TypeId>{type_id<World>()},
+          .main_thread = true,
+          .exclusive = true,
       };
     }
   }
@@ -207,10 +274,14 @@ requires(std::is_same_v<std::remove_cvref_t<TResources>, Resources>and
     if constexpr (std::is_const_v<std::remove_reference_t<TResources>>) {
       return Access{
           .read_only = std::vector<TypeId>{type_id<Resources>()},
+          .main_thread = true,
+          .exclusive = true,
       };
     } else {
       return Access{
           .read_write = std::vector<TypeId>{type_id<Resources>()},
+          .main_thread = true,
+          .exclusive = true,
       };
     }
   }
@@ -225,13 +296,16 @@ requires(
   }
 
   static constexpr auto access() -> Access {
+    // any component may be accessed through the registry.
     if constexpr (std::is_const_v<std::remove_reference_t<TRegistry>>) {
       return Access{
           .read_only = std::vector<TypeId>{type_id<Registry>()},
+          .exclusive = true,
       };
     } else {
       return Access{
           .read_write = std::vector<TypeId>{type_id<Registry>()},
+          .exclusive = true,
       };
     }
   }
@@ -282,7 +356,8 @@ struct SystemState;
 template <typename... TArgs>
 struct SystemState<args<TArgs...>>
     : std::tuple<typename system_param_impl<TArgs>::state_t...> {
-  using std::tuple<typename system_param_impl<TArgs>::state_t...>::tuple;
+  using tuple_t = std::tuple<typename system_param_impl<TArgs>::state_t...>;
+  using tuple_t::tuple;
 };
 
 template <typename TSystem>
@@ -291,6 +366,30 @@ struct SystemData {
   function_wrapper<TSystem> system;
 };
 
+}  // namespace detail
+
+// The memory owned by the state of a system's parameters, e.g. its `Local`s.
+template <typename TSystem>
+struct heap_usage<detail::SystemData<TSystem>> {
+  auto operator()(const detail::SystemData<TSystem>& data) const
+      -> MemoryUsage {
+    using state_t = detail::SystemState<args_t<TSystem>>;
+    auto usage = MemoryUsage{};
+    if (data.state.has_value()) {
+      std::apply(
+          [&](const auto&... states) {
+            ((usage +=
+              heap_usage<std::remove_cvref_t<decltype(states)>>{}(states)),
+             ...);
+          },
+          static_cast<const typename state_t::tuple_t&>(*data.state));
+    }
+    return usage;
+  }
+};
+
+namespace detail {
+
 template <typename TSystem>
 constexpr auto get_system_access() -> Access {
   using func_traits = function_traits<std::remove_cvref_t<TSystem>>;
@@ -304,21 +403,21 @@ constexpr auto get_system_access() -> Access {
 // helper function that aggregate all the system arguments, check them, and then
 // invoke the original function
 template <typename TSystem, typename... Args>
-auto type_erased_runc_func_impl(SystemMeta const& meta, void* const data,
-                                World& world, args<Args...>) -> void {
+auto invoke_system_impl(SystemMeta const& meta,
+                        SystemData<TSystem>& system_data, World& world,
+                        args<Args...>) -> decltype(auto) {
   static_assert((nova::concepts::system_param<Args> and ...),
                 "System has invalid argument types");
 
-  auto* const system_data = reinterpret_cast<SystemData<TSystem>*>(data);
-
-  [&]<auto... Is, typename... TSystemParam>(std::index_sequence<Is...>,
-                                            type_list<TSystemParam...>) {
-    DEBUG_ASSERT(system_data->state.has_value(),
+  return [&]<auto... Is, typename... TSystemParam>(
+             std::index_sequence<Is...>,
+             type_list<TSystemParam...>) -> decltype(auto) {
+    DEBUG_ASSERT(system_data.state.has_value(),
                  "system `{}` is not initialized!", meta.id.name());
 
-    std::invoke(
-        system_data->system.func,
-        TSystemParam::param(std::get<Is>(*system_data->state), meta, world)...);
+    return std::invoke(
+        system_data.system.func,
+        TSystemParam::param(std::get<Is>(*system_data.state), meta, world)...);
   }
   (std::index_sequence_for<Args...>{}, type_list<system_param_impl<Args>...>{});
 }
@@ -332,22 +431,23 @@ auto type_erased_runc_func(SystemMeta const& meta, void* const data,
   static_assert(std::is_same_v<void, typename func_traits::result_t>,
                 "Systems must return `void`");
 
+  auto& system_data = *reinterpret_cast<SystemData<TSystem>*>(data);
   auto& world = *reinterpret_cast<World*>(world_ptr);
-  type_erased_runc_func_impl<TSystem>(meta, data, world,
-                                      typename func_traits::args_t{});
+  invoke_system_impl<TSystem>(meta, system_data, world,
+                              typename func_traits::args_t{});
 }
 
 template <typename TSystem, typename... Args>
-auto type_erased_initialize_func_impl(SystemMeta const& meta, void* const data,
-                                      World& world, args<Args...>) -> void {
-  auto* const system_data = reinterpret_cast<SystemData<TSystem>*>(data);
+auto initialize_system_impl(SystemMeta const& meta,
+                            SystemData<TSystem>& system_data, World& world,
+                            args<Args...>) -> void {
   [&]<auto... Is, typename... TSystemParam>(std::index_sequence<Is...>,
                                             type_list<TSystemParam...>) {
-    DEBUG_ASSERT(not system_data->state.has_value(),
+    DEBUG_ASSERT(not system_data.state.has_value(),
                  "system `{}`'s state is being initialize more than once!",
                  meta.id.name());
 
-    system_data->state.emplace(TSystemParam::init(meta, world)...);
+    system_data.state.emplace(TSystemParam::init(meta, world)...);
   }
   (std::index_sequence_for<Args...>{}, type_list<system_param_impl<Args>...>{});
 }
@@ -357,9 +457,24 @@ auto type_erased_initialize_func(SystemMeta const& meta, void* const data,
                                  void* const world_ptr) -> void {
   using func_traits = function_traits<TSystem>;
 
+  auto& system_data = *reinterpret_cast<SystemData<TSystem>*>(data);
   auto& world = *reinterpret_cast<World*>(world_ptr);
-  type_erased_initialize_func_impl<TSystem>(meta, data, world,
-                                            typename func_traits::args_t{});
+  initialize_system_impl<TSystem>(meta, system_data, world,
+                                  typename func_traits::args_t{});
+}
+
+// creates the pools of every parameter of the system that has some.
+template <typename TSystem>
+auto type_erased_assure_func(void* const world_ptr) -> void {
+  auto& world = *static_cast<World*>(world_ptr);
+  [&]<typename... TArgs>(args<TArgs...>) {
+    const auto assure = [&]<typename TArg>(std::type_identity<TArg>) {
+      if constexpr (requires { system_param<TArg>::assure_pools(world); }) {
+        system_param<TArg>::assure_pools(world);
+      }
+    };
+    (assure(std::type_identity<TArgs>{}), ...);
+  }(args_t<TSystem>{});
 }
 
 template <typename TSystem>
@@ -372,9 +487,12 @@ auto create_system(TSystem&& system) -> System {
       .data = void_ptr::create<system_data_t>(
           tl::nullopt,
           detail::function_wrapper<system_t>{std::in_place, FWD(system)}),
-      .meta = SystemMeta{
-          .id = type_id<system_t>(),
-      }};
+      .meta =
+          SystemMeta{
+              .id = type_id<system_t>(),
+          },
+      .assure_func = detail::type_erased_assure_func<system_t>,
+  };
 }
 
 }  // namespace detail
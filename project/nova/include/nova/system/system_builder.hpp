@@ -5,12 +5,14 @@
 #include <range/v3/view/move.hpp>
 #include <range/v3/view/zip.hpp>
 
+#include "kernel.hpp"
 #include "system.hpp"
 
 namespace nova {
 
 namespace {
 struct system_tag_t {};
+struct kernel_tag_t {};
 }  // namespace
 
 class system_builder : public builder_base<system_builder> {
@@ -27,6 +29,13 @@ class system_builder : public builder_base<system_builder> {
         access_(detail::get_system_access<T>()) {
     this->labels_.push_back(to_label(system_));
   }
+
+  template <concepts::system T>
+  constexpr system_builder(kernel_tag_t, T&& system)
+      : system_{detail::create_kernel_system(FWD(system))},
+        access_(detail::get_kernel_access<T>()) {
+    this->labels_.push_back(to_label(system_));
+  }
 };
 
 template <>
@@ -49,6 +58,21 @@ constexpr auto system(TSystem&& system) {
   return system_builder{system_tag_t{}, FWD(system)};
 }
 
+/// @brief Creates a per-entity kernel system.
+///
+/// A kernel system takes ordinary system parameters and returns a callable
+/// that is invoked once per entity with references to that entity's
+/// components. Consecutive kernels in a stage that share a component are fused
+/// by the scheduler into a single pass over that component's storage, while
+/// still running in their declared order for each entity.
+///
+/// Kernels must only touch the components they are given; they cannot add or
+/// remove components while running.
+template <concepts::system TSystem>
+constexpr auto kernel(TSystem&& system) {
+  return system_builder{kernel_tag_t{}, FWD(system)};
+}
+
 class system_set : public builder_base<system_set> {
  private:
   std::vector<System> systems_{};
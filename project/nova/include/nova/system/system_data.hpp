@@ -7,7 +7,9 @@
 #include <nova/util/common.hpp>
 #include <nova/util/type.hpp>
 #include <nova/util/void_ptr.hpp>
+#include <span>
 #include <string>
+#include <tl/optional.hpp>
 #include <type_traits>
 #include <vector>
 
@@ -17,13 +19,43 @@ struct SystemMeta {
   TypeId id;
 };
 
+/// @brief The type-erased entry points of a per-entity kernel system (see
+/// `nova::kernel`). The scheduler uses these to fuse consecutive kernels that
+/// share a component into a single pass over that component's storage.
+struct SystemKernel {
+  using func_t = auto(*)(SystemMeta const &, void *, void *) -> void;
+  using block_func_t = auto(*)(void *, void *,
+                               std::span<const entt::entity>) -> void;
+  using storage_func_t = auto(*)(void *) -> const entt::sparse_set &;
+
+  struct Component {
+    TypeId id;
+    storage_func_t storage;
+  };
+
+  // Fetches the system parameters and builds this frame's kernel.
+  func_t prepare_func;
+  // Invokes the prepared kernel on every entity of the block that matches the
+  // kernel's components.
+  block_func_t block_func;
+  // Releases the kernel built by `prepare_func`.
+  func_t finish_func;
+  std::vector<Component> components{};
+};
+
 struct System {
   using func_t = auto(*)(SystemMeta const &, void *, void *) -> void;
+  using assure_func_t = auto(*)(void *) -> void;
 
   func_t run_func;
   func_t initialize_func;
   void_ptr data;
   SystemMeta meta;
+  tl::optional<SystemKernel> kernel{};
+  // Creates the component pools the system's parameters use. Looking them
+  // up creates missing ones, which is not thread safe, so the scheduler
+  // creates them up front before running systems concurrently.
+  assure_func_t assure_func = nullptr;
 
   constexpr auto run(void *world_ptr) -> void {
     run_func(meta, data.data(), world_ptr);
@@ -32,6 +64,12 @@ struct System {
   constexpr auto initialize(void *world_ptr) -> void {
     initialize_func(meta, data.data(), world_ptr);
   }
+
+  constexpr auto assure_pools(void *world_ptr) const -> void {
+    if (assure_func != nullptr) {
+      assure_func(world_ptr);
+    }
+  }
 };
 
 template <>
@@ -52,6 +90,11 @@ struct Ordering {
 struct Access {
   std::vector<TypeId> read_only{};
   std::vector<TypeId> read_write{};
+  // the system must run on the main thread (e.g. it takes a `NonSend<T>`).
+  bool main_thread{false};
+  // the system may touch anything (e.g. it takes the `World&`), so it never
+  // runs concurrently with other systems.
+  bool exclusive{false};
 
   template <class T>
   static constexpr auto single() -> Access {
@@ -79,12 +122,26 @@ struct Access {
 
     merge_vectors(read_only, MOV(other).read_only);
     merge_vectors(read_write, MOV(other).read_write);
+    main_thread = main_thread or other.main_thread;
+    exclusive = exclusive or other.exclusive;
 
     // remove read_only TypeId's that exist in read_write.
     std::erase_if(read_only, [&](const auto &ro_tid) -> bool {
       return nova::contains(read_write, nova::equals(ro_tid));
     });
   }
+
+  /// @brief Whether two systems with these accesses cannot run concurrently.
+  [[nodiscard]] auto conflicts_with(const Access &other) const -> bool {
+    const auto writes = [](const Access &writer, const Access &reader) {
+      return std::ranges::any_of(writer.read_write, [&](const auto &id) {
+        return nova::contains(reader.read_write, nova::equals(id)) or
+               nova::contains(reader.read_only, nova::equals(id));
+      });
+    };
+    return exclusive or other.exclusive or writes(*this, other) or
+           writes(other, *this);
+  }
 };
 
 template <typename>
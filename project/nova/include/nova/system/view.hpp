@@ -1,7 +1,13 @@
 #pragma once
+#include <cstddef>
 #include <entt/entt.hpp>
+#include <iterator>
+#include <memory>
 #include <nova/util/common.hpp>
+#include <span>
+#include <tuple>
 #include <type_traits>
+#include <vector>
 
 namespace nova {
 
@@ -11,6 +17,26 @@ struct With {};
 template <typename... TComponentss>
 struct Without {};
 
+/// @brief A run of entities of a view whose components are all stored
+/// contiguously, in the same order as `entities`.
+/// Empty components (tags) have no storage and yield an empty span.
+template <typename... TComponents>
+struct ViewChunk {
+  std::span<const entt::entity> entities{};
+  std::tuple<std::span<TComponents>...> components{};
+
+  [[nodiscard]] auto size() const noexcept -> std::size_t {
+    return std::size(entities);
+  }
+
+  /// @brief The packed array of `T`, which must be spelled as in the view
+  /// (`get<const position>()` for `View<With<const position>>`).
+  template <typename T>
+  [[nodiscard]] auto get() const noexcept -> std::span<T> {
+    return std::get<std::span<T>>(components);
+  }
+};
+
 namespace detail {
 
 template <typename TWith, typename TWithout>
@@ -31,11 +57,156 @@ template <typename... TWith, typename... TWithout>
 struct View<With<TWith...>, Without<TWithout...>>
     : detail::entt_view_t<With<TWith...>, Without<TWithout...>> {
   using base_t = detail::entt_view_t<With<TWith...>, Without<TWithout...>>;
+  using chunk_t = ViewChunk<TWith...>;
+
+ private:
+  using pointers_t = std::tuple<TWith*...>;
+
+  template <typename T>
+  [[nodiscard]] auto component_ptr(const entt::entity e) const -> T* {
+    if constexpr (std::is_empty_v<T>) {
+      return nullptr;
+    } else {
+      return std::addressof(this->template get<T>(e));
+    }
+  }
+
+  template <typename T>
+  [[nodiscard]] static auto next_ptr(T* const ptr) noexcept -> T* {
+    if constexpr (std::is_empty_v<T>) {
+      return nullptr;
+    } else {
+      return ptr + 1;
+    }
+  }
+
+  template <typename T>
+  [[nodiscard]] static auto make_span(T* const first,
+                                      const std::size_t count) noexcept
+      -> std::span<T> {
+    if constexpr (std::is_empty_v<T>) {
+      return {};
+    } else {
+      return std::span<T>{first, count};
+    }
+  }
+
+  // the chunk starting at or after `index`, which is moved past it. Empty
+  // once the view is exhausted.
+  [[nodiscard]] auto next_chunk(std::size_t& index) const -> chunk_t {
+    const auto& handle = this->handle();
+    const auto* const entities = handle.data();
+    const auto n_entities = handle.size();
+
+    while (index < n_entities and not this->contains(entities[index])) {
+      ++index;
+    }
+    if (index == n_entities) {
+      return chunk_t{};
+    }
+
+    const auto first = index;
+    const auto first_ptrs =
+        pointers_t{component_ptr<TWith>(entities[first])...};
+    const auto next_ptrs = [](const pointers_t& ptrs) {
+      return std::apply(
+          [](auto*... current) { return pointers_t{next_ptr(current)...}; },
+          ptrs);
+    };
+
+    auto expected_ptrs = next_ptrs(first_ptrs);
+    for (++index; index < n_entities; ++index) {
+      const auto e = entities[index];
+      if (not this->contains(e)) {
+        break;
+      }
+      const auto ptrs = pointers_t{component_ptr<TWith>(e)...};
+      if (ptrs != expected_ptrs) {
+        break;
+      }
+      expected_ptrs = next_ptrs(ptrs);
+    }
+
+    const auto count = index - first;
+    return chunk_t{
+        .entities = std::span<const entt::entity>{entities + first, count},
+        .components = std::apply(
+            [count](auto*... ptrs) {
+              return std::tuple{make_span(ptrs, count)...};
+            },
+            first_ptrs),
+    };
+  }
+
+ public:
+  /// @brief Iterates over the chunks of a view, finding each one as it is
+  /// reached, so iterating never allocates.
+  class ChunkIterator {
+    const View* view_ = nullptr;
+    std::size_t index_ = 0u;
+    chunk_t chunk_{};
+
+   public:
+    using value_type = chunk_t;
+    using difference_type = std::ptrdiff_t;
+
+    ChunkIterator() = default;
+    explicit(true) ChunkIterator(const View& view)
+        : view_(std::addressof(view)), chunk_(view.next_chunk(index_)) {}
+
+    [[nodiscard]] auto operator*() const noexcept -> const chunk_t& {
+      return chunk_;
+    }
+
+    [[nodiscard]] auto operator->() const noexcept -> const chunk_t* {
+      return std::addressof(chunk_);
+    }
+
+    auto operator++() -> ChunkIterator& {
+      chunk_ = view_->next_chunk(index_);
+      return *this;
+    }
+
+    auto operator++(int) -> void { ++*this; }
+
+    [[nodiscard]] friend auto operator==(const ChunkIterator& iter,
+                                         std::default_sentinel_t) noexcept
+        -> bool {
+      return std::empty(iter.chunk_.entities);
+    }
+  };
+
+  struct Chunks {
+    const View* view;
+
+    [[nodiscard]] auto begin() const -> ChunkIterator {
+      return ChunkIterator{*view};
+    }
+    [[nodiscard]] auto end() const noexcept -> std::default_sentinel_t {
+      return {};
+    }
+  };
 
   template <typename T>
   requires(not std::is_same_v<std::remove_cvref_t<T>, View>) explicit(
       true) constexpr View(T&& repr) noexcept
       : base_t(FWD(repr)) {}
+
+  /// @brief Splits the view into runs of entities whose components are laid
+  /// out contiguously in every included pool, so each run can be processed
+  /// with plain loops over `chunk.get<T>()` spans.
+  ///
+  /// Chunks follow the packed order of the view's smallest pool and break
+  /// wherever an entity is filtered out or any pool stops being contiguous
+  /// (different packed order, or a storage page boundary). A view over a
+  /// single pool, or over pools kept in the same order, yields few large
+  /// chunks.
+  ///
+  /// The chunks are found while iterating, which does not allocate, so this
+  /// can be called every frame. The view must outlive the iteration.
+  [[nodiscard]] auto chunks() const noexcept -> Chunks {
+    return Chunks{this};
+  }
 };
 
 }  // namespace nova
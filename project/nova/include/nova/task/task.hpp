@@ -0,0 +1,241 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <nova/util/common.hpp>
+#include <optional>
+#include <stop_token>
+#include <type_traits>
+#include <utility>
+
+#include "task_pool.hpp"
+
+namespace nova {
+
+/// @brief Thrown inside a cancelled task when it reaches a cancellation
+/// point (`co_await yield_now()` or `co_await cancellation_point()`).
+struct task_cancelled : nova_exception {
+  task_cancelled() : nova_exception{"task cancelled"} {}
+};
+
+template <typename T = void>
+class Task;
+
+namespace detail {
+
+/// @brief Where a task runs and whether it should stop, shared by a task and
+/// every task it awaits.
+struct TaskContext {
+  TaskPool* pool = nullptr;
+  std::stop_token stop{};
+};
+
+/// @brief Notified when a task that no other task awaits finishes.
+struct TaskCompletion {
+  virtual auto complete() noexcept -> void = 0;
+
+ protected:
+  ~TaskCompletion() = default;
+};
+
+struct TaskPromiseBase {
+  TaskContext context{};
+  // the task awaiting this one, if any.
+  std::coroutine_handle<> continuation{};
+  // set on the tasks nothing awaits.
+  TaskCompletion* completion = nullptr;
+  std::exception_ptr error{};
+
+  struct FinalAwaiter {
+    auto await_ready() const noexcept -> bool { return false; }
+
+    template <typename TPromise>
+    auto await_suspend(std::coroutine_handle<TPromise> handle) const noexcept
+        -> std::coroutine_handle<> {
+      auto& promise = handle.promise();
+      if (promise.continuation) {
+        return promise.continuation;
+      }
+      if (promise.completion != nullptr) {
+        // may destroy the coroutine, which must not be touched afterwards.
+        promise.completion->complete();
+      }
+      return std::noop_coroutine();
+    }
+
+    auto await_resume() const noexcept -> void {}
+  };
+
+  auto initial_suspend() const noexcept -> std::suspend_always { return {}; }
+  auto final_suspend() const noexcept -> FinalAwaiter { return {}; }
+  auto unhandled_exception() noexcept -> void {
+    error = std::current_exception();
+  }
+};
+
+template <typename T>
+struct TaskPromise : TaskPromiseBase {
+  std::optional<T> value{};
+
+  auto get_return_object() noexcept -> Task<T>;
+
+  template <typename U>
+  requires std::is_convertible_v<U&&, T>
+  auto return_value(U&& result) -> void { value.emplace(FWD(result)); }
+};
+
+template <>
+struct TaskPromise<void> : TaskPromiseBase {
+  auto get_return_object() noexcept -> Task<void>;
+  auto return_void() const noexcept -> void {}
+};
+
+struct YieldAwaiter {
+  std::stop_token stop{};
+
+  auto await_ready() const noexcept -> bool { return false; }
+
+  template <typename TPromise>
+  auto await_suspend(std::coroutine_handle<TPromise> handle) -> bool {
+    const auto& context = handle.promise().context;
+    stop = context.stop;
+    if (stop.stop_requested() or context.pool == nullptr) {
+      return false;
+    }
+    // the task may resume (and finish) on a worker before `spawn` returns.
+    context.pool->spawn([handle] { handle.resume(); });
+    return true;
+  }
+
+  auto await_resume() const -> void {
+    if (stop.stop_requested()) {
+      throw task_cancelled{};
+    }
+  }
+};
+
+struct CancellationAwaiter {
+  std::stop_token stop{};
+
+  auto await_ready() const noexcept -> bool { return false; }
+
+  template <typename TPromise>
+  auto await_suspend(std::coroutine_handle<TPromise> handle) noexcept
+      -> bool {
+    stop = handle.promise().context.stop;
+    return false;
+  }
+
+  auto await_resume() const -> void {
+    if (stop.stop_requested()) {
+      throw task_cancelled{};
+    }
+  }
+};
+
+}  // namespace detail
+
+/// @brief A lazily started coroutine producing a `T`.
+///
+/// Tasks are spawned on a `TaskPool` through a `TaskSet` (or the `Tasks<T>`
+/// system param) and may `co_await` other tasks, which run inline on the
+/// same thread. Long running tasks should regularly `co_await yield_now()`,
+/// both to let other work run on the pool and to be cancellable.
+///
+/// NOTE: a coroutine lambda's captures die with the lambda, so prefer plain
+/// functions (or captureless lambdas) taking their inputs by value.
+template <typename T>
+class [[nodiscard]] Task {
+ public:
+  using promise_type = detail::TaskPromise<T>;
+  using handle_t = std::coroutine_handle<promise_type>;
+
+ private:
+  handle_t handle_{};
+
+  struct Awaiter {
+    handle_t handle;
+
+    auto await_ready() const noexcept -> bool { return false; }
+
+    template <typename TPromise>
+    auto await_suspend(std::coroutine_handle<TPromise> parent) noexcept
+        -> std::coroutine_handle<> {
+      auto& promise = handle.promise();
+      promise.continuation = parent;
+      promise.context = parent.promise().context;
+      return handle;
+    }
+
+    auto await_resume() -> T {
+      auto& promise = handle.promise();
+      if (promise.error) {
+        std::rethrow_exception(promise.error);
+      }
+      if constexpr (not std::is_void_v<T>) {
+        return MOV(*promise.value);
+      }
+    }
+  };
+
+ public:
+  Task() noexcept = default;
+  explicit(true) Task(const handle_t handle) noexcept : handle_(handle) {}
+
+  Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+  Task& operator=(Task&& other) noexcept {
+    if (this != &other) {
+      reset();
+      handle_ = std::exchange(other.handle_, {});
+    }
+    return *this;
+  }
+  Task(Task const&) = delete;
+  Task& operator=(Task const&) = delete;
+
+  ~Task() { reset(); }
+
+  [[nodiscard]] auto valid() const noexcept -> bool {
+    return static_cast<bool>(handle_);
+  }
+
+  /// @brief Gives up the ownership of the coroutine.
+  [[nodiscard]] auto release() noexcept -> handle_t {
+    return std::exchange(handle_, {});
+  }
+
+  auto operator co_await() && noexcept -> Awaiter { return Awaiter{handle_}; }
+
+ private:
+  auto reset() noexcept -> void {
+    if (handle_) {
+      handle_.destroy();
+      handle_ = {};
+    }
+  }
+};
+
+template <typename T>
+auto detail::TaskPromise<T>::get_return_object() noexcept -> Task<T> {
+  return Task<T>{Task<T>::handle_t::from_promise(*this)};
+}
+
+inline auto detail::TaskPromise<void>::get_return_object() noexcept
+    -> Task<void> {
+  return Task<void>{Task<void>::handle_t::from_promise(*this)};
+}
+
+/// @brief Suspends the current task and resumes it later on the task pool.
+/// Throws `task_cancelled` once the task is cancelled.
+[[nodiscard]] inline auto yield_now() noexcept -> detail::YieldAwaiter {
+  return {};
+}
+
+/// @brief Throws `task_cancelled` if the current task is cancelled, without
+/// suspending it.
+[[nodiscard]] inline auto cancellation_point() noexcept
+    -> detail::CancellationAwaiter {
+  return {};
+}
+
+}  // namespace nova
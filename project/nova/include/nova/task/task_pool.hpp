@@ -0,0 +1,250 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <nova/util/common.hpp>
+#include <thread>
+#include <vector>
+
+namespace nova {
+
+namespace detail {
+
+// Work several workers may join, queued without allocating: it lives on the
+// stack of `parallel_for`, which takes it off the queue before returning.
+// All but `run` is guarded by the mutex of the pool.
+struct PoolJob {
+  PoolJob* next = nullptr;
+  // the workers that may still join, the job leaves the queue at zero.
+  std::size_t wanted{0};
+  // the workers running the job.
+  std::size_t active{0};
+  std::condition_variable done{};
+  auto (*run)(PoolJob&) -> void = nullptr;
+};
+
+}  // namespace detail
+
+/// @brief A fixed size pool of worker threads.
+class TaskPool {
+ public:
+  using task_t = std::function<void()>;
+
+ private:
+  std::mutex mutex_{};
+  std::condition_variable cv_{};
+  std::deque<task_t> tasks_{};
+  // the jobs of `parallel_for`, oldest first.
+  detail::PoolJob* jobs_ = nullptr;
+  bool stopping_ = false;
+  std::vector<std::jthread> threads_{};
+
+  auto worker_loop() -> void {
+    for (;;) {
+      auto lock = std::unique_lock{mutex_};
+      cv_.wait(lock, [&] {
+        return stopping_ or jobs_ != nullptr or not std::empty(tasks_);
+      });
+      if (auto* const job = jobs_; job != nullptr) {
+        if (--job->wanted == 0u) {
+          jobs_ = job->next;
+        }
+        ++job->active;
+        lock.unlock();
+        job->run(*job);
+        lock.lock();
+        // notified under the lock: the job is gone once it is released.
+        if (--job->active == 0u) {
+          job->done.notify_all();
+        }
+        continue;
+      }
+      if (std::empty(tasks_)) {
+        return;
+      }
+      auto task = MOV(tasks_.front());
+      tasks_.pop_front();
+      lock.unlock();
+      task();
+    }
+  }
+
+  // queues `job` for `n_helpers` workers. Under `mutex_`.
+  auto push_job(detail::PoolJob& job, const std::size_t n_helpers) noexcept
+      -> void {
+    job.wanted = n_helpers;
+    auto** link = &jobs_;
+    while (*link != nullptr) {
+      link = &(*link)->next;
+    }
+    *link = &job;
+  }
+
+  // takes `job` off the queue if workers may still join it. Under `mutex_`.
+  auto remove_job(detail::PoolJob& job) noexcept -> void {
+    if (job.wanted == 0u) {
+      return;
+    }
+    job.wanted = 0u;
+    for (auto** link = &jobs_; *link != nullptr; link = &(*link)->next) {
+      if (*link == &job) {
+        *link = job.next;
+        return;
+      }
+    }
+  }
+
+ public:
+  explicit(true) TaskPool(
+      const std::size_t n_threads =
+          std::max(1u, std::thread::hardware_concurrency())) {
+    threads_.reserve(n_threads);
+    for (auto i = std::size_t{0}; i < n_threads; ++i) {
+      threads_.emplace_back([this] { worker_loop(); });
+    }
+  }
+
+  TaskPool(TaskPool&&) = delete;
+  TaskPool(TaskPool const&) = delete;
+  TaskPool& operator=(TaskPool&&) = delete;
+  TaskPool& operator=(TaskPool const&) = delete;
+
+  ~TaskPool() {
+    {
+      auto lock = std::scoped_lock{mutex_};
+      stopping_ = true;
+    }
+    cv_.notify_all();
+    // the remaining tasks are drained before the jthreads are joined.
+  }
+
+  [[nodiscard]] auto thread_count() const noexcept -> std::size_t {
+    return std::size(threads_);
+  }
+
+  /// @brief Queues a task to be run on one of the worker threads.
+  auto spawn(task_t task) -> void {
+    {
+      auto lock = std::scoped_lock{mutex_};
+      tasks_.push_back(MOV(task));
+    }
+    cv_.notify_one();
+  }
+
+  /// @brief Invokes `func(i)` for every `i` in `[0, n)` across the worker
+  /// threads and the calling thread, returning once every call finished.
+  /// If any call throws, the first exception is rethrown on the calling
+  /// thread once all the other calls are done.
+  ///
+  /// The calling thread takes part in the work and only waits on helpers that
+  /// actually started, so this may be called from within a worker thread.
+  /// Unlike `spawn`, it does not allocate.
+  template <typename TFunc>
+  auto parallel_for(const std::size_t n, TFunc&& func) -> void {
+    parallel_for_impl(n, std::min(thread_count(), n - 1u), func, [] {});
+  }
+
+  /// @brief Same as `parallel_for(n, func)`, but the calling thread first
+  /// runs `on_caller()`, e.g. work that must stay on it, while the worker
+  /// threads already start on the indices. It then joins them.
+  ///
+  /// Nothing waits on the queue: with no worker threads, or workers busy with
+  /// other tasks, the calling thread does all of the work.
+  template <typename TFunc, typename TCaller>
+  auto parallel_for(const std::size_t n, TFunc&& func, TCaller&& on_caller)
+      -> void {
+    parallel_for_impl(n, std::min(thread_count(), n), func, on_caller);
+  }
+
+ private:
+  template <typename TFunc>
+  struct ForJob : detail::PoolJob {
+    std::size_t n;
+    TFunc* func;
+    std::atomic<std::size_t> next_index{0};
+    std::atomic<bool> failed{false};
+    // the first error, guarded by the mutex of the pool.
+    std::exception_ptr error{};
+    std::mutex* mutex;
+
+    ForJob(const std::size_t size, TFunc& f, std::mutex& pool_mutex) noexcept
+        : n(size), func(&f), mutex(&pool_mutex) {
+      run = [](detail::PoolJob& job) {
+        static_cast<ForJob&>(job).run_indices();
+      };
+    }
+
+    auto run_indices() -> void {
+      for (auto i = next_index.fetch_add(1u, std::memory_order_relaxed); i < n;
+           i = next_index.fetch_add(1u, std::memory_order_relaxed)) {
+        if (failed.load(std::memory_order_relaxed)) {
+          continue;
+        }
+        try {
+          (*func)(i);
+        } catch (...) {
+          auto lock = std::scoped_lock{*mutex};
+          if (not error) {
+            error = std::current_exception();
+          }
+          failed.store(true, std::memory_order_relaxed);
+        }
+      }
+    }
+  };
+
+  template <typename TFunc, typename TCaller>
+  auto parallel_for_impl(const std::size_t n, const std::size_t n_helpers,
+                         TFunc& func, TCaller&& on_caller) -> void {
+    if (n == 0u) {
+      on_caller();
+      return;
+    }
+
+    // the job lives here: helpers only join it until it is taken off the
+    // queue below, so nothing is allocated to share it.
+    auto job = ForJob<TFunc>{n, func, mutex_};
+    if (n_helpers > 0u) {
+      {
+        auto lock = std::scoped_lock{mutex_};
+        push_job(job, n_helpers);
+      }
+      if (n_helpers == 1u) {
+        cv_.notify_one();
+      } else {
+        cv_.notify_all();
+      }
+    }
+
+    // the helpers may still use `func`, wait for them before unwinding.
+    auto caller_error = std::exception_ptr{};
+    try {
+      on_caller();
+    } catch (...) {
+      caller_error = std::current_exception();
+    }
+
+    job.run_indices();
+
+    {
+      auto lock = std::unique_lock{mutex_};
+      remove_job(job);
+      job.done.wait(lock, [&] { return job.active == 0u; });
+    }
+
+    if (caller_error) {
+      std::rethrow_exception(caller_error);
+    }
+    if (job.error) {
+      std::rethrow_exception(job.error);
+    }
+  }
+};
+
+}  // namespace nova
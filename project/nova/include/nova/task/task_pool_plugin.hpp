@@ -0,0 +1,15 @@
+#pragma once
+
+#include <nova/app/app.hpp>
+
+#include "task_pool.hpp"
+
+namespace nova {
+
+/// @brief Inserts a `TaskPool` resource with one thread per hardware thread.
+/// When present, the default runner initializes the scheduler in parallel.
+struct TaskPoolPlugin {
+  auto operator()(App& app) -> void { app.insert_resource<TaskPool>(); }
+};
+
+}  // namespace nova
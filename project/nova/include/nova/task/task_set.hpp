@@ -0,0 +1,305 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <nova/util/common.hpp>
+#include <optional>
+#include <stop_token>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include "task.hpp"
+#include "task_pool.hpp"
+
+namespace nova {
+
+namespace detail {
+
+struct TaskCancelled {};
+struct TaskDone {};
+
+template <typename T>
+using task_value_t = std::conditional_t<std::is_void_v<T>, TaskDone, T>;
+
+/// @brief A lock-free multi-producer single-consumer queue of intrusive nodes
+/// (anything with a `TNode* next`).
+///
+/// Producers push onto a stack with a compare-and-swap on its head. The
+/// consumer takes the whole stack with a single exchange, so nodes are never
+/// popped one by one and the stack is immune to ABA, and reverses it into
+/// push order.
+template <typename TNode>
+class CompletionQueue {
+  std::atomic<TNode*> head_{nullptr};
+
+ public:
+  CompletionQueue() noexcept = default;
+  CompletionQueue(CompletionQueue&&) = delete;
+  CompletionQueue(CompletionQueue const&) = delete;
+  CompletionQueue& operator=(CompletionQueue&&) = delete;
+  CompletionQueue& operator=(CompletionQueue const&) = delete;
+
+  ~CompletionQueue() {
+    for (auto* node = take_all(); node != nullptr;) {
+      delete std::exchange(node, node->next);
+    }
+  }
+
+  auto push(TNode* const node) noexcept -> void {
+    node->next = head_.load(std::memory_order_relaxed);
+    while (not head_.compare_exchange_weak(node->next, node,
+                                           std::memory_order_release,
+                                           std::memory_order_relaxed)) {
+    }
+  }
+
+  /// @brief Takes every node pushed so far, as a list in push order.
+  [[nodiscard]] auto take_all() noexcept -> TNode* {
+    auto* node = head_.exchange(nullptr, std::memory_order_acquire);
+    auto* reversed = static_cast<TNode*>(nullptr);
+    while (node != nullptr) {
+      auto* const next = node->next;
+      node->next = reversed;
+      reversed = node;
+      node = next;
+    }
+    return reversed;
+  }
+};
+
+template <typename T>
+struct TaskNode;
+
+}  // namespace detail
+
+/// @brief The outcome of a task spawned on a `TaskSet`.
+template <typename T = void>
+class TaskResult {
+  using value_t = detail::task_value_t<T>;
+
+  std::uint64_t id_{};
+  std::variant<detail::TaskCancelled, value_t, std::exception_ptr> state_{};
+
+  friend struct detail::TaskNode<T>;
+
+ public:
+  /// @brief The id of the `TaskHandle` returned when the task was spawned.
+  [[nodiscard]] auto id() const noexcept -> std::uint64_t { return id_; }
+
+  [[nodiscard]] auto cancelled() const noexcept -> bool {
+    return std::holds_alternative<detail::TaskCancelled>(state_);
+  }
+
+  [[nodiscard]] auto failed() const noexcept -> bool {
+    return std::holds_alternative<std::exception_ptr>(state_);
+  }
+
+  [[nodiscard]] auto has_value() const noexcept -> bool {
+    return std::holds_alternative<value_t>(state_);
+  }
+
+  /// @brief The exception the task ended with, if it failed.
+  [[nodiscard]] auto error() const noexcept -> std::exception_ptr {
+    const auto* const error = std::get_if<std::exception_ptr>(&state_);
+    return error != nullptr ? *error : nullptr;
+  }
+
+  /// @brief The task's result. Rethrows the task's exception if it failed, or
+  /// throws `task_cancelled` if it was cancelled.
+  auto value() -> std::add_lvalue_reference_t<T> {
+    if (failed()) {
+      std::rethrow_exception(error());
+    }
+    if (cancelled()) {
+      throw task_cancelled{};
+    }
+    if constexpr (not std::is_void_v<T>) {
+      return std::get<value_t>(state_);
+    }
+  }
+};
+
+/// @brief Refers to a task spawned on a `TaskSet`.
+class TaskHandle {
+  std::uint64_t id_{};
+  std::stop_source stop_{std::nostopstate};
+
+ public:
+  TaskHandle() noexcept = default;
+  TaskHandle(const std::uint64_t id, std::stop_source stop) noexcept
+      : id_(id), stop_(MOV(stop)) {}
+
+  [[nodiscard]] auto id() const noexcept -> std::uint64_t { return id_; }
+
+  /// @brief Requests the task to stop. A task that did not start yet never
+  /// runs, a running task is stopped at its next cancellation point.
+  auto cancel() noexcept -> void { stop_.request_stop(); }
+};
+
+namespace detail {
+
+struct RequestStop {
+  std::stop_source* source;
+  auto operator()() const noexcept -> void { source->request_stop(); }
+};
+
+template <typename T>
+struct TaskNode final : TaskCompletion {
+  using handle_t = typename Task<T>::handle_t;
+
+  TaskNode* next = nullptr;
+  handle_t handle{};
+  std::stop_source stop{};
+  // cancels this task when the whole set is cancelled.
+  std::optional<std::stop_callback<RequestStop>> link{};
+  std::shared_ptr<CompletionQueue<TaskNode>> queue{};
+  TaskResult<T> result{};
+
+  TaskNode(const std::uint64_t id, handle_t coroutine,
+           const std::stop_token& set_stop,
+           std::shared_ptr<CompletionQueue<TaskNode>> completions)
+      : handle(coroutine), queue(MOV(completions)) {
+    result.id_ = id;
+    link.emplace(set_stop, RequestStop{&stop});
+  }
+
+  TaskNode(TaskNode&&) = delete;
+  TaskNode(TaskNode const&) = delete;
+  TaskNode& operator=(TaskNode&&) = delete;
+  TaskNode& operator=(TaskNode const&) = delete;
+
+  ~TaskNode() {
+    if (handle) {
+      handle.destroy();
+    }
+  }
+
+  auto start() noexcept -> void {
+    if (stop.stop_requested()) {
+      handle.destroy();
+      handle = {};
+      publish();
+    } else {
+      handle.resume();
+    }
+  }
+
+  auto complete() noexcept -> void override {
+    auto& promise = handle.promise();
+    try {
+      if (promise.error) {
+        std::rethrow_exception(promise.error);
+      }
+      if constexpr (std::is_void_v<T>) {
+        result.state_ = TaskDone{};
+      } else {
+        result.state_.template emplace<1>(MOV(*promise.value));
+      }
+    } catch (const task_cancelled&) {
+      result.state_ = TaskCancelled{};
+    } catch (...) {
+      result.state_ = std::current_exception();
+    }
+    handle.destroy();
+    handle = {};
+    publish();
+  }
+
+ private:
+  auto publish() noexcept -> void {
+    // once pushed, the node belongs to the queue and may already be gone.
+    // Queued nodes must not keep their queue alive: when the set is gone,
+    // the last reference frees the queue along with the nodes left in it.
+    const auto completions = MOV(queue);
+    completions->push(this);
+  }
+};
+
+}  // namespace detail
+
+/// @brief Runs tasks producing a `T` on a `TaskPool` and collects their
+/// results, without ever blocking the thread that polls them.
+///
+/// Finished tasks are handed back through a lock-free completion queue, so
+/// workers never contend on a lock with the polling thread. `poll()` returns
+/// the results that arrived since the previous call, which typically is the
+/// previous frame: long work spans as many frames as it needs while each
+/// frame only pays for spawning and polling.
+///
+/// Spawning and polling must not happen concurrently; the tasks themselves
+/// run on the pool. Destroying the set cancels the tasks still running.
+template <typename T = void>
+class TaskSet {
+  using node_t = detail::TaskNode<T>;
+
+  TaskPool* pool_;
+  std::shared_ptr<detail::CompletionQueue<node_t>> queue_{
+      std::make_shared<detail::CompletionQueue<node_t>>()};
+  std::stop_source stop_all_{};
+  std::uint64_t next_id_ = 0u;
+  std::size_t pending_ = 0u;
+
+ public:
+  explicit(true) TaskSet(TaskPool& pool) noexcept : pool_(&pool) {}
+
+  TaskSet(TaskSet&&) noexcept = default;
+  TaskSet& operator=(TaskSet&&) noexcept = default;
+  TaskSet(TaskSet const&) = delete;
+  TaskSet& operator=(TaskSet const&) = delete;
+
+  ~TaskSet() { stop_all_.request_stop(); }
+
+  /// @brief Starts `task` on the pool.
+  auto spawn(Task<T> task) -> TaskHandle {
+    if (not task.valid()) [[unlikely]] {
+      throw nova_exception{"TaskSet: cannot spawn an empty task"};
+    }
+
+    auto node = std::make_unique<node_t>(next_id_, task.release(),
+                                         stop_all_.get_token(), queue_);
+    auto& promise = node->handle.promise();
+    promise.context = detail::TaskContext{
+        .pool = pool_,
+        .stop = node->stop.get_token(),
+    };
+    promise.completion = node.get();
+
+    auto handle = TaskHandle{next_id_, node->stop};
+    pool_->spawn([started = node.get()] { started->start(); });
+    node.release();
+
+    ++next_id_;
+    ++pending_;
+    return handle;
+  }
+
+  /// @brief The results of the tasks that finished since the last call, in
+  /// the order they finished.
+  [[nodiscard]] auto poll() -> std::vector<TaskResult<T>> {
+    auto results = std::vector<TaskResult<T>>{};
+    for (auto* node = queue_->take_all(); node != nullptr;) {
+      const auto finished = std::unique_ptr<node_t>{node};
+      node = node->next;
+      results.push_back(MOV(finished->result));
+      --pending_;
+    }
+    return results;
+  }
+
+  /// @brief The number of tasks whose result has not been polled yet.
+  [[nodiscard]] auto pending() const noexcept -> std::size_t {
+    return pending_;
+  }
+
+  /// @brief Cancels every task spawned so far. Their results are still
+  /// delivered by `poll()`, as cancelled unless they finished first.
+  auto cancel_all() -> void {
+    stop_all_.request_stop();
+    stop_all_ = std::stop_source{};
+  }
+};
+
+}  // namespace nova
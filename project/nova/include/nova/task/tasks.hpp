@@ -0,0 +1,55 @@
+#pragma once
+
+#include <nova/resource/resource.hpp>
+#include <nova/system/system.hpp>
+#include <nova/world.hpp>
+
+#include "task.hpp"
+#include "task_pool.hpp"
+#include "task_set.hpp"
+
+namespace nova {
+
+/// @brief System parameter spawning tasks that produce a `T` on the
+/// `TaskPool`, and polling their results in later runs of the system.
+///
+/// Each system gets its own `TaskSet`, which lives as long as the system:
+/// ```cpp
+/// auto find_paths(Tasks<Path> tasks, ...) -> void {
+///   for (auto& result : tasks->poll()) { ... }
+///   if (needs_path) {
+///     tasks->spawn(find_path(from, to));
+///   }
+/// }
+/// ```
+template <typename T = void>
+struct Tasks : detail::ResourceBase<TaskSet<T>> {
+  using detail::ResourceBase<TaskSet<T>>::ResourceBase;
+};
+
+template <typename T>
+struct system_param<Tasks<T>> {
+  using state_t = TaskSet<T>;
+
+  static auto param(state_t& state, SystemMeta const&, World&) -> Tasks<T> {
+    return Tasks<T>{state};
+  }
+
+  static auto init(SystemMeta const&, World& world) -> state_t {
+    if (auto pool = world.resources().get<TaskPool>(); not pool.has_value())
+        [[unlikely]] {
+      throw missing_resource<TaskPool>{};
+    } else {
+      return state_t{**pool};
+    }
+  }
+
+  static constexpr auto access() -> Access {
+    // spawning onto the pool is thread safe.
+    return Access{
+        .read_only = std::vector<TypeId>{type_id<resource_param<TaskPool>>()},
+    };
+  }
+};
+
+}  // namespace nova
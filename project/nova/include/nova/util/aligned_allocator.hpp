@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+namespace nova {
+
+/// @brief An allocator whose allocations are aligned to `Alignment` bytes,
+/// which defaults to the size of a cache line.
+template <typename T, std::size_t Alignment = 64u>
+struct aligned_allocator {
+  static_assert(Alignment >= alignof(T),
+                "aligned_allocator cannot under-align a type");
+  static_assert((Alignment & (Alignment - 1u)) == 0u,
+                "aligned_allocator: the alignment must be a power of two");
+
+  using value_type = T;
+
+  static constexpr auto alignment = std::align_val_t{Alignment};
+
+  template <typename U>
+  struct rebind {
+    using other = aligned_allocator<U, Alignment>;
+  };
+
+  constexpr aligned_allocator() noexcept = default;
+
+  template <typename U>
+  constexpr aligned_allocator(
+      const aligned_allocator<U, Alignment>&) noexcept {}
+
+  [[nodiscard]] auto allocate(const std::size_t n) -> T* {
+    return static_cast<T*>(::operator new(n * sizeof(T), alignment));
+  }
+
+  auto deallocate(T* const ptr, const std::size_t n) noexcept -> void {
+    ::operator delete(ptr, n * sizeof(T), alignment);
+  }
+
+  template <typename U>
+  constexpr auto operator==(
+      const aligned_allocator<U, Alignment>&) const noexcept -> bool {
+    return true;
+  }
+};
+
+}  // namespace nova
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace nova {
+
+/// @brief Bytes used by live data, and bytes allocated for it.
+struct MemoryUsage {
+  std::size_t used_bytes{};
+  std::size_t reserved_bytes{};
+
+  [[nodiscard]] constexpr auto wasted_bytes() const noexcept -> std::size_t {
+    return reserved_bytes - used_bytes;
+  }
+
+  constexpr auto operator+=(const MemoryUsage& other) noexcept
+      -> MemoryUsage& {
+    used_bytes += other.used_bytes;
+    reserved_bytes += other.reserved_bytes;
+    return *this;
+  }
+
+  constexpr auto operator==(const MemoryUsage&) const -> bool = default;
+};
+
+/// @brief The memory a `T` owns on the heap, on top of its `sizeof(T)`.
+/// Specialize it for the types that own memory to have it accounted for in
+/// the `MemoryStats`; types without a specialization own nothing.
+template <typename T>
+struct heap_usage {
+  constexpr auto operator()(const T&) const noexcept -> MemoryUsage {
+    return {};
+  }
+};
+
+// Only the element buffer is counted, not what the elements own.
+template <typename T, typename TAlloc>
+struct heap_usage<std::vector<T, TAlloc>> {
+  constexpr auto operator()(const std::vector<T, TAlloc>& vector) const noexcept
+      -> MemoryUsage {
+    return MemoryUsage{
+        .used_bytes = std::size(vector) * sizeof(T),
+        .reserved_bytes = vector.capacity() * sizeof(T),
+    };
+  }
+};
+
+template <typename TChar, typename TTraits, typename TAlloc>
+struct heap_usage<std::basic_string<TChar, TTraits, TAlloc>> {
+  constexpr auto operator()(
+      const std::basic_string<TChar, TTraits, TAlloc>& string) const noexcept
+      -> MemoryUsage {
+    // short strings are stored inline.
+    const auto* const first = reinterpret_cast<const std::byte*>(&string);
+    const auto* const data = reinterpret_cast<const std::byte*>(string.data());
+    if (data >= first and data < first + sizeof(string)) {
+      return {};
+    }
+    return MemoryUsage{
+        .used_bytes = (std::size(string) + 1u) * sizeof(TChar),
+        .reserved_bytes = (string.capacity() + 1u) * sizeof(TChar),
+    };
+  }
+};
+
+/// @brief The memory taken by `value`, inline and on the heap.
+template <typename T>
+[[nodiscard]] constexpr auto memory_usage_of(const T& value) -> MemoryUsage {
+  auto usage = heap_usage<T>{}(value);
+  usage += MemoryUsage{sizeof(T), sizeof(T)};
+  return usage;
+}
+
+}  // namespace nova
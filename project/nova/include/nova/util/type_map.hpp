@@ -79,6 +79,15 @@ class TypeMap {
   [[nodiscard]] auto cget() const -> tl::optional<T const &> {
     return get<T>();
   }
+
+  /// @brief Calls `func(type_id, value)` for every value, in no particular
+  /// order. `value` is the `void_ptr` holding the value.
+  template <typename TFunc>
+  auto for_each(TFunc &&func) const -> void {
+    for (const auto &[id, value] : map_) {
+      func(id, value);
+    }
+  }
 };
 
 }  // namespace nova
@@ -4,6 +4,7 @@
 #include <utility>
 
 #include "common.hpp"
+#include "memory_usage.hpp"
 
 namespace nova {
 
@@ -14,12 +15,19 @@ constexpr void delete_data(void* const ptr) {
   delete static_cast<T*>(ptr);
 }
 
+template <typename T>
+constexpr auto data_memory_usage(const void* const ptr) -> MemoryUsage {
+  return memory_usage_of(*static_cast<const T*>(ptr));
+}
+
 }  // namespace detail
 
 class void_ptr {
   using deleter_t = void (*)(void*);
+  using memory_usage_t = auto (*)(const void*) -> MemoryUsage;
   void* data_ = nullptr;
   deleter_t deleter_ = nullptr;
+  memory_usage_t memory_usage_ = nullptr;
 
   constexpr void destroy() {
     if (data_) {
@@ -32,7 +40,9 @@ class void_ptr {
 
   template <typename T, typename... Args>
   constexpr void_ptr(std::in_place_type_t<T>, Args&&... args)
-      : data_(new T(FWD(args)...)), deleter_(detail::delete_data<T>) {}
+      : data_(new T(FWD(args)...)),
+        deleter_(detail::delete_data<T>),
+        memory_usage_(detail::data_memory_usage<T>) {}
 
   template <typename T, typename... Args>
   [[nodiscard]] static constexpr auto create(Args&&... args) noexcept
@@ -43,21 +53,29 @@ class void_ptr {
   [[nodiscard]] constexpr auto take() noexcept -> void* {
     auto const ptr = std::exchange(data_, nullptr);
     deleter_ = nullptr;
+    memory_usage_ = nullptr;
     return ptr;
   }
 
+  /// @brief The memory taken by the pointee, see `heap_usage<T>`.
+  [[nodiscard]] constexpr auto memory_usage() const -> MemoryUsage {
+    return data_ ? memory_usage_(data_) : MemoryUsage{};
+  }
+
   constexpr auto data() noexcept -> void* { return data_; }
   constexpr auto data() const noexcept -> void const* { return data_; }
   constexpr auto cdata() const noexcept -> void const* { return data_; }
 
   constexpr void_ptr(void_ptr&& other) noexcept
       : data_(std::exchange(other.data_, nullptr)),
-        deleter_(std::exchange(other.deleter_, nullptr)) {}
+        deleter_(std::exchange(other.deleter_, nullptr)),
+        memory_usage_(std::exchange(other.memory_usage_, nullptr)) {}
 
   constexpr void_ptr& operator=(void_ptr&& other) noexcept {
     destroy();
     data_ = std::exchange(other.data_, nullptr);
     deleter_ = std::exchange(other.deleter_, nullptr);
+    memory_usage_ = std::exchange(other.memory_usage_, nullptr);
     return *this;
   }
 
@@ -0,0 +1,100 @@
+// Platform file access for `nova/asset/file_bytes.hpp`.
+
+#include "nova/asset/file_bytes.hpp"
+
+#include <format>
+#include <fstream>
+
+#include "nova/util/common.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define NOVA_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define NOVA_HAS_MMAP 0
+#endif
+
+namespace nova {
+
+namespace {
+
+auto read_buffer(const std::filesystem::path& path) -> FileBytes {
+  auto file = std::ifstream{path, std::ios::binary | std::ios::ate};
+  if (not file) {
+    throw nova_exception{
+        std::format("FileBytes: cannot open `{}`", path.string())};
+  }
+  const auto size = static_cast<std::size_t>(file.tellg());
+  auto buffer = std::vector<std::byte>(size);
+  file.seekg(0);
+  if (not file.read(reinterpret_cast<char*>(std::data(buffer)),
+                    static_cast<std::streamsize>(size))) {
+    throw nova_exception{
+        std::format("FileBytes: cannot read `{}`", path.string())};
+  }
+  return FileBytes{std::move(buffer)};
+}
+
+#if NOVA_HAS_MMAP
+// closes the descriptor on every path out of `read`.
+struct FileDescriptor {
+  int fd;
+  ~FileDescriptor() {
+    if (fd >= 0) {
+      ::close(fd);
+    }
+  }
+};
+#endif
+
+}  // namespace
+
+auto FileBytes::unmap() noexcept -> void {
+#if NOVA_HAS_MMAP
+  if (mapping_ != nullptr) {
+    ::munmap(mapping_, mapped_size_);
+  }
+#endif
+  mapping_ = nullptr;
+  mapped_size_ = 0u;
+}
+
+auto FileBytes::read(const std::filesystem::path& path,
+                     const std::size_t mmap_threshold) -> FileBytes {
+#if NOVA_HAS_MMAP
+  const auto file = FileDescriptor{::open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+  if (file.fd < 0) {
+    throw nova_exception{
+        std::format("FileBytes: cannot open `{}`", path.string())};
+  }
+
+  struct stat info {};
+  if (::fstat(file.fd, &info) != 0) {
+    throw nova_exception{
+        std::format("FileBytes: cannot stat `{}`", path.string())};
+  }
+
+  const auto size = static_cast<std::size_t>(info.st_size);
+  if (S_ISREG(info.st_mode) and size > 0u and size >= mmap_threshold) {
+    auto* const mapping =
+        ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file.fd, 0);
+    if (mapping != MAP_FAILED) {
+      // the whole file is about to be decoded front to back.
+      ::madvise(mapping, size, MADV_SEQUENTIAL);
+      auto bytes = FileBytes{};
+      bytes.mapping_ = mapping;
+      bytes.mapped_size_ = size;
+      return bytes;
+    }
+    // fall back on a plain read.
+  }
+#else
+  UNUSED(mmap_threshold);
+#endif
+  return read_buffer(path);
+}
+
+}  // namespace nova
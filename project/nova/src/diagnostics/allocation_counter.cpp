@@ -0,0 +1,184 @@
+// Per-thread allocation counts for `nova/diagnostics/allocation_counter.hpp`.
+// With `NOVA_TRACK_ALLOCATIONS`, the global allocation functions are replaced
+// to maintain them.
+
+#include "nova/diagnostics/allocation_counter.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace nova::detail {
+
+namespace {
+
+thread_local constinit AllocationCounts counts{};
+
+}  // namespace
+
+auto thread_allocation_counts() noexcept -> const AllocationCounts& {
+  return counts;
+}
+
+}  // namespace nova::detail
+
+#ifdef NOVA_TRACK_ALLOCATIONS
+
+namespace {
+
+using nova::detail::counts;
+
+auto try_allocate(const std::size_t size, const std::size_t alignment) noexcept
+    -> void* {
+  const auto n = size == 0u ? std::size_t{1} : size;
+  if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+    return std::malloc(n);
+  }
+#ifdef _WIN32
+  return _aligned_malloc(n, alignment);
+#else
+  // the size must be a multiple of the alignment.
+  return std::aligned_alloc(alignment,
+                            (n + alignment - 1u) & ~(alignment - 1u));
+#endif
+}
+
+auto allocate(const std::size_t size, const std::size_t alignment) -> void* {
+  for (;;) {
+    if (auto* const ptr = try_allocate(size, alignment); ptr != nullptr) {
+      ++counts.allocations;
+      counts.bytes += size;
+      return ptr;
+    }
+    if (const auto handler = std::get_new_handler(); handler != nullptr) {
+      handler();
+    } else {
+      throw std::bad_alloc{};
+    }
+  }
+}
+
+auto allocate_nothrow(const std::size_t size,
+                      const std::size_t alignment) noexcept -> void* {
+  try {
+    return allocate(size, alignment);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+auto release(void* const ptr, const std::size_t alignment) noexcept -> void {
+  if (ptr == nullptr) {
+    return;
+  }
+  ++counts.deallocations;
+#ifdef _WIN32
+  if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+    _aligned_free(ptr);
+    return;
+  }
+#endif
+  static_cast<void>(alignment);
+  std::free(ptr);
+}
+
+constexpr auto default_alignment =
+    std::size_t{__STDCPP_DEFAULT_NEW_ALIGNMENT__};
+
+}  // namespace
+
+auto operator new(const std::size_t size) -> void* {
+  return allocate(size, default_alignment);
+}
+
+auto operator new[](const std::size_t size) -> void* {
+  return allocate(size, default_alignment);
+}
+
+auto operator new(const std::size_t size, const std::nothrow_t&) noexcept
+    -> void* {
+  return allocate_nothrow(size, default_alignment);
+}
+
+auto operator new[](const std::size_t size, const std::nothrow_t&) noexcept
+    -> void* {
+  return allocate_nothrow(size, default_alignment);
+}
+
+auto operator new(const std::size_t size, const std::align_val_t alignment)
+    -> void* {
+  return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+auto operator new[](const std::size_t size, const std::align_val_t alignment)
+    -> void* {
+  return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+auto operator new(const std::size_t size, const std::align_val_t alignment,
+                  const std::nothrow_t&) noexcept -> void* {
+  return allocate_nothrow(size, static_cast<std::size_t>(alignment));
+}
+
+auto operator new[](const std::size_t size, const std::align_val_t alignment,
+                    const std::nothrow_t&) noexcept -> void* {
+  return allocate_nothrow(size, static_cast<std::size_t>(alignment));
+}
+
+auto operator delete(void* const ptr) noexcept -> void {
+  release(ptr, default_alignment);
+}
+
+auto operator delete[](void* const ptr) noexcept -> void {
+  release(ptr, default_alignment);
+}
+
+auto operator delete(void* const ptr, const std::nothrow_t&) noexcept
+    -> void {
+  release(ptr, default_alignment);
+}
+
+auto operator delete[](void* const ptr, const std::nothrow_t&) noexcept
+    -> void {
+  release(ptr, default_alignment);
+}
+
+auto operator delete(void* const ptr, std::size_t) noexcept -> void {
+  release(ptr, default_alignment);
+}
+
+auto operator delete[](void* const ptr, std::size_t) noexcept -> void {
+  release(ptr, default_alignment);
+}
+
+auto operator delete(void* const ptr, const std::align_val_t alignment) noexcept
+    -> void {
+  release(ptr, static_cast<std::size_t>(alignment));
+}
+
+auto operator delete[](void* const ptr,
+                       const std::align_val_t alignment) noexcept -> void {
+  release(ptr, static_cast<std::size_t>(alignment));
+}
+
+auto operator delete(void* const ptr, std::size_t,
+                     const std::align_val_t alignment) noexcept -> void {
+  release(ptr, static_cast<std::size_t>(alignment));
+}
+
+auto operator delete[](void* const ptr, std::size_t,
+                       const std::align_val_t alignment) noexcept -> void {
+  release(ptr, static_cast<std::size_t>(alignment));
+}
+
+auto operator delete(void* const ptr, const std::align_val_t alignment,
+                     const std::nothrow_t&) noexcept -> void {
+  release(ptr, static_cast<std::size_t>(alignment));
+}
+
+auto operator delete[](void* const ptr, const std::align_val_t alignment,
+                       const std::nothrow_t&) noexcept -> void {
+  release(ptr, static_cast<std::size_t>(alignment));
+}
+
+#endif
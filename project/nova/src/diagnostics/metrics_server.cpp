@@ -0,0 +1,240 @@
+// The HTTP side of `nova/diagnostics/metrics_server.hpp`.
+//
+// Only what a Prometheus scraper needs: `GET /metrics` over HTTP/1.x, one
+// request per connection, answered from the latest published snapshot.
+
+#include "nova/diagnostics/metrics_server.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <format>
+#include <string>
+#include <system_error>
+
+#include "nova/util/common.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define NOVA_METRICS_POSIX 1
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#else
+#define NOVA_METRICS_POSIX 0
+#endif
+
+namespace nova {
+
+#if NOVA_METRICS_POSIX
+
+namespace {
+
+// how often the server thread checks for a stop request.
+constexpr auto poll_interval_ms = 100;
+// how long a client may take to send its request.
+constexpr auto request_timeout_ms = 1'000;
+// how long a client may take to read the response, so that a stalled one
+// cannot hold the server thread, nor `stop()`.
+constexpr auto response_timeout = std::chrono::milliseconds{1'000};
+constexpr auto max_request_size = std::size_t{8'192};
+
+// sends never block: `send_all` polls for room instead.
+#ifdef MSG_NOSIGNAL
+constexpr auto send_flags = MSG_NOSIGNAL | MSG_DONTWAIT;
+#else
+constexpr auto send_flags = MSG_DONTWAIT;
+#endif
+
+[[noreturn]] auto throw_errno(const std::string_view call, const int error)
+    -> void {
+  throw nova_exception{std::format("MetricsServer: {} failed: {}", call,
+                                   std::generic_category().message(error))};
+}
+
+// reads the request line and headers, up to the blank line ending them.
+auto read_request(const int client, std::string& request) -> bool {
+  request.clear();
+  auto buffer = std::array<char, 1'024>{};
+  while (request.find("\r\n\r\n") == std::string::npos) {
+    auto pfd = pollfd{.fd = client, .events = POLLIN, .revents = 0};
+    if (::poll(&pfd, 1u, request_timeout_ms) <= 0) {
+      return false;
+    }
+    const auto n = ::recv(client, buffer.data(), std::size(buffer), 0);
+    if (n < 0 and errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    request.append(buffer.data(), static_cast<std::size_t>(n));
+    if (std::size(request) > max_request_size) {
+      return false;
+    }
+  }
+  return true;
+}
+
+using deadline_t = std::chrono::steady_clock::time_point;
+
+// sends `data` unless the client fails to take it before `deadline`.
+auto send_all(const int client, const std::string_view data,
+              const deadline_t deadline) -> bool {
+  auto sent = std::size_t{0};
+  while (sent < std::size(data)) {
+    const auto left = std::chrono::ceil<std::chrono::milliseconds>(
+        deadline - std::chrono::steady_clock::now());
+    if (left.count() <= 0) {
+      return false;
+    }
+    auto pfd = pollfd{.fd = client, .events = POLLOUT, .revents = 0};
+    const auto ready = ::poll(&pfd, 1u, static_cast<int>(left.count()));
+    if (ready < 0 and errno == EINTR) {
+      continue;
+    }
+    if (ready <= 0) {
+      return false;
+    }
+    const auto n = ::send(client, data.data() + sent, std::size(data) - sent,
+                          send_flags);
+    if (n < 0 and (errno == EINTR or errno == EAGAIN or
+                   errno == EWOULDBLOCK)) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    sent += static_cast<std::size_t>(n);
+  }
+  return true;
+}
+
+auto respond(const int client, const std::string_view status,
+             const std::string_view content_type, const std::string_view body)
+    -> void {
+  const auto deadline = std::chrono::steady_clock::now() + response_timeout;
+  if (send_all(client,
+               std::format("HTTP/1.1 {}\r\nContent-Type: {}\r\n"
+                           "Content-Length: {}\r\nConnection: close\r\n\r\n",
+                           status, content_type, std::size(body)),
+               deadline)) {
+    send_all(client, body, deadline);
+  }
+}
+
+}  // namespace
+
+MetricsServer::MetricsServer(const std::uint16_t port,
+                             const std::chrono::nanoseconds period,
+                             const std::string_view address)
+    : period_(period) {
+  auto addr = sockaddr_in{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  if (const auto host = std::string{address};
+      ::inet_pton(AF_INET, host.c_str(), &addr.sin_addr) != 1) {
+    throw nova_exception{
+        std::format("MetricsServer: invalid IPv4 address `{}`", address)};
+  }
+
+  socket_ = ::socket(AF_INET, SOCK_STREAM, 0);
+  if (socket_ < 0) {
+    throw_errno("socket", errno);
+  }
+  const auto fail = [&](const std::string_view call) {
+    const auto error = errno;
+    ::close(socket_);
+    socket_ = -1;
+    throw_errno(call, error);
+  };
+
+  const auto reuse = 1;
+  ::setsockopt(socket_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+  if (::bind(socket_, reinterpret_cast<const sockaddr*>(&addr),
+             sizeof(addr)) != 0) {
+    fail("bind");
+  }
+  if (::listen(socket_, 16) != 0) {
+    fail("listen");
+  }
+  auto bound = sockaddr_in{};
+  auto length = socklen_t{sizeof(bound)};
+  if (::getsockname(socket_, reinterpret_cast<sockaddr*>(&bound), &length) !=
+      0) {
+    fail("getsockname");
+  }
+  port_ = ntohs(bound.sin_port);
+
+  thread_ = std::jthread{[this](const std::stop_token& stop) { serve(stop); }};
+}
+
+MetricsServer::~MetricsServer() { stop(); }
+
+auto MetricsServer::stop() -> void {
+  if (thread_.joinable()) {
+    thread_.request_stop();
+    thread_.join();
+  }
+  if (socket_ >= 0) {
+    ::close(socket_);
+    socket_ = -1;
+  }
+}
+
+auto MetricsServer::serve(const std::stop_token& stop) -> void {
+  auto request = std::string{};
+  auto body = std::string{};
+  while (not stop.stop_requested()) {
+    auto pfd = pollfd{.fd = socket_, .events = POLLIN, .revents = 0};
+    if (::poll(&pfd, 1u, poll_interval_ms) <= 0) {
+      continue;
+    }
+    const auto client = ::accept(socket_, nullptr, nullptr);
+    if (client < 0) {
+      continue;
+    }
+
+    if (read_request(client, request)) {
+      scrapes_.fetch_add(1u, std::memory_order_relaxed);
+      // the request line: `<method> <target> HTTP/<version>`.
+      const auto head = std::string_view{request};
+      const auto method_end = std::min(head.find(' '), std::size(head));
+      const auto method = head.substr(0u, method_end);
+      const auto rest = head.substr(std::min(method_end + 1u, std::size(head)));
+      const auto target = rest.substr(0u, rest.find_first_of(" ?\r"));
+      if (method != "GET") {
+        respond(client, "405 Method Not Allowed", "text/plain", "");
+      } else if (target != "/metrics") {
+        respond(client, "404 Not Found", "text/plain", "");
+      } else {
+        body.clear();
+        write_prometheus(body, latest());
+        respond(client, "200 OK", "text/plain; version=0.0.4; charset=utf-8",
+                body);
+      }
+    }
+    ::close(client);
+  }
+}
+
+#else
+
+MetricsServer::MetricsServer(const std::uint16_t,
+                             const std::chrono::nanoseconds period,
+                             const std::string_view)
+    : period_(period) {
+  throw nova_exception{"MetricsServer: only POSIX sockets are supported"};
+}
+
+MetricsServer::~MetricsServer() { stop(); }
+
+auto MetricsServer::stop() -> void {}
+
+auto MetricsServer::serve(const std::stop_token&) -> void {}
+
+#endif
+
+}  // namespace nova
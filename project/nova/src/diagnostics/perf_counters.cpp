@@ -0,0 +1,155 @@
+// Per-thread performance counters for `nova/diagnostics/perf_counters.hpp`.
+//
+// The counters of a thread form a single `perf_event_open` group, so one
+// `read` returns all of them at once. The first event the kernel accepts
+// leads the group; the events it refuses are left out.
+
+#include "nova/diagnostics/perf_counters.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <string>
+#include <system_error>
+
+#if defined(__linux__) && __has_include(<linux/perf_event.h>)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#ifdef SYS_perf_event_open
+#define NOVA_PERF_EVENTS 1
+#endif
+#endif
+#ifndef NOVA_PERF_EVENTS
+#define NOVA_PERF_EVENTS 0
+#endif
+
+namespace nova {
+
+namespace {
+
+#if NOVA_PERF_EVENTS
+
+struct EventConfig {
+  std::uint32_t type;
+  std::uint64_t config;
+};
+
+// in the order of `PerfEvent`.
+constexpr auto event_configs = std::array<EventConfig, perf_event_count>{
+    EventConfig{PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    EventConfig{PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    EventConfig{PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    EventConfig{PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    EventConfig{PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK},
+};
+
+auto open_event(const EventConfig& event, const int group) noexcept -> int {
+  auto attr = perf_event_attr{};
+  attr.size = sizeof(attr);
+  attr.type = event.type;
+  attr.config = event.config;
+  attr.read_format = PERF_FORMAT_GROUP;
+  attr.exclude_kernel = 1u;
+  attr.exclude_hv = 1u;
+  // the calling thread, on any CPU.
+  return static_cast<int>(
+      ::syscall(SYS_perf_event_open, &attr, 0, -1, group, 0ul));
+}
+
+class CounterGroup {
+  int leader_ = -1;
+  std::array<int, perf_event_count> fds_{};
+  // the events, in the order the group reads them.
+  std::array<std::size_t, perf_event_count> order_{};
+  std::size_t n_open_ = 0u;
+  PerfSupport support_{};
+
+ public:
+  CounterGroup() noexcept {
+    fds_.fill(-1);
+    for (auto i = std::size_t{0}; i < perf_event_count; ++i) {
+      const auto fd = open_event(event_configs[i], leader_);
+      if (fd < 0) {
+        if (std::empty(support_.error)) {
+          const auto error = errno;
+          try {
+            support_.error =
+                std::string{perf_event_name(static_cast<PerfEvent>(i))} +
+                ": perf_event_open failed: " +
+                std::generic_category().message(error);
+          } catch (...) {
+          }
+        }
+        continue;
+      }
+      if (leader_ < 0) {
+        leader_ = fd;
+      }
+      fds_[i] = fd;
+      order_[n_open_++] = i;
+      support_.available[i] = true;
+    }
+  }
+
+  CounterGroup(const CounterGroup&) = delete;
+  auto operator=(const CounterGroup&) -> CounterGroup& = delete;
+
+  ~CounterGroup() {
+    for (const auto fd : fds_) {
+      if (fd >= 0) {
+        ::close(fd);
+      }
+    }
+  }
+
+  [[nodiscard]] auto support() const noexcept -> const PerfSupport& {
+    return support_;
+  }
+
+  [[nodiscard]] auto read() const noexcept -> PerfCounts {
+    auto counts = PerfCounts{};
+    if (leader_ < 0) {
+      return counts;
+    }
+    // `{nr, values[nr]}` with `PERF_FORMAT_GROUP`.
+    auto buffer = std::array<std::uint64_t, perf_event_count + 1u>{};
+    const auto n = ::read(leader_, buffer.data(), sizeof(buffer));
+    if (n < static_cast<ssize_t>(sizeof(std::uint64_t))) {
+      return counts;
+    }
+    const auto nr = std::min<std::size_t>(buffer[0], n_open_);
+    for (auto i = std::size_t{0}; i < nr; ++i) {
+      counts.values[order_[i]] = buffer[i + 1u];
+    }
+    return counts;
+  }
+};
+
+auto thread_group() noexcept -> const CounterGroup& {
+  thread_local const auto group = CounterGroup{};
+  return group;
+}
+
+#endif
+
+}  // namespace
+
+auto perf_support() -> PerfSupport {
+#if NOVA_PERF_EVENTS
+  return thread_group().support();
+#else
+  return PerfSupport{.error = "perf counters are only supported on Linux"};
+#endif
+}
+
+auto read_perf_counters() noexcept -> PerfCounts {
+#if NOVA_PERF_EVENTS
+  return thread_group().read();
+#else
+  return {};
+#endif
+}
+
+}  // namespace nova
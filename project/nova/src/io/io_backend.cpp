@@ -0,0 +1,492 @@
+// Backends for `nova/io/io_backend.hpp`.
+//
+// io_uring is driven through its raw system calls rather than liburing, so
+// the library has no extra dependency and falls back on the threaded
+// backend wherever the system calls are missing or forbidden.
+
+#include "nova/io/io_backend.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <deque>
+#include <format>
+#include <memory>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "nova/task/task_pool.hpp"
+#include "nova/task/task_set.hpp"
+#include "nova/util/common.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define NOVA_IO_POSIX 1
+#include <unistd.h>
+#else
+#define NOVA_IO_POSIX 0
+#include <io.h>
+
+#include <mutex>
+#endif
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && \
+    defined(IORING_FEAT_NODROP)
+#define NOVA_IO_URING 1
+#endif
+#endif
+#ifndef NOVA_IO_URING
+#define NOVA_IO_URING 0
+#endif
+
+namespace nova {
+
+namespace {
+
+// --- threaded backend ------------------------------------------------------
+
+// Transfers the whole operation, unless it fails or reaches the end of the
+// file, and returns the number of bytes transferred or a negated `errno`.
+auto run_blocking(const detail::IoOp& op) noexcept -> std::int32_t {
+  auto done = std::uint32_t{0};
+  while (done < op.size) {
+#if NOVA_IO_POSIX
+    const auto offset = static_cast<off_t>(op.offset + done);
+    const auto n =
+        op.kind == detail::IoOpKind::read
+            ? ::pread(op.fd, op.data + done, op.size - done, offset)
+            : ::pwrite(op.fd, op.data + done, op.size - done, offset);
+#else
+    // there is no positional read on Windows: seek and transfer atomically.
+    static auto mutex = std::mutex{};
+    const auto lock = std::scoped_lock{mutex};
+    ::_lseeki64(op.fd, static_cast<long long>(op.offset + done), SEEK_SET);
+    const auto n = op.kind == detail::IoOpKind::read
+                       ? ::_read(op.fd, op.data + done, op.size - done)
+                       : ::_write(op.fd, op.data + done, op.size - done);
+#endif
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return -errno;
+    }
+    if (n == 0) {
+      break;
+    }
+    done += static_cast<std::uint32_t>(n);
+  }
+  return static_cast<std::int32_t>(done);
+}
+
+struct EventNode {
+  EventNode* next = nullptr;
+  detail::IoEvent event{};
+};
+
+class ThreadedBackend final : public detail::IoBackend {
+  using queue_t = detail::CompletionQueue<EventNode>;
+
+  TaskPool* pool_;
+  std::shared_ptr<queue_t> completions_{std::make_shared<queue_t>()};
+  std::size_t in_flight_ = 0u;
+
+ public:
+  explicit(true) ThreadedBackend(TaskPool* const pool) noexcept
+      : pool_(pool) {}
+
+  ~ThreadedBackend() override {
+    // the tasks write to buffers owned by the caller.
+    auto events = std::vector<detail::IoEvent>{};
+    while (in_flight_ > 0u) {
+      reap(events, true);
+    }
+  }
+
+  [[nodiscard]] auto name() const noexcept -> std::string_view override {
+    return pool_ != nullptr ? "threads" : "blocking";
+  }
+
+  auto submit(std::span<const detail::IoOp> ops) -> void override {
+    for (const auto& op : ops) {
+      if (pool_ == nullptr) {
+        completions_->push(new EventNode{
+            .event = detail::IoEvent{op.id, run_blocking(op)},
+        });
+      } else {
+        pool_->spawn([op, completions = completions_] {
+          completions->push(new EventNode{
+              .event = detail::IoEvent{op.id, run_blocking(op)},
+          });
+        });
+      }
+      ++in_flight_;
+    }
+  }
+
+  auto reap(std::vector<detail::IoEvent>& out, const bool wait)
+      -> void override {
+    for (;;) {
+      auto* node = completions_->take_all();
+      if (node == nullptr and wait and in_flight_ > 0u) {
+        std::this_thread::yield();
+        continue;
+      }
+      while (node != nullptr) {
+        const auto done = std::unique_ptr<EventNode>{node};
+        node = node->next;
+        out.push_back(done->event);
+        --in_flight_;
+      }
+      return;
+    }
+  }
+
+  [[nodiscard]] auto in_flight() const noexcept -> std::size_t override {
+    return in_flight_;
+  }
+};
+
+// --- io_uring backend ------------------------------------------------------
+
+#if NOVA_IO_URING
+
+[[noreturn]] auto throw_errno(const std::string_view call, const int error)
+    -> void {
+  throw nova_exception{std::format("io_uring: {} failed: {}", call,
+                                   std::generic_category().message(error))};
+}
+
+// the ring's file descriptor, closed on destruction.
+class RingFd {
+  int fd_;
+
+ public:
+  explicit(true) RingFd(const int fd) noexcept : fd_(fd) {}
+  RingFd(RingFd const&) = delete;
+  RingFd& operator=(RingFd const&) = delete;
+  ~RingFd() { ::close(fd_); }
+
+  [[nodiscard]] auto get() const noexcept -> int { return fd_; }
+};
+
+// an mmap'd region of the ring, unmapped on destruction.
+class RingMapping {
+  void* data_ = MAP_FAILED;
+  std::size_t size_ = 0u;
+
+ public:
+  RingMapping() noexcept = default;
+  RingMapping(const int fd, const std::size_t size, const off_t offset)
+      : data_(::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, fd, offset)),
+        size_(size) {
+    if (data_ == MAP_FAILED) {
+      throw_errno("mmap", errno);
+    }
+  }
+
+  RingMapping(RingMapping&& other) noexcept
+      : data_(std::exchange(other.data_, MAP_FAILED)), size_(other.size_) {}
+  RingMapping& operator=(RingMapping&& other) noexcept {
+    if (this != &other) {
+      unmap();
+      data_ = std::exchange(other.data_, MAP_FAILED);
+      size_ = other.size_;
+    }
+    return *this;
+  }
+  RingMapping(RingMapping const&) = delete;
+  RingMapping& operator=(RingMapping const&) = delete;
+
+  ~RingMapping() { unmap(); }
+
+  auto unmap() noexcept -> void {
+    if (data_ != MAP_FAILED) {
+      ::munmap(data_, size_);
+      data_ = MAP_FAILED;
+    }
+  }
+
+  template <typename T>
+  [[nodiscard]] auto at(const std::uint32_t offset) const noexcept -> T* {
+    return reinterpret_cast<T*>(static_cast<std::byte*>(data_) + offset);
+  }
+};
+
+// An operation in the rings, resubmitted from where it stopped until its
+// whole buffer is transferred.
+struct UringTransfer {
+  detail::IoOp op{};
+  std::uint32_t done{};
+};
+
+class UringBackend final : public detail::IoBackend {
+  io_uring_params params_{};
+  RingFd ring_fd_;
+  RingMapping sq_ring_;
+  // only mapped separately on kernels without IORING_FEAT_SINGLE_MMAP.
+  RingMapping cq_ring_{};
+  RingMapping sqes_;
+
+  std::uint32_t* sq_head_;
+  std::uint32_t* sq_tail_;
+  std::uint32_t sq_mask_;
+  std::uint32_t* sq_array_;
+  io_uring_sqe* sqe_array_;
+  std::uint32_t* cq_head_;
+  std::uint32_t* cq_tail_;
+  std::uint32_t cq_mask_;
+  io_uring_cqe* cqes_;
+
+  // operations waiting for room in the rings.
+  std::deque<detail::IoOp> backlog_{};
+  // the operations in flight, by the index in the `user_data` of their
+  // entries. No more than the completion ring holds.
+  std::vector<UringTransfer> transfers_{};
+  std::vector<std::uint32_t> free_transfers_{};
+  // transfers cut short, waiting for room to submit the rest.
+  std::deque<std::uint32_t> retries_{};
+  // written to the submission ring, not yet passed to the kernel.
+  std::uint32_t unsubmitted_ = 0u;
+  std::size_t in_flight_ = 0u;
+
+  static auto setup(const std::uint32_t entries, io_uring_params& params)
+      -> int {
+    const auto fd = static_cast<int>(
+        ::syscall(__NR_io_uring_setup, entries, &params));
+    if (fd < 0) {
+      throw_errno("io_uring_setup", errno);
+    }
+    return fd;
+  }
+
+  auto enter(const std::uint32_t to_submit, const std::uint32_t min_complete,
+             const std::uint32_t flags) -> int {
+    for (;;) {
+      const auto n = ::syscall(__NR_io_uring_enter, ring_fd_.get(), to_submit,
+                               min_complete, flags, nullptr, 0);
+      if (n >= 0) {
+        return static_cast<int>(n);
+      }
+      if (errno == EINTR) {
+        continue;
+      }
+      // the kernel is short on resources: retry after reaping.
+      if (errno == EAGAIN or errno == EBUSY) {
+        return 0;
+      }
+      throw_errno("io_uring_enter", errno);
+    }
+  }
+
+  // writes the rest of `transfer` to the submission ring at `tail`.
+  auto prepare(const std::uint32_t tail, const std::uint32_t transfer) noexcept
+      -> void {
+    const auto& [op, done] = transfers_[transfer];
+    const auto index = tail & sq_mask_;
+    auto& sqe = sqe_array_[index];
+    sqe = io_uring_sqe{};
+    sqe.opcode =
+        op.kind == detail::IoOpKind::read ? IORING_OP_READ : IORING_OP_WRITE;
+    sqe.fd = op.fd;
+    sqe.off = op.offset + done;
+    sqe.addr = reinterpret_cast<std::uint64_t>(op.data + done);
+    sqe.len = op.size - done;
+    sqe.user_data = transfer;
+    sq_array_[index] = index;
+  }
+
+  // Moves the retries, then as much of the backlog as fits, into the
+  // submission ring, without ever having more operations in flight than the
+  // completion ring holds.
+  auto fill() noexcept -> void {
+    const auto head =
+        std::atomic_ref{*sq_head_}.load(std::memory_order_acquire);
+    auto tail = *sq_tail_;
+    while (not std::empty(retries_) and tail - head < params_.sq_entries) {
+      prepare(tail++, retries_.front());
+      retries_.pop_front();
+      ++unsubmitted_;
+    }
+    while (not std::empty(backlog_) and not std::empty(free_transfers_) and
+           tail - head < params_.sq_entries) {
+      const auto transfer = free_transfers_.back();
+      free_transfers_.pop_back();
+      transfers_[transfer] = UringTransfer{backlog_.front(), 0u};
+      prepare(tail++, transfer);
+      backlog_.pop_front();
+      ++unsubmitted_;
+      ++in_flight_;
+    }
+    // publishes the entries to the kernel.
+    std::atomic_ref{*sq_tail_}.store(tail, std::memory_order_release);
+  }
+
+  auto flush() -> void {
+    fill();
+    if (unsubmitted_ > 0u) {
+      unsubmitted_ -= static_cast<std::uint32_t>(enter(unsubmitted_, 0u, 0u));
+    }
+  }
+
+  auto reap_ring(std::vector<detail::IoEvent>& out, const bool wait)
+      -> void {
+    flush();
+    auto head = *cq_head_;
+    auto tail = std::atomic_ref{*cq_tail_}.load(std::memory_order_acquire);
+    if (head == tail and wait and in_flight_ > 0u) {
+      unsubmitted_ -= static_cast<std::uint32_t>(
+          enter(unsubmitted_, 1u, IORING_ENTER_GETEVENTS));
+      tail = std::atomic_ref{*cq_tail_}.load(std::memory_order_acquire);
+    }
+
+    for (; head != tail; ++head) {
+      const auto& cqe = cqes_[head & cq_mask_];
+      const auto index = static_cast<std::uint32_t>(cqe.user_data);
+      auto& transfer = transfers_[index];
+      // like a blocking transfer, a short one goes on until it fails or
+      // reaches the end of the file.
+      if (cqe.res > 0) {
+        transfer.done += static_cast<std::uint32_t>(cqe.res);
+      }
+      if ((cqe.res > 0 and transfer.done < transfer.op.size) or
+          cqe.res == -EINTR) {
+        retries_.push_back(index);
+        continue;
+      }
+      out.push_back(detail::IoEvent{
+          transfer.op.id,
+          cqe.res < 0 ? cqe.res : static_cast<std::int32_t>(transfer.done)});
+      free_transfers_.push_back(index);
+      --in_flight_;
+    }
+    // gives the entries back to the kernel.
+    std::atomic_ref{*cq_head_}.store(head, std::memory_order_release);
+
+    // completions made room for the backlog.
+    flush();
+  }
+
+ public:
+  explicit(true) UringBackend(const std::uint32_t entries)
+      : ring_fd_(setup(entries, params_)),
+        sq_ring_(ring_fd_.get(),
+                 params_.sq_off.array +
+                     params_.sq_entries * sizeof(std::uint32_t),
+                 IORING_OFF_SQ_RING),
+        sqes_(ring_fd_.get(), params_.sq_entries * sizeof(io_uring_sqe),
+              IORING_OFF_SQES) {
+    const auto cq_size =
+        params_.cq_off.cqes + params_.cq_entries * sizeof(io_uring_cqe);
+    const auto* cq_ring = &sq_ring_;
+    if ((params_.features & IORING_FEAT_SINGLE_MMAP) == 0u) {
+      cq_ring_ = RingMapping{ring_fd_.get(), cq_size, IORING_OFF_CQ_RING};
+      cq_ring = &cq_ring_;
+    }
+
+    sq_head_ = sq_ring_.at<std::uint32_t>(params_.sq_off.head);
+    sq_tail_ = sq_ring_.at<std::uint32_t>(params_.sq_off.tail);
+    sq_mask_ = *sq_ring_.at<std::uint32_t>(params_.sq_off.ring_mask);
+    sq_array_ = sq_ring_.at<std::uint32_t>(params_.sq_off.array);
+    sqe_array_ = sqes_.at<io_uring_sqe>(0u);
+    cq_head_ = cq_ring->at<std::uint32_t>(params_.cq_off.head);
+    cq_tail_ = cq_ring->at<std::uint32_t>(params_.cq_off.tail);
+    cq_mask_ = *cq_ring->at<std::uint32_t>(params_.cq_off.ring_mask);
+    cqes_ = cq_ring->at<io_uring_cqe>(params_.cq_off.cqes);
+
+    transfers_.resize(params_.cq_entries);
+    free_transfers_.reserve(params_.cq_entries);
+    for (auto i = params_.cq_entries; i > 0u; --i) {
+      free_transfers_.push_back(i - 1u);
+    }
+  }
+
+  UringBackend(UringBackend const&) = delete;
+  UringBackend& operator=(UringBackend const&) = delete;
+
+  ~UringBackend() override {
+    // the kernel writes to buffers owned by the caller.
+    try {
+      auto events = std::vector<detail::IoEvent>{};
+      backlog_.clear();
+      // the rest of a short transfer is not needed anymore.
+      in_flight_ -= std::size(retries_);
+      retries_.clear();
+      while (in_flight_ > 0u) {
+        reap(events, true);
+      }
+    } catch (...) {
+      // the ring is unusable, closing it cancels what is left.
+    }
+  }
+
+  // The operations the rings need: IORING_OP_READ and IORING_OP_WRITE came
+  // with Linux 5.6, and IORING_FEAT_NODROP with 5.5.
+  [[nodiscard]] auto supported() const noexcept -> bool {
+    return (params_.features & IORING_FEAT_NODROP) != 0u and
+           (params_.features & IORING_FEAT_FAST_POLL) != 0u;
+  }
+
+  [[nodiscard]] auto name() const noexcept -> std::string_view override {
+    return "io_uring";
+  }
+
+  auto submit(std::span<const detail::IoOp> ops) -> void override {
+    backlog_.insert(std::end(backlog_), std::begin(ops), std::end(ops));
+    flush();
+  }
+
+  auto reap(std::vector<detail::IoEvent>& out, const bool wait)
+      -> void override {
+    const auto n_events = std::size(out);
+    // a wait only ends with a completion, not with a transfer cut short.
+    do {
+      reap_ring(out, wait);
+    } while (wait and std::size(out) == n_events and in_flight_ > 0u);
+  }
+
+  [[nodiscard]] auto in_flight() const noexcept -> std::size_t override {
+    return in_flight_ + std::size(backlog_);
+  }
+};
+
+#endif
+
+}  // namespace
+
+auto make_uring_backend(const std::uint32_t entries)
+    -> std::unique_ptr<detail::IoBackend> {
+#if NOVA_IO_URING
+  try {
+    auto backend = std::make_unique<UringBackend>(entries);
+    if (backend->supported()) {
+      return backend;
+    }
+  } catch (const nova_exception&) {
+    // ENOSYS without io_uring, EPERM when a seccomp policy forbids it.
+  }
+#else
+  UNUSED(entries);
+#endif
+  return nullptr;
+}
+
+auto make_threaded_backend(TaskPool* const pool)
+    -> std::unique_ptr<detail::IoBackend> {
+  return std::make_unique<ThreadedBackend>(pool);
+}
+
+auto make_io_backend(TaskPool* const pool, const std::uint32_t entries)
+    -> std::unique_ptr<detail::IoBackend> {
+  if (auto backend = make_uring_backend(entries)) {
+    return backend;
+  }
+  return make_threaded_backend(pool);
+}
+
+}  // namespace nova
@@ -0,0 +1,97 @@
+// Platform file access for `nova/io/io_file.hpp`.
+
+#include "nova/io/io_file.hpp"
+
+#include <cerrno>
+#include <format>
+#include <system_error>
+
+#include "nova/util/common.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#endif
+
+namespace nova {
+
+namespace {
+
+[[noreturn]] auto fail(const std::string_view action,
+                       const std::filesystem::path& path) -> void {
+  throw nova_exception{std::format("IoFile: cannot {} `{}`: {}", action,
+                                   path.string(),
+                                   std::generic_category().message(errno))};
+}
+
+}  // namespace
+
+auto IoFile::close() noexcept -> void {
+  if (fd_ >= 0) {
+#if defined(__unix__) || defined(__APPLE__)
+    ::close(fd_);
+#else
+    ::_close(fd_);
+#endif
+    fd_ = -1;
+  }
+}
+
+auto IoFile::open(const std::filesystem::path& path, const IoMode mode)
+    -> IoFile {
+#if defined(__unix__) || defined(__APPLE__)
+  auto flags = O_CLOEXEC;
+  switch (mode) {
+    case IoMode::read:
+      flags |= O_RDONLY;
+      break;
+    case IoMode::write:
+      flags |= O_WRONLY | O_CREAT | O_TRUNC;
+      break;
+    case IoMode::read_write:
+      flags |= O_RDWR | O_CREAT;
+      break;
+  }
+  const auto fd = ::open(path.c_str(), flags, 0644);
+#else
+  auto flags = _O_BINARY;
+  switch (mode) {
+    case IoMode::read:
+      flags |= _O_RDONLY;
+      break;
+    case IoMode::write:
+      flags |= _O_WRONLY | _O_CREAT | _O_TRUNC;
+      break;
+    case IoMode::read_write:
+      flags |= _O_RDWR | _O_CREAT;
+      break;
+  }
+  const auto fd = ::_wopen(path.c_str(), flags, _S_IREAD | _S_IWRITE);
+#endif
+  if (fd < 0) {
+    fail("open", path);
+  }
+  return IoFile{fd};
+}
+
+auto IoFile::size() const -> std::uint64_t {
+#if defined(__unix__) || defined(__APPLE__)
+  struct stat info {};
+  if (::fstat(fd_, &info) != 0) {
+#else
+  struct _stat64 info {};
+  if (::_fstat64(fd_, &info) != 0) {
+#endif
+    throw nova_exception{
+        std::format("IoFile: cannot stat: {}",
+                    std::generic_category().message(errno))};
+  }
+  return static_cast<std::uint64_t>(info.st_size);
+}
+
+}  // namespace nova
@@ -0,0 +1,188 @@
+// Kernels for `nova/kinematics/simd.hpp`.
+//
+// This translation unit is compiled without floating point contraction (see
+// CMakeLists.txt) so the scalar path never turns `y + a * x` into a fused
+// multiply-add, which would round differently from the vector paths.
+
+#include "nova/kinematics/simd.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || \
+    defined(_M_IX86)
+#define NOVA_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && not defined(__clang__)
+#include <intrin.h>
+#endif
+#else
+#define NOVA_SIMD_X86 0
+#endif
+
+#if NOVA_SIMD_X86 and (defined(__GNUC__) or defined(__clang__))
+#define NOVA_SIMD_TARGET(isa) __attribute__((target(isa)))
+#else
+#define NOVA_SIMD_TARGET(isa)
+#endif
+
+namespace nova::simd {
+
+namespace {
+
+auto axpy_scalar(const float a, const float* const x, float* const y,
+                 const std::size_t n) noexcept -> void {
+  for (auto i = std::size_t{0}; i < n; ++i) {
+    y[i] = y[i] + a * x[i];
+  }
+}
+
+#if NOVA_SIMD_X86
+
+NOVA_SIMD_TARGET("sse2")
+auto axpy_sse2(const float a, const float* const x, float* const y,
+               const std::size_t n) noexcept -> void {
+  const auto va = _mm_set1_ps(a);
+  auto i = std::size_t{0};
+  for (; i + 4u <= n; i += 4u) {
+    const auto product = _mm_mul_ps(va, _mm_loadu_ps(x + i));
+    _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), product));
+  }
+  axpy_scalar(a, x + i, y + i, n - i);
+}
+
+NOVA_SIMD_TARGET("avx2")
+auto axpy_avx2(const float a, const float* const x, float* const y,
+               const std::size_t n) noexcept -> void {
+  const auto va = _mm256_set1_ps(a);
+  auto i = std::size_t{0};
+  for (; i + 16u <= n; i += 16u) {
+    const auto p0 = _mm256_mul_ps(va, _mm256_loadu_ps(x + i));
+    const auto p1 = _mm256_mul_ps(va, _mm256_loadu_ps(x + i + 8u));
+    _mm256_storeu_ps(y + i, _mm256_add_ps(_mm256_loadu_ps(y + i), p0));
+    _mm256_storeu_ps(y + i + 8u,
+                     _mm256_add_ps(_mm256_loadu_ps(y + i + 8u), p1));
+  }
+  for (; i + 8u <= n; i += 8u) {
+    const auto product = _mm256_mul_ps(va, _mm256_loadu_ps(x + i));
+    _mm256_storeu_ps(y + i, _mm256_add_ps(_mm256_loadu_ps(y + i), product));
+  }
+  axpy_scalar(a, x + i, y + i, n - i);
+}
+
+NOVA_SIMD_TARGET("avx512f")
+auto axpy_avx512(const float a, const float* const x, float* const y,
+                 const std::size_t n) noexcept -> void {
+  const auto va = _mm512_set1_ps(a);
+  auto i = std::size_t{0};
+  for (; i + 16u <= n; i += 16u) {
+    const auto product = _mm512_mul_ps(va, _mm512_loadu_ps(x + i));
+    _mm512_storeu_ps(y + i, _mm512_add_ps(_mm512_loadu_ps(y + i), product));
+  }
+  if (i < n) {
+    const auto mask = static_cast<__mmask16>((1u << (n - i)) - 1u);
+    const auto product = _mm512_mul_ps(va, _mm512_maskz_loadu_ps(mask, x + i));
+    _mm512_mask_storeu_ps(
+        y + i, mask,
+        _mm512_add_ps(_mm512_maskz_loadu_ps(mask, y + i), product));
+  }
+}
+
+auto cpu_supports(const Isa isa) noexcept -> bool {
+#if defined(__GNUC__) or defined(__clang__)
+  __builtin_cpu_init();
+  switch (isa) {
+    case Isa::scalar:
+      return true;
+    case Isa::sse2:
+      return __builtin_cpu_supports("sse2");
+    case Isa::avx2:
+      return __builtin_cpu_supports("avx2");
+    case Isa::avx512:
+      return __builtin_cpu_supports("avx512f");
+  }
+  return false;
+#else
+  int info[4]{};
+  __cpuid(info, 0);
+  const auto max_leaf = info[0];
+
+  __cpuid(info, 1);
+  const auto has_sse2 = (info[3] & (1 << 26)) != 0;
+  const auto has_osxsave = (info[2] & (1 << 27)) != 0;
+  // the OS must save the AVX (and AVX-512) registers on context switches.
+  const auto xcr0 = has_osxsave ? _xgetbv(0) : 0u;
+  const auto os_avx = (xcr0 & 0x6u) == 0x6u;
+  const auto os_avx512 = (xcr0 & 0xe6u) == 0xe6u;
+
+  auto ebx7 = 0;
+  if (max_leaf >= 7) {
+    __cpuidex(info, 7, 0);
+    ebx7 = info[1];
+  }
+
+  switch (isa) {
+    case Isa::scalar:
+      return true;
+    case Isa::sse2:
+      return has_sse2;
+    case Isa::avx2:
+      return os_avx and (ebx7 & (1 << 5)) != 0;
+    case Isa::avx512:
+      return os_avx512 and (ebx7 & (1 << 16)) != 0;
+  }
+  return false;
+#endif
+}
+
+#else
+
+auto cpu_supports(const Isa isa) noexcept -> bool {
+  return isa == Isa::scalar;
+}
+
+#endif
+
+}  // namespace
+
+auto supports(const Isa isa) noexcept -> bool {
+  static const bool supported[] = {
+      cpu_supports(Isa::scalar),
+      cpu_supports(Isa::sse2),
+      cpu_supports(Isa::avx2),
+      cpu_supports(Isa::avx512),
+  };
+  return supported[static_cast<std::size_t>(isa)];
+}
+
+auto best_isa() noexcept -> Isa {
+  static const auto best = [] {
+    for (const auto isa : {Isa::avx512, Isa::avx2, Isa::sse2}) {
+      if (supports(isa)) {
+        return isa;
+      }
+    }
+    return Isa::scalar;
+  }();
+  return best;
+}
+
+auto axpy(const Isa isa, const float a, const float* const x, float* const y,
+          const std::size_t n) noexcept -> void {
+  switch (isa) {
+#if NOVA_SIMD_X86
+    case Isa::sse2:
+      return axpy_sse2(a, x, y, n);
+    case Isa::avx2:
+      return axpy_avx2(a, x, y, n);
+    case Isa::avx512:
+      return axpy_avx512(a, x, y, n);
+#endif
+    default:
+      return axpy_scalar(a, x, y, n);
+  }
+}
+
+auto axpy(const float a, const float* const x, float* const y,
+          const std::size_t n) noexcept -> void {
+  axpy(best_isa(), a, x, y, n);
+}
+
+}  // namespace nova::simd
@@ -0,0 +1,278 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+// clang-format off
+#include <doctest/doctest.h>
+// clang-format on
+
+#include "nova/diagnostics/allocation_guard.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common.hpp"
+#include "nova/scheduler/scheduler.hpp"
+#include "nova/system/kernel.hpp"
+#include "nova/task/task_pool.hpp"
+#include "nova/system/system_builder.hpp"
+
+namespace {
+
+struct position {
+  float x{};
+};
+
+struct velocity {
+  float dx{};
+};
+
+struct step {
+  float dt{1.f};
+};
+
+auto integrate(nova::Resource<const step> s) {
+  return [dt = s->dt](const velocity& vel, position& pos) {
+    pos.x += vel.dx * dt;
+  };
+}
+
+auto damp(nova::Resource<const step>) {
+  return [](velocity& vel) { vel.dx *= 0.5f; };
+}
+
+auto count(nova::View<nova::With<const position>> view,
+           nova::Local<std::size_t> counted) -> void {
+  for (auto&& [_, pos] : view.each()) {
+    static_cast<void>(pos);
+    ++*counted;
+  }
+}
+
+// allocates every time it runs.
+struct leak {
+  auto operator()(nova::Local<std::vector<std::unique_ptr<int>>> leaked) const
+      -> void {
+    leaked->push_back(std::make_unique<int>(0));
+  }
+};
+
+auto make_world() -> nova::World {
+  auto world = nova::World{};
+  world.resources().set<step>();
+  auto& reg = world.registry();
+  for (auto i = 0; i < 1'000; ++i) {
+    const auto e = reg.create();
+    reg.emplace<position>(e);
+    reg.emplace<velocity>(e, velocity{.dx = 1.f});
+  }
+  return world;
+}
+
+auto make_scheduler() -> nova::Scheduler {
+  auto sched = test::observed_scheduler<nova::AllocationGuard>();
+  sched.add_system_to_stage(nova::kernel(damp).label("damp"), "update");
+  sched.add_system_to_stage(nova::kernel(integrate).after("damp"), "update");
+  sched.add_system_to_stage(count, "first");
+  sched.add_system_to_stage([](nova::Resource<step> s) { s->dt = 1.f; },
+                            "first");
+  return sched;
+}
+
+constexpr auto no_tracking = not nova::allocation_tracking_enabled;
+
+}  // namespace
+
+TEST_CASE("allocation counts add up") {
+  const auto a = nova::AllocationCounts{
+      .allocations = 3u, .deallocations = 1u, .bytes = 64u};
+  const auto b = nova::AllocationCounts{
+      .allocations = 1u, .deallocations = 1u, .bytes = 16u};
+  CHECK(a == (a + b) - b);
+  CHECK(4u == (a + b).allocations);
+  CHECK(48u == (a - b).bytes);
+}
+
+TEST_CASE("the guard reports allocations after the warm-up") {
+  auto reported = std::vector<nova::AllocationViolation>{};
+  auto guard = nova::AllocationGuard{
+      1u, nova::AllocationPolicy::report,
+      [&](const nova::AllocationViolation& violation) {
+        reported.push_back(violation);
+      }};
+
+  auto system = nova::detail::create_system([] {});
+  const auto systems = std::span{&system, 1u};
+  const auto allocation =
+      nova::AllocationCounts{.allocations = 1u, .bytes = 16u};
+
+  // the warm-up may allocate.
+  guard.begin_frame(1u);
+  guard.prepare_stage(0u, "update", systems);
+  guard.add_system(0u, 0u, allocation);
+  guard.end_frame();
+  CHECK(std::empty(guard.violations()));
+
+  guard.begin_frame(1u);
+  guard.prepare_stage(0u, "update", systems);
+  guard.end_frame();
+  CHECK(std::empty(guard.violations()));
+
+  guard.begin_frame(1u);
+  guard.prepare_stage(0u, "update", systems);
+  guard.add_system(0u, 0u, allocation);
+  guard.add_scheduler(0u, allocation);
+  guard.end_frame();
+
+  REQUIRE(2u == std::size(guard.violations()));
+  const auto& by_system = guard.violations()[0];
+  CHECK(2u == by_system.frame);
+  CHECK("update" == by_system.stage);
+  CHECK(system.meta.id.name() == by_system.system);
+  CHECK(allocation == by_system.counts);
+  CHECK(std::empty(guard.violations()[1].system));
+  CHECK(2u == std::size(reported));
+
+  const auto& stage = guard.stages()[0];
+  CHECK(2u == stage.stage.frame.allocations);
+  CHECK(3u == stage.stage.total.allocations);
+  CHECK(2u == stage.systems[0].total.allocations);
+
+  // only the last frame is kept.
+  guard.begin_frame(1u);
+  guard.prepare_stage(0u, "update", systems);
+  guard.add_scheduler(0u, allocation);
+  guard.end_frame();
+  REQUIRE(1u == std::size(guard.violations()));
+  CHECK(3u == guard.violations()[0].frame);
+  CHECK(3u == guard.violation_count());
+  CHECK(3u == std::size(reported));
+
+  guard.clear_violations();
+  CHECK(std::empty(guard.violations()));
+  CHECK(4u == guard.frames());
+}
+
+TEST_CASE("the guard panics on allocations") {
+  auto guard = nova::AllocationGuard{0u, nova::AllocationPolicy::panic};
+  auto system = nova::detail::create_system([] {});
+
+  guard.begin_frame(1u);
+  guard.prepare_stage(0u, "update", std::span{&system, 1u});
+  guard.end_frame();
+
+  guard.begin_frame(1u);
+  guard.prepare_stage(0u, "update", std::span{&system, 1u});
+  guard.add_system(0u, 0u, nova::AllocationCounts{.allocations = 1u});
+  CHECK_THROWS_AS(guard.end_frame(), nova::panic_exception);
+}
+
+TEST_CASE("the dispatch path does not allocate" *
+          doctest::skip(no_tracking)) {
+  auto world = make_world();
+  auto sched = make_scheduler();
+  sched.initialize_systems(world);
+  // the first frame creates the pools the views need.
+  sched.update(world);
+
+  const auto before = nova::allocation_counts();
+  for (auto i = 0; i < 100; ++i) {
+    sched.update(world);
+  }
+  CHECK(0u == (nova::allocation_counts() - before).allocations);
+
+  world.resources().set<nova::AllocationGuard>(1u);
+  for (auto i = 0; i < 10; ++i) {
+    sched.update(world);
+  }
+  const auto guard = *world.resources().get<nova::AllocationGuard>();
+  CHECK(10u == guard->frames());
+  CHECK(std::empty(guard->violations()));
+  REQUIRE(2u == std::size(guard->stages()));
+  for (const auto& stage : guard->stages()) {
+    CHECK(0u == stage.stage.frame.allocations);
+  }
+}
+
+TEST_CASE("the guard names the systems that allocate" *
+          doctest::skip(no_tracking)) {
+  auto world = make_world();
+  auto sched = make_scheduler();
+  sched.add_system_to_stage(leak{}, "update");
+  sched.initialize_systems(world);
+  world.resources().set<nova::AllocationGuard>(2u);
+
+  const auto guard = *world.resources().get<nova::AllocationGuard>();
+  for (auto frame = 0u; frame < 4u; ++frame) {
+    sched.update(world);
+    if (frame < 2u) {
+      CHECK(std::empty(guard->violations()));
+      continue;
+    }
+    REQUIRE(1u == std::size(guard->violations()));
+    const auto& violation = guard->violations()[0];
+    CHECK(frame == violation.frame);
+    CHECK("update" == violation.stage);
+    CHECK(nova::type_name<leak>() == violation.system);
+    CHECK(1u <= violation.counts.allocations);
+  }
+  CHECK(2u == guard->violation_count());
+
+  world.resources().set<nova::AllocationGuard>(
+      0u, nova::AllocationPolicy::panic);
+  CHECK_THROWS_AS(sched.update(world), nova::panic_exception);
+}
+
+TEST_CASE("parallel_for does not allocate" * doctest::skip(no_tracking)) {
+  auto pool = nova::TaskPool{2u};
+  auto sums = std::vector<std::size_t>(64u);
+  const auto fill = [&](const std::size_t i) { sums[i] = i; };
+  // the first run may start the workers' thread locals.
+  pool.parallel_for(std::size(sums), fill);
+
+  const auto before = nova::allocation_counts();
+  for (auto i = 0; i < 100; ++i) {
+    pool.parallel_for(std::size(sums), fill);
+    pool.parallel_for(std::size(sums), fill, [] {});
+  }
+  CHECK(0u == (nova::allocation_counts() - before).allocations);
+}
+
+TEST_CASE("parallel groups are dispatched without allocating" *
+          doctest::skip(no_tracking)) {
+  auto world = make_world();
+  auto sched = make_scheduler();
+  sched.initialize_systems(world);
+  auto pool = nova::TaskPool{2u};
+  sched.update(world, pool);
+
+  world.resources().set<nova::AllocationGuard>(1u);
+  for (auto i = 0; i < 50; ++i) {
+    sched.update(world, pool);
+  }
+  const auto guard = *world.resources().get<nova::AllocationGuard>();
+  CHECK(0u == guard->violation_count());
+  for (const auto& stage : guard->stages()) {
+    CHECK(0u == stage.scheduler.frame.allocations);
+  }
+}
+
+TEST_CASE("the guard follows systems run on the task pool" *
+          doctest::skip(no_tracking)) {
+  auto world = make_world();
+  auto sched = make_scheduler();
+  sched.add_system_to_stage(leak{}, "update");
+  sched.initialize_systems(world);
+  world.resources().set<nova::AllocationGuard>(0u);
+
+  auto pool = nova::TaskPool{2u};
+  sched.update(world, pool);
+
+  const auto guard = *world.resources().get<nova::AllocationGuard>();
+  const auto& stage = guard->stages()[1];
+  CHECK("update" == stage.stage.name);
+  auto systems = nova::AllocationCounts{};
+  for (const auto& system : stage.systems) {
+    systems += system.frame;
+  }
+  CHECK(1u <= systems.allocations);
+  CHECK(stage.stage.frame == systems + stage.scheduler.frame);
+}
@@ -0,0 +1,279 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+// clang-format off
+#include <doctest/doctest.h>
+// clang-format on
+
+#include "nova/asset/asset_server.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "nova/app/app.hpp"
+#include "nova/asset/asset_plugin.hpp"
+
+namespace {
+
+using namespace std::chrono_literals;
+
+// a directory of files removed with the fixture.
+class TempDir {
+  std::filesystem::path path_;
+
+ public:
+  TempDir()
+      : path_(std::filesystem::temp_directory_path() /
+              std::format("nova_asset_test_{}",
+                          std::hash<std::thread::id>{}(
+                              std::this_thread::get_id()))) {
+    std::filesystem::create_directories(path_);
+  }
+
+  TempDir(TempDir const&) = delete;
+  TempDir& operator=(TempDir const&) = delete;
+
+  ~TempDir() { std::filesystem::remove_all(path_); }
+
+  [[nodiscard]] auto path() const -> const std::filesystem::path& {
+    return path_;
+  }
+
+  auto write(const std::string& name, const std::string& content) const
+      -> std::filesystem::path {
+    const auto file = path_ / name;
+    std::ofstream{file, std::ios::binary} << content;
+    return file;
+  }
+};
+
+auto as_string(std::span<const std::byte> bytes) -> std::string {
+  return std::string{reinterpret_cast<const char*>(std::data(bytes)),
+                     std::size(bytes)};
+}
+
+auto text_loader(std::atomic<int>& n_loads) {
+  return [&n_loads](std::span<const std::byte> bytes,
+                    const std::filesystem::path&) {
+    ++n_loads;
+    return as_string(bytes);
+  };
+}
+
+// runs `update()` like the asset plugin would, once per "frame", until no
+// load is pending.
+auto settle(nova::AssetServer& server) -> void {
+  const auto deadline = std::chrono::steady_clock::now() + 5s;
+  server.update();
+  while (server.pending() > 0u and
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(1ms);
+    server.update();
+  }
+  REQUIRE(0u == server.pending());
+}
+
+}  // namespace
+
+TEST_CASE("file bytes are read or mapped") {
+  const auto dir = TempDir{};
+  const auto file = dir.write("data.txt", "hello assets");
+
+  const auto read = nova::FileBytes::read(file, 1'024u);
+  CHECK_FALSE(read.mapped());
+  CHECK("hello assets" == as_string(read.bytes()));
+
+  const auto mapped = nova::FileBytes::read(file, 1u);
+  CHECK(mapped.mapped());
+  CHECK("hello assets" == as_string(mapped.bytes()));
+
+  auto moved = nova::FileBytes{};
+  moved = nova::FileBytes::read(file, 1u);
+  CHECK(12u == moved.size());
+
+  CHECK_THROWS_AS(std::ignore = nova::FileBytes::read(dir.path() / "missing"),
+                  nova::nova_exception);
+}
+
+TEST_CASE("assets load in the background") {
+  const auto dir = TempDir{};
+  dir.write("a.txt", "first");
+  dir.write("b.txt", "second");
+
+  auto n_loads = std::atomic<int>{0};
+  auto pool = nova::TaskPool{2u};
+  auto server = nova::AssetServer{&pool, dir.path()};
+  server.register_loader<std::string>(text_loader(n_loads));
+
+  const auto a = server.load<std::string>("a.txt");
+  const auto b = server.load<std::string>("b.txt");
+  CHECK(a.valid());
+  CHECK(nova::AssetState::loading == server.state(a));
+  CHECK(nullptr == server.get(a));
+
+  settle(server);
+  CHECK(nova::AssetState::loaded == server.state(a));
+  REQUIRE(nullptr != server.get(a));
+  CHECK("first" == *server.get(a));
+  REQUIRE(nullptr != server.get(b));
+  CHECK("second" == *server.get(b));
+  CHECK(2 == n_loads);
+}
+
+TEST_CASE("loading a path twice shares the asset") {
+  const auto dir = TempDir{};
+  dir.write("a.txt", "first");
+
+  auto n_loads = std::atomic<int>{0};
+  auto server = nova::AssetServer{nullptr, dir.path()};
+  server.register_loader<std::string>(text_loader(n_loads));
+
+  const auto a = server.load<std::string>("a.txt");
+  const auto same = server.load<std::string>("./sub/../a.txt");
+  CHECK(a == same);
+  CHECK(1u == server.pending());
+
+  settle(server);
+  CHECK(server.get(a) == server.get(same));
+  CHECK(server.load<std::string>("a.txt") == a);
+  CHECK(1 == n_loads);
+}
+
+TEST_CASE("failed loads report their error") {
+  const auto dir = TempDir{};
+  dir.write("bad.txt", "bad");
+
+  auto server = nova::AssetServer{};
+  server.register_loader<std::string>(
+      [](std::span<const std::byte>, const std::filesystem::path&)
+          -> std::string { throw std::runtime_error{"corrupted"}; });
+
+  const auto missing = server.load<std::string>(dir.path() / "missing.txt");
+  const auto bad = server.load<std::string>(dir.path() / "bad.txt");
+  settle(server);
+
+  CHECK(nova::AssetState::failed == server.state(missing));
+  CHECK(nullptr == server.get(missing));
+  CHECK_FALSE(std::empty(server.error(missing)));
+  CHECK(nova::AssetState::failed == server.state(bad));
+  CHECK("corrupted" == server.error(bad));
+}
+
+TEST_CASE("assets are unloaded with their last handle") {
+  const auto dir = TempDir{};
+  dir.write("a.txt", "first");
+
+  auto n_loads = std::atomic<int>{0};
+  auto server = nova::AssetServer{nullptr, dir.path()};
+  server.register_loader<std::string>(text_loader(n_loads));
+
+  auto handle = server.load<std::string>("a.txt");
+  settle(server);
+  const auto id = handle.id();
+
+  auto copy = handle;
+  handle.reset();
+  server.update();
+  CHECK(nova::AssetState::loaded == server.state<std::string>(id));
+
+  std::thread{[dropped = std::move(copy)] {}}.join();
+  server.update();
+  CHECK(nova::AssetState::unloaded == server.state<std::string>(id));
+  CHECK(nullptr == server.get<std::string>(id));
+
+  // the slot is reused under a new generation.
+  const auto reloaded = server.load<std::string>("a.txt");
+  CHECK(id.index == reloaded.id().index);
+  CHECK(id.generation != reloaded.id().generation);
+  settle(server);
+  CHECK(nullptr == server.get<std::string>(id));
+  REQUIRE(nullptr != server.get(reloaded));
+  CHECK("first" == *server.get(reloaded));
+  CHECK(2 == n_loads);
+}
+
+TEST_CASE("handles may outlive their server") {
+  const auto dir = TempDir{};
+  dir.write("a.txt", "first");
+
+  auto n_loads = std::atomic<int>{0};
+  auto server = std::make_unique<nova::AssetServer>(nullptr, dir.path());
+  server->register_loader<std::string>(text_loader(n_loads));
+  auto handle = server->load<std::string>("a.txt");
+  settle(*server);
+  server.reset();
+
+  REQUIRE(handle.valid());
+  auto copy = handle;
+  CHECK(copy == handle);
+  handle.reset();
+  std::thread{[dropped = std::move(copy)] {}}.join();
+  CHECK_FALSE(handle.valid());
+}
+
+TEST_CASE("loads abandoned before they finish are dropped") {
+  const auto dir = TempDir{};
+  dir.write("a.txt", "first");
+
+  auto n_loads = std::atomic<int>{0};
+  auto server = nova::AssetServer{nullptr, dir.path()};
+  server.register_loader<std::string>(text_loader(n_loads));
+
+  const auto id = server.load<std::string>("a.txt").id();
+  server.update();
+  CHECK(0u == server.pending());
+  CHECK(nova::AssetState::unloaded == server.state<std::string>(id));
+
+  const auto deadline = std::chrono::steady_clock::now() + 5s;
+  while (n_loads == 0 and std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(1ms);
+  }
+  server.update();
+  CHECK(nova::AssetState::unloaded == server.state<std::string>(id));
+  CHECK(nullptr == server.get<std::string>(id));
+}
+
+TEST_CASE("assets need a loader") {
+  auto server = nova::AssetServer{};
+  CHECK_FALSE(server.has_loader<std::string>());
+  CHECK_THROWS_AS(std::ignore = server.load<std::string>("a.txt"),
+                  nova::nova_exception);
+
+  server.stop();
+  server.register_loader<int>(
+      [](std::span<const std::byte>, const std::filesystem::path&) {
+        return 0;
+      });
+  CHECK_THROWS_AS(std::ignore = server.load<int>("a.txt"),
+                  nova::nova_exception);
+}
+
+TEST_CASE("the asset plugin publishes loads every frame") {
+  const auto dir = TempDir{};
+  dir.write("a.txt", "first");
+
+  auto app = nova::App{};
+  app.add_default_stages()
+      .insert_resource<nova::AssetServer>(nullptr, dir.path())
+      .add_plugin(nova::AssetPlugin{});
+
+  auto n_loads = std::atomic<int>{0};
+  auto& server = **app.world.resources().get<nova::AssetServer>();
+  server.register_loader<std::string>(text_loader(n_loads));
+  const auto handle = server.load<std::string>("a.txt");
+
+  app.scheduler.initialize_systems(app.world);
+  const auto deadline = std::chrono::steady_clock::now() + 5s;
+  while (server.get(handle) == nullptr and
+         std::chrono::steady_clock::now() < deadline) {
+    app.update();
+    std::this_thread::sleep_for(1ms);
+  }
+  REQUIRE(nullptr != server.get(handle));
+  CHECK("first" == *server.get(handle));
+}
@@ -0,0 +1,139 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+// clang-format off
+#include <doctest/doctest.h>
+// clang-format on
+
+#include "nova/collision/broadphase.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+
+using collider_view_t =
+    nova::View<nova::With<const nova::Position, const nova::CircleCollider>>;
+
+auto make_view(entt::registry& reg) -> collider_view_t {
+  return collider_view_t{
+      reg.view<const nova::Position, const nova::CircleCollider>()};
+}
+
+auto spawn_random(entt::registry& reg, const std::size_t n, const float extent)
+    -> void {
+  auto gen = std::mt19937{42u};
+  auto distrib = std::uniform_real_distribution<float>{-extent, extent};
+  for (auto i = std::size_t{0}; i < n; ++i) {
+    const auto e = reg.create();
+    reg.emplace<nova::Position>(e, distrib(gen), distrib(gen));
+    reg.emplace<nova::CircleCollider>(e, 2.f);
+  }
+}
+
+auto normalized(std::vector<nova::CandidatePair> pairs)
+    -> std::vector<nova::CandidatePair> {
+  for (auto& pair : pairs) {
+    if (pair.second < pair.first) {
+      std::swap(pair.first, pair.second);
+    }
+  }
+  std::ranges::sort(pairs, {}, [](const auto& pair) {
+    return std::pair{pair.first, pair.second};
+  });
+  return pairs;
+}
+
+auto brute_force(entt::registry& reg) -> std::vector<nova::CandidatePair> {
+  auto pairs = std::vector<nova::CandidatePair>{};
+  const auto view =
+      reg.view<const nova::Position, const nova::CircleCollider>();
+  for (const auto a : view) {
+    for (const auto b : view) {
+      if (not(a < b)) {
+        continue;
+      }
+      const auto& [pa, ca] = view.get(a);
+      const auto& [pb, cb] = view.get(b);
+      // same arithmetic as the boxes, so both agree on touching boxes.
+      if (pb.x - cb.radius <= pa.x + ca.radius and
+          pa.x - ca.radius <= pb.x + cb.radius and
+          pb.y - cb.radius <= pa.y + ca.radius and
+          pa.y - ca.radius <= pb.y + cb.radius) {
+        pairs.push_back(nova::CandidatePair{a, b});
+      }
+    }
+  }
+  return normalized(pairs);
+}
+
+}  // namespace
+
+TEST_CASE("sweep and prune finds the overlapping boxes") {
+  auto reg = entt::registry{};
+  spawn_random(reg, 1'000, 100.f);
+
+  auto sap = nova::SweepAndPrune{};
+  auto pairs = std::vector<nova::CandidatePair>{};
+  sap.update(make_view(reg));
+  sap.find_pairs(pairs);
+
+  CHECK(std::ranges::is_sorted(sap.boxes(), {},
+                               &nova::SweepAndPrune::Box::min_x));
+  CHECK(brute_force(reg) == normalized(pairs));
+}
+
+TEST_CASE("sweep and prune follows moved, added and removed entities") {
+  auto reg = entt::registry{};
+  spawn_random(reg, 500, 50.f);
+
+  auto sap = nova::SweepAndPrune{};
+  auto pairs = std::vector<nova::CandidatePair>{};
+  sap.update(make_view(reg));
+
+  auto gen = std::mt19937{1u};
+  auto step = std::uniform_real_distribution<float>{-1.f, 1.f};
+  for (auto frame = 0; frame < 5; ++frame) {
+    for (auto&& [e, pos] : reg.view<nova::Position>().each()) {
+      pos.x += step(gen);
+      pos.y += step(gen);
+    }
+
+    // one entity leaves, another one loses its collider and a new one joins.
+    reg.destroy(reg.view<nova::Position>().front());
+    reg.remove<nova::CircleCollider>(reg.view<nova::CircleCollider>().back());
+    const auto joined = reg.create();
+    reg.emplace<nova::Position>(joined, 0.f, 0.f);
+    reg.emplace<nova::CircleCollider>(joined, 5.f);
+
+    sap.update(make_view(reg));
+    sap.find_pairs(pairs);
+
+    CHECK(reg.view<nova::CircleCollider>().size() == std::size(sap.boxes()));
+    CHECK(brute_force(reg) == normalized(pairs));
+  }
+}
+
+TEST_CASE("a parallel sweep finds the same pairs in the same order") {
+  auto reg = entt::registry{};
+  spawn_random(reg, 20'000, 400.f);
+
+  auto sap = nova::SweepAndPrune{};
+  sap.update(make_view(reg));
+
+  auto pool = nova::TaskPool{4u};
+  auto serial = std::vector<nova::CandidatePair>{};
+  auto parallel = std::vector<nova::CandidatePair>{};
+  sap.find_pairs(serial);
+  sap.find_pairs(parallel, &pool);
+
+  CHECK_FALSE(std::empty(serial));
+  CHECK(serial == parallel);
+}
+
+TEST_CASE("collision pairs can be taken") {
+  auto pairs = nova::CollisionPairs{};
+  pairs.pairs.push_back(nova::CandidatePair{});
+  const auto taken = pairs.take();
+  CHECK(1u == std::size(taken));
+  CHECK(std::empty(pairs.pairs));
+}
@@ -0,0 +1,107 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+// clang-format off
+#include <doctest/doctest.h>
+// clang-format on
+
+#include "nova/render/circle.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+auto make_circles(const std::size_t n) -> std::vector<nova::CircleInstance> {
+  auto circles = std::vector<nova::CircleInstance>{};
+  for (auto i = std::size_t{0}; i < n; ++i) {
+    const auto f = static_cast<float>(i);
+    circles.push_back(nova::CircleInstance{
+        .x = f,
+        .y = -f,
+        .radius = 1.f + f * 0.01f,
+        .color = nova::Color{.r = static_cast<std::uint8_t>(i)},
+    });
+  }
+  return circles;
+}
+
+}  // namespace
+
+TEST_CASE("circles are tessellated into a triangle fan") {
+  auto batch = nova::CircleBatch{4u};
+  const auto circle = nova::CircleInstance{
+      .x = 10.f,
+      .y = 20.f,
+      .radius = 2.f,
+      .color = nova::Color{.r = 1u, .g = 2u, .b = 3u},
+  };
+  batch.build(std::span{&circle, 1u});
+
+  const auto vertices = batch.vertices();
+  REQUIRE(12u == std::size(vertices));
+  for (auto triangle = std::size_t{0}; triangle < 4u; ++triangle) {
+    const auto& center = vertices[3u * triangle];
+    CHECK(10.f == center.x);
+    CHECK(20.f == center.y);
+
+    for (const auto& vertex : vertices.subspan(3u * triangle + 1u, 2u)) {
+      CHECK(doctest::Approx(2.f) ==
+            std::hypot(vertex.x - circle.x, vertex.y - circle.y));
+    }
+    // consecutive triangles share an edge.
+    const auto& next = vertices[3u * ((triangle + 1u) % 4u) + 1u];
+    CHECK(doctest::Approx(next.x) == vertices[3u * triangle + 2u].x);
+    CHECK(doctest::Approx(next.y) == vertices[3u * triangle + 2u].y);
+  }
+  for (const auto& vertex : vertices) {
+    CHECK(circle.color == vertex.color);
+  }
+}
+
+TEST_CASE("a parallel build writes the same vertices") {
+  const auto circles = make_circles(10'000);
+
+  auto serial = nova::CircleBatch{};
+  serial.build(circles);
+  REQUIRE(std::size(circles) * serial.vertices_per_circle() ==
+          std::size(serial.vertices()));
+
+  auto pool = nova::TaskPool{4u};
+  auto parallel = nova::CircleBatch{};
+  parallel.build(circles, &pool);
+  REQUIRE(std::size(serial.vertices()) == std::size(parallel.vertices()));
+  CHECK(0 == std::memcmp(std::data(serial.vertices()),
+                         std::data(parallel.vertices()),
+                         std::size(serial.vertices()) * sizeof(nova::Vertex)));
+
+  // rebuilding with fewer circles shrinks the batch.
+  parallel.build(std::span{circles}.first(10u), &pool);
+  CHECK(10u * parallel.vertices_per_circle() == std::size(parallel.vertices()));
+}
+
+TEST_CASE("circles are extracted from their position and circle") {
+  using circle_view_t =
+      nova::View<nova::With<const nova::Position, const nova::Circle>>;
+
+  auto reg = entt::registry{};
+  const auto drawn = reg.create();
+  reg.emplace<nova::Position>(drawn, 1.f, 2.f);
+  reg.emplace<nova::Circle>(drawn, 3.f, nova::Color{.g = 255u});
+  // not drawable without a circle.
+  reg.emplace<nova::Position>(reg.create());
+
+  auto instances = std::vector<nova::CircleInstance>{};
+  nova::gather_circles(
+      circle_view_t{reg.view<const nova::Position, const nova::Circle>()},
+      instances);
+
+  REQUIRE(1u == std::size(instances));
+  CHECK(1.f == instances[0].x);
+  CHECK(2.f == instances[0].y);
+  CHECK(3.f == instances[0].radius);
+  CHECK(nova::Color{.g = 255u} == instances[0].color);
+}
+
+TEST_CASE("a circle needs at least three segments") {
+  CHECK_THROWS_AS(nova::CircleBatch{2u}, nova::nova_exception);
+}
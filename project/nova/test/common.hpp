@@ -4,6 +4,8 @@
 #include <numeric>
 #include <ranges>
 
+#include "nova/scheduler/scheduler.hpp"
+
 namespace test {
 
 template <std::ranges::range TRange>
@@ -30,4 +32,14 @@ constexpr auto equals_unordered(const TFirst& first, const TSecond& second)
   });
 }
 
+// the stages "first" and "update", in that order, reported to `TObserver`.
+template <typename TObserver>
+auto observed_scheduler() -> nova::Scheduler {
+  auto sched = nova::Scheduler{};
+  sched.add_stage("first");
+  sched.add_stage(nova::stage("update").after("first"));
+  sched.observe<TObserver>();
+  return sched;
+}
+
 }  // namespace test
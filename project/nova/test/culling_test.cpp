@@ -0,0 +1,98 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+// clang-format off
+#include <doctest/doctest.h>
+// clang-format on
+
+#include "nova/render/culling.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+using circle_view_t =
+    nova::View<nova::With<const nova::Position, const nova::Circle>>;
+
+auto circle_view(entt::registry& reg) -> circle_view_t {
+  return circle_view_t{reg.view<const nova::Position, const nova::Circle>()};
+}
+
+auto spawn(entt::registry& reg, const float x, const float y,
+           const float radius) -> entt::entity {
+  const auto e = reg.create();
+  reg.emplace<nova::Position>(e, x, y);
+  reg.emplace<nova::Circle>(e, radius);
+  return e;
+}
+
+}  // namespace
+
+TEST_CASE("circles overlapping the viewport are visible") {
+  auto reg = entt::registry{};
+  const auto inside = spawn(reg, 50.f, 50.f, 1.f);
+  const auto overlapping = spawn(reg, -5.f, 50.f, 10.f);
+  const auto touching = spawn(reg, 110.f, 50.f, 10.f);
+  spawn(reg, -20.f, 50.f, 10.f);
+  spawn(reg, 50.f, 200.f, 10.f);
+  spawn(reg, 500.f, 500.f, 1.f);
+
+  auto visible = std::vector<entt::entity>{};
+  nova::cull(circle_view(reg),
+             nova::Viewport{.min_x = 0.f,
+                            .min_y = 0.f,
+                            .max_x = 100.f,
+                            .max_y = 100.f},
+             visible);
+
+  std::ranges::sort(visible);
+  CHECK(std::vector{inside, overlapping, touching} == visible);
+}
+
+TEST_CASE("culling matches a per entity test") {
+  auto reg = entt::registry{};
+  for (auto i = 0; i < 10'000; ++i) {
+    spawn(reg, static_cast<float>(i % 97) * 7.f - 100.f,
+          static_cast<float>(i % 89) * 9.f - 100.f,
+          static_cast<float>(i % 7));
+    // entities without a circle are filtered out of the view.
+    reg.emplace<nova::Position>(reg.create());
+  }
+  const auto viewport = nova::Viewport{
+      .min_x = 0.f, .min_y = 0.f, .max_x = 400.f, .max_y = 300.f};
+
+  auto visible = std::vector<entt::entity>{};
+  nova::cull(circle_view(reg), viewport, visible);
+
+  auto expected = std::vector<entt::entity>{};
+  for (const auto [e, pos, circle] : circle_view(reg).each()) {
+    if (pos.x + circle.radius >= viewport.min_x and
+        pos.x - circle.radius <= viewport.max_x and
+        pos.y + circle.radius >= viewport.min_y and
+        pos.y - circle.radius <= viewport.max_y) {
+      expected.push_back(e);
+    }
+  }
+  REQUIRE(not std::empty(expected));
+
+  std::ranges::sort(visible);
+  std::ranges::sort(expected);
+  CHECK(expected == visible);
+}
+
+TEST_CASE("only visible circles are gathered") {
+  auto reg = entt::registry{};
+  spawn(reg, -50.f, 0.f, 1.f);
+  const auto visible = spawn(reg, 5.f, 6.f, 2.f);
+
+  auto entities = std::vector<entt::entity>{};
+  nova::cull(circle_view(reg),
+             nova::Viewport{.max_x = 10.f, .max_y = 10.f}, entities);
+  REQUIRE(std::vector{visible} == entities);
+
+  auto instances = std::vector<nova::CircleInstance>{};
+  nova::gather_circles(circle_view(reg), entities, instances);
+  REQUIRE(1u == std::size(instances));
+  CHECK(5.f == instances[0].x);
+  CHECK(6.f == instances[0].y);
+  CHECK(2.f == instances[0].radius);
+}
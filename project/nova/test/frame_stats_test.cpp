@@ -0,0 +1,179 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+// clang-format off
+#include <doctest/doctest.h>
+// clang-format on
+
+#include "nova/diagnostics/frame_stats.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "common.hpp"
+#include "nova/scheduler/scheduler.hpp"
+#include "nova/system/system_builder.hpp"
+
+namespace {
+
+using namespace std::chrono_literals;
+
+auto make_scheduler() -> nova::Scheduler {
+  auto sched = test::observed_scheduler<nova::FrameStats>();
+  sched.add_system_to_stage([] {}, "first");
+  sched.add_system_to_stage([] { std::this_thread::sleep_for(1ms); },
+                            "update");
+  return sched;
+}
+
+}  // namespace
+
+TEST_CASE("histogram buckets bound the relative error") {
+  using nova::HdrHistogram;
+  auto previous = std::size_t{0};
+  for (auto value = std::uint64_t{0}; value < 1u << 20u; value += 7u) {
+    const auto index = HdrHistogram::bucket_index(value);
+    REQUIRE(index < HdrHistogram::bucket_count);
+    CHECK(previous <= index);
+    const auto highest = HdrHistogram::bucket_value(index);
+    CHECK(value <= highest);
+    CHECK(static_cast<double>(highest - value) <=
+          static_cast<double>(value) * HdrHistogram::relative_error);
+    previous = index;
+  }
+  // values past the range share the last bucket.
+  CHECK(HdrHistogram::bucket_count - 1u ==
+        HdrHistogram::bucket_index(std::uint64_t{1} << 50u));
+}
+
+TEST_CASE("histogram percentiles") {
+  auto histogram = std::make_unique<nova::HdrHistogram>();
+  CHECK(nova::HistogramSummary{} == histogram->summary());
+
+  for (auto value = std::uint64_t{1}; value <= 10'000u; ++value) {
+    histogram->record(value);
+  }
+  const auto summary = histogram->summary();
+  CHECK(10'000u == summary.count);
+  CHECK(5'000.5 == doctest::Approx(summary.mean));
+  CHECK(10'000u == summary.max);
+  CHECK(5'000.0 == doctest::Approx(summary.p50).epsilon(0.02));
+  CHECK(9'000.0 == doctest::Approx(summary.p90).epsilon(0.02));
+  CHECK(9'900.0 == doctest::Approx(summary.p99).epsilon(0.02));
+  CHECK(9'990.0 == doctest::Approx(summary.p999).epsilon(0.02));
+  CHECK(summary.p99 == histogram->value_at(0.99));
+  CHECK(10'000u == histogram->value_at(1.0));
+
+  histogram->reset();
+  CHECK(0u == histogram->count());
+  CHECK(0u == histogram->value_at(0.5));
+}
+
+TEST_CASE("histograms record from many threads") {
+  auto histogram = std::make_unique<nova::HdrHistogram>();
+  auto threads = std::vector<std::jthread>{};
+  for (auto t = 0; t < 4; ++t) {
+    threads.emplace_back([&] {
+      for (auto value = std::uint64_t{0}; value < 10'000u; ++value) {
+        histogram->record(value);
+      }
+    });
+  }
+  threads.clear();
+  CHECK(40'000u == histogram->count());
+  CHECK(9'999u == histogram->max());
+}
+
+TEST_CASE("the window forgets old values") {
+  auto window = nova::WindowedHistogram{100u, 4u};
+  CHECK(100u == window.window());
+  for (auto value = std::uint64_t{0}; value < 1'000u; ++value) {
+    window.record(value);
+  }
+  CHECK(75u < window.count());
+  CHECK(100u >= window.count());
+  CHECK(999u == window.max());
+  CHECK(900u <= window.value_at(0.0));
+
+  window.reset();
+  CHECK(0u == window.count());
+}
+
+TEST_CASE("frame stats keep a series per stage") {
+  auto stats = nova::FrameStats{60u, nova::StageTiming::on};
+  stats.record_frame(16ms);
+  stats.record_stage(1u, "update", 5ms);
+  CHECK(2u == stats.stage_count());
+  CHECK(nullptr == stats.stage(0u));
+  REQUIRE(nullptr != stats.stage(1u));
+  CHECK("update" == stats.stage(1u)->name());
+  CHECK(5'000'000u == stats.stage(1u)->window().max());
+  CHECK(16'000'000u == stats.frame().lifetime().summary().p99);
+
+  // a renamed stage starts over.
+  stats.record_stage(1u, "render", 1ms);
+  CHECK("render" == stats.stage(1u)->name());
+  CHECK(1u == stats.stage(1u)->lifetime().count());
+}
+
+TEST_CASE("the scheduler times frames and stages") {
+  auto world = nova::World{};
+  auto sched = make_scheduler();
+  sched.initialize_systems(world);
+  world.resources().set<nova::FrameStats>(60u, nova::StageTiming::on);
+
+  for (auto i = 0; i < 3; ++i) {
+    sched.update(world);
+  }
+  auto pool = nova::TaskPool{2u};
+  sched.update(world, pool);
+
+  const auto stats = *world.resources().get<nova::FrameStats>();
+  const auto frame = stats->frame().window().summary();
+  CHECK(4u == frame.count);
+  CHECK(1'000'000u <= frame.p50);
+  REQUIRE(2u == stats->stage_count());
+  CHECK("first" == stats->stage(0u)->name());
+  const auto update = stats->stage(1u)->lifetime().summary();
+  CHECK(4u == update.count);
+  CHECK(1'000'000u <= update.p50);
+  CHECK(update.max <= frame.max);
+}
+
+TEST_CASE("stage timing is optional") {
+  auto world = nova::World{};
+  auto sched = make_scheduler();
+  sched.initialize_systems(world);
+  world.resources().set<nova::FrameStats>();
+
+  sched.update(world);
+
+  const auto stats = *world.resources().get<nova::FrameStats>();
+  CHECK(1u == stats->frame().lifetime().count());
+  CHECK(0u == stats->stage_count());
+  CHECK(std::empty(stats->systems()));
+}
+
+TEST_CASE("the scheduler times systems") {
+  auto world = nova::World{};
+  auto sched = make_scheduler();
+  sched.initialize_systems(world);
+  world.resources().set<nova::FrameStats>(60u, nova::StageTiming::off,
+                                          nova::SystemTiming::on);
+
+  sched.update(world);
+  auto pool = nova::TaskPool{2u};
+  sched.update(world, pool);
+
+  const auto stats = *world.resources().get<nova::FrameStats>();
+  CHECK(0u == stats->stage_count());
+  REQUIRE(2u == std::size(stats->systems()));
+  const auto& update = stats->systems()[1];
+  CHECK("update" == update.stage);
+  REQUIRE(1u == std::size(update.systems));
+  const auto sleep = update.systems[0]->lifetime().summary();
+  CHECK(2u == sleep.count);
+  CHECK(1'000'000u <= sleep.p50);
+  CHECK(sleep.max <= stats->frame().window().max());
+}
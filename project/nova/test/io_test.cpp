@@ -0,0 +1,250 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+// clang-format off
+#include <doctest/doctest.h>
+// clang-format on
+
+#include "nova/io/io_queue.hpp"
+
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "nova/app/app.hpp"
+#include "nova/io/io_plugin.hpp"
+#include "nova/task/task_pool.hpp"
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+namespace {
+
+// a directory of files removed with the fixture.
+class TempDir {
+  std::filesystem::path path_;
+
+ public:
+  TempDir()
+      : path_(std::filesystem::temp_directory_path() /
+              std::format("nova_io_test_{}",
+                          std::hash<std::thread::id>{}(
+                              std::this_thread::get_id()))) {
+    std::filesystem::create_directories(path_);
+  }
+
+  TempDir(TempDir const&) = delete;
+  TempDir& operator=(TempDir const&) = delete;
+
+  ~TempDir() { std::filesystem::remove_all(path_); }
+
+  auto write(const std::string& name, const std::string& content) const
+      -> std::filesystem::path {
+    const auto file = path_ / name;
+    std::ofstream{file, std::ios::binary} << content;
+    return file;
+  }
+
+  [[nodiscard]] auto path() const -> const std::filesystem::path& {
+    return path_;
+  }
+};
+
+auto as_string(const std::vector<std::byte>& bytes) -> std::string {
+  return std::string{reinterpret_cast<const char*>(std::data(bytes)),
+                     std::size(bytes)};
+}
+
+auto as_bytes(const std::string& text) -> std::vector<std::byte> {
+  const auto* const first = reinterpret_cast<const std::byte*>(text.data());
+  return std::vector<std::byte>(first, first + std::size(text));
+}
+
+// every backend available here, the io_uring one only on Linux.
+auto backends(nova::TaskPool& pool)
+    -> std::vector<std::function<std::unique_ptr<nova::detail::IoBackend>()>> {
+  auto factories =
+      std::vector<std::function<std::unique_ptr<nova::detail::IoBackend>()>>{
+          [] { return nova::make_threaded_backend(); },
+          [&pool] { return nova::make_threaded_backend(&pool); },
+      };
+  if (nova::make_uring_backend(8u) != nullptr) {
+    factories.emplace_back([] { return nova::make_uring_backend(8u); });
+  }
+  return factories;
+}
+
+}  // namespace
+
+TEST_CASE("files are read in batches") {
+  const auto dir = TempDir{};
+  auto pool = nova::TaskPool{2u};
+
+  for (const auto& make_backend : backends(pool)) {
+    auto io = nova::IoQueue{make_backend()};
+
+    // more files than the io_uring rings hold, to go through the backlog.
+    auto files = std::vector<nova::IoFile>{};
+    auto tickets = std::vector<nova::IoTicket>{};
+    for (auto i = 0; i < 40; ++i) {
+      const auto path =
+          dir.write(std::format("{}.txt", i), std::format("file {}", i));
+      files.push_back(nova::IoFile::open(path));
+      tickets.push_back(io.read(files.back(), 0u, files.back().size()));
+    }
+    CHECK(40u == io.pending());
+    CHECK(40u == io.submit());
+    CHECK(0u == io.submit());
+
+    io.wait_all();
+    CHECK(0u == io.pending());
+    for (auto i = 0; i < 40; ++i) {
+      auto result = io.take(tickets[i]);
+      REQUIRE(result.has_value());
+      CHECK(result->ok());
+      CHECK(std::format("file {}", i) == as_string(result->data));
+      CHECK_FALSE(io.take(tickets[i]).has_value());
+    }
+  }
+}
+
+TEST_CASE("reads past the end of a file are short") {
+  const auto dir = TempDir{};
+  const auto file = nova::IoFile::open(dir.write("a.txt", "0123456789"));
+  auto pool = nova::TaskPool{2u};
+
+  for (const auto& make_backend : backends(pool)) {
+    auto io = nova::IoQueue{make_backend()};
+    const auto tail = io.read(file, 6u, 100u);
+    const auto past = io.read(file, 20u, 4u);
+    io.wait_all();
+
+    const auto tail_result = io.take(tail);
+    REQUIRE(tail_result.has_value());
+    CHECK(4u == tail_result->transferred);
+    CHECK("6789" == as_string(tail_result->data));
+
+    const auto past_result = io.take(past);
+    REQUIRE(past_result.has_value());
+    CHECK(past_result->ok());
+    CHECK(std::empty(past_result->data));
+  }
+}
+
+#if defined(__linux__)
+TEST_CASE("short transfers are resumed") {
+  auto backend = nova::make_uring_backend(8u);
+  if (backend == nullptr) {
+    return;
+  }
+  // a pipe returns what it holds, so the read below is cut short once.
+  auto fds = std::array<int, 2>{};
+  REQUIRE(0 == ::pipe(fds.data()));
+  REQUIRE(3 == ::write(fds[1], "abc", 3u));
+
+  auto buffer = std::array<std::byte, 6u>{};
+  const auto op = nova::detail::IoOp{
+      .id = 7u,
+      .kind = nova::detail::IoOpKind::read,
+      .fd = fds[0],
+      .data = buffer.data(),
+      .size = 6u,
+  };
+  backend->submit(std::span{&op, 1u});
+  auto events = std::vector<nova::detail::IoEvent>{};
+  auto writer = std::thread{[fd = fds[1]] {
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    CHECK(3 == ::write(fd, "def", 3u));
+  }};
+  backend->reap(events, true);
+  writer.join();
+
+  REQUIRE(1u == std::size(events));
+  CHECK(7u == events[0].id);
+  CHECK(6 == events[0].result);
+  CHECK("abcdef" == std::string{reinterpret_cast<const char*>(buffer.data()),
+                                std::size(buffer)});
+  CHECK(0u == backend->in_flight());
+  ::close(fds[0]);
+  ::close(fds[1]);
+}
+#endif
+
+TEST_CASE("files are written at offsets") {
+  const auto dir = TempDir{};
+  auto pool = nova::TaskPool{2u};
+
+  for (const auto& make_backend : backends(pool)) {
+    auto io = nova::IoQueue{make_backend()};
+    const auto path = dir.path() / "out.txt";
+    {
+      const auto file = nova::IoFile::open(path, nova::IoMode::write);
+      const auto second = io.write(file, 5u, as_bytes("world"));
+      const auto first = io.write(file, 0u, as_bytes("hello"));
+      io.wait_all();
+
+      const auto result = io.take(first);
+      REQUIRE(result.has_value());
+      CHECK(result->ok());
+      CHECK(5u == result->transferred);
+      // the buffer is given back.
+      CHECK("hello" == as_string(result->data));
+      CHECK(io.done(second));
+    }
+
+    auto content = std::string{};
+    std::getline(std::ifstream{path}, content);
+    CHECK("helloworld" == content);
+  }
+}
+
+TEST_CASE("failed operations report their errno") {
+  const auto dir = TempDir{};
+  const auto file = nova::IoFile::open(dir.write("a.txt", "read only"));
+  auto pool = nova::TaskPool{2u};
+
+  for (const auto& make_backend : backends(pool)) {
+    auto io = nova::IoQueue{make_backend()};
+    const auto ticket = io.write(file, 0u, as_bytes("nope"));
+    io.wait_all();
+
+    const auto result = io.take(ticket);
+    REQUIRE(result.has_value());
+    CHECK_FALSE(result->ok());
+    CHECK(EBADF == result->error);
+    CHECK(0u == result->transferred);
+  }
+}
+
+TEST_CASE("files that cannot be opened throw") {
+  const auto dir = TempDir{};
+  CHECK_THROWS_AS(std::ignore = nova::IoFile::open(dir.path() / "missing"),
+                  nova::nova_exception);
+
+  auto io = nova::IoQueue{nova::make_threaded_backend()};
+  CHECK_THROWS_AS(io.read(nova::IoFile{}, 0u, 1u), nova::nova_exception);
+}
+
+TEST_CASE("the io plugin submits and polls every frame") {
+  const auto dir = TempDir{};
+  const auto file = nova::IoFile::open(dir.write("a.txt", "content"));
+
+  auto app = nova::App{};
+  app.add_default_stages().add_plugin(nova::IoPlugin{});
+  app.scheduler.initialize_systems(app.world);
+
+  auto& io = **app.world.resources().get<nova::IoQueue>();
+  const auto ticket = io.read(file, 0u, 7u);
+  for (auto frame = 0; frame < 1'000 and not io.done(ticket); ++frame) {
+    app.update();
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  }
+  const auto result = io.take(ticket);
+  REQUIRE(result.has_value());
+  CHECK("content" == as_string(result->data));
+}
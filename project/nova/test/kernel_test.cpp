@@ -0,0 +1,205 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+// clang-format off
+#include <doctest/doctest.h>
+// clang-format on
+
+#include "nova/system/kernel.hpp"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "nova/scheduler/scheduler.hpp"
+#include "nova/system/system_builder.hpp"
+
+namespace {
+
+struct position {
+  float x{};
+};
+
+struct velocity {
+  float dx{};
+};
+
+struct acceleration {
+  float ddx{};
+};
+
+struct step {
+  float dt{};
+};
+
+auto accelerate(nova::Resource<const step> s) {
+  return [dt = s->dt](const acceleration& acc, velocity& vel) {
+    vel.dx += acc.ddx * dt;
+  };
+}
+
+auto integrate(nova::Resource<const step> s) {
+  return [dt = s->dt](const velocity& vel, position& pos) {
+    pos.x += vel.dx * dt;
+  };
+}
+
+auto make_world() -> nova::World {
+  auto world = nova::World{};
+  world.resources().set<step>(step{.dt = 2.f});
+  return world;
+}
+
+using probed_t = std::vector<std::pair<std::size_t, std::size_t>>;
+
+// records the systems it is given, as `(first, count)`.
+struct recording_probe {
+  probed_t* probed = nullptr;
+  bool split = false;
+
+  [[nodiscard]] auto splits_fused_batches() const -> bool { return split; }
+
+  template <typename TFunc>
+  auto operator()(const std::size_t first, const std::size_t count,
+                  TFunc&& func) const -> void {
+    probed->emplace_back(first, count);
+    FWD(func)();
+  }
+};
+
+}  // namespace
+
+TEST_CASE("a kernel system runs on its own") {
+  auto world = make_world();
+  auto& reg = world.registry();
+
+  const auto e = reg.create();
+  reg.emplace<velocity>(e, velocity{.dx = 1.f});
+  reg.emplace<position>(e);
+
+  auto descriptor = nova::to_descriptors(nova::kernel(integrate));
+  CHECK(descriptor.system.kernel.has_value());
+
+  auto* const world_ptr = static_cast<void*>(&world);
+  descriptor.system.initialize(world_ptr);
+  descriptor.system.run(world_ptr);
+
+  CHECK(reg.get<position>(e).x == doctest::Approx(2.f));
+}
+
+TEST_CASE("kernels sharing a component are fused and keep their order") {
+  auto world = make_world();
+  auto& reg = world.registry();
+
+  // moves and accelerates
+  const auto a = reg.create();
+  reg.emplace<acceleration>(a, acceleration{.ddx = 1.f});
+  reg.emplace<velocity>(a, velocity{.dx = 1.f});
+  reg.emplace<position>(a);
+
+  // only moves
+  const auto b = reg.create();
+  reg.emplace<velocity>(b, velocity{.dx = 1.f});
+  reg.emplace<position>(b);
+
+  // only accelerates
+  const auto c = reg.create();
+  reg.emplace<acceleration>(c, acceleration{.ddx = 1.f});
+  reg.emplace<velocity>(c, velocity{.dx = 1.f});
+
+  auto sched = nova::Scheduler{};
+  sched.add_stage("update");
+  sched.add_system_to_stage(nova::kernel(integrate).label("integrate"),
+                            "update");
+  sched.add_system_to_stage(nova::kernel(accelerate).before("integrate"),
+                            "update");
+  sched.initialize_systems(world);
+
+  const auto found = sched.get_stage("update");
+  REQUIRE(found.has_value());
+  const auto& batches = found->first.batches;
+  REQUIRE(1u == std::size(batches));
+  CHECK(2u == batches[0].count);
+  CHECK(batches[0].driver.has_value());
+
+  sched.update(world);
+
+  // `accelerate` must run before `integrate` for every entity.
+  CHECK(reg.get<velocity>(a).dx == doctest::Approx(3.f));
+  CHECK(reg.get<position>(a).x == doctest::Approx(6.f));
+  CHECK(reg.get<velocity>(b).dx == doctest::Approx(1.f));
+  CHECK(reg.get<position>(b).x == doctest::Approx(2.f));
+  CHECK(reg.get<velocity>(c).dx == doctest::Approx(3.f));
+}
+
+TEST_CASE("fused kernels are probed as the pass they run as") {
+  auto world = make_world();
+  auto& reg = world.registry();
+  // several blocks of entities.
+  for (auto i = 0; i < 1'000; ++i) {
+    const auto e = reg.create();
+    reg.emplace<acceleration>(e, acceleration{.ddx = 1.f});
+    reg.emplace<velocity>(e, velocity{.dx = 1.f});
+    reg.emplace<position>(e);
+  }
+
+  auto systems = std::vector<nova::System>{};
+  systems.push_back(nova::to_descriptors(nova::kernel(accelerate)).system);
+  systems.push_back(nova::to_descriptors(nova::kernel(integrate)).system);
+  auto* const world_ptr = static_cast<void*>(&world);
+  for (auto& system : systems) {
+    system.initialize(world_ptr);
+  }
+  const auto batches = nova::detail::plan_batches(systems);
+  REQUIRE(1u == std::size(batches));
+  REQUIRE(batches[0].driver.has_value());
+
+  auto probed = probed_t{};
+  auto probe = recording_probe{.probed = &probed};
+  auto expected = probed_t{};
+  SUBCASE("once as a whole") { expected = {{0u, 2u}}; }
+  SUBCASE("once each when split") {
+    probe.split = true;
+    expected = {{0u, 1u}, {1u, 1u}};
+  }
+  nova::detail::run_batch(systems, batches[0], world_ptr, probe);
+
+  CHECK(expected == probed);
+  for (auto&& [_, vel, pos] : reg.view<velocity, position>().each()) {
+    CHECK(vel.dx == doctest::Approx(3.f));
+    CHECK(pos.x == doctest::Approx(6.f));
+  }
+}
+
+TEST_CASE("kernels without a shared component are not fused") {
+  struct other {
+    int i{};
+  };
+
+  auto world = make_world();
+  auto& reg = world.registry();
+  const auto e = reg.create();
+  reg.emplace<other>(e);
+  reg.emplace<velocity>(e);
+  reg.emplace<position>(e);
+
+  auto count = [](nova::Resource<const step>) {
+    return [](other& o) { o.i += 1; };
+  };
+
+  auto sched = nova::Scheduler{};
+  sched.add_stage("update");
+  sched.add_system_to_stage(nova::kernel(integrate).label("integrate"),
+                            "update");
+  sched.add_system_to_stage(nova::kernel(count).after("integrate"), "update");
+  sched.add_system_to_stage(nova::system([] {}).after("integrate"), "update");
+  sched.initialize_systems(world);
+
+  const auto found = sched.get_stage("update");
+  REQUIRE(found.has_value());
+  for (const auto& batch : found->first.batches) {
+    CHECK(1u == batch.count);
+    CHECK_FALSE(batch.driver.has_value());
+  }
+
+  sched.update(world);
+  CHECK(1 == reg.get<other>(e).i);
+}
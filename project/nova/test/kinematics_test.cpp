@@ -0,0 +1,132 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+// clang-format off
+#include <doctest/doctest.h>
+// clang-format on
+
+#include "nova/kinematics/kinematics.hpp"
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+auto random_floats(const std::size_t n, const unsigned seed)
+    -> std::vector<float> {
+  auto gen = std::mt19937{seed};
+  auto distrib = std::uniform_real_distribution<float>{-1000.f, 1000.f};
+  auto values = std::vector<float>(n);
+  for (auto& value : values) {
+    value = distrib(gen);
+  }
+  return values;
+}
+
+}  // namespace
+
+TEST_CASE("every supported instruction set matches the scalar path exactly") {
+  using nova::simd::Isa;
+
+  CHECK(nova::simd::supports(Isa::scalar));
+  CHECK(nova::simd::supports(nova::simd::best_isa()));
+
+  for (const auto isa : {Isa::sse2, Isa::avx2, Isa::avx512}) {
+    if (not nova::simd::supports(isa)) {
+      continue;
+    }
+
+    CAPTURE(nova::simd::isa_name(isa));
+    // covers the vector bodies, every tail length and unaligned starts.
+    for (auto n = std::size_t{0}; n < 80u; ++n) {
+      for (auto offset = std::size_t{0}; offset < 3u; ++offset) {
+        const auto x = random_floats(n + offset, 1u);
+        const auto y = random_floats(n + offset, 2u);
+
+        auto expected = y;
+        nova::simd::axpy(Isa::scalar, 0.016f, std::data(x) + offset,
+                         std::data(expected) + offset, n);
+
+        auto actual = y;
+        nova::simd::axpy(isa, 0.016f, std::data(x) + offset,
+                         std::data(actual) + offset, n);
+
+        CHECK(0 == std::memcmp(std::data(expected), std::data(actual),
+                               sizeof(float) * std::size(y)));
+      }
+    }
+  }
+}
+
+TEST_CASE("kinematics integrate velocity then position") {
+  auto reg = entt::registry{};
+
+  const auto moving = reg.create();
+  reg.emplace<nova::Position>(moving, 1.f, 2.f);
+  reg.emplace<nova::Velocity>(moving, 10.f, -10.f);
+  reg.emplace<nova::Acceleration>(moving, 2.f, 4.f);
+
+  const auto drifting = reg.create();
+  reg.emplace<nova::Position>(drifting);
+  reg.emplace<nova::Velocity>(drifting, 1.f, 1.f);
+
+  const auto still = reg.create();
+  reg.emplace<nova::Position>(still, 5.f, 5.f);
+
+  using acceleration_view_t =
+      nova::View<nova::With<const nova::Acceleration, nova::Velocity>>;
+  using velocity_view_t =
+      nova::View<nova::With<const nova::Velocity, nova::Position>>;
+
+  nova::detail::integrate_chunks<nova::Acceleration, nova::Velocity>(
+      acceleration_view_t{
+          reg.view<const nova::Acceleration, nova::Velocity>()},
+      0.5f);
+  nova::detail::integrate_chunks<nova::Velocity, nova::Position>(
+      velocity_view_t{reg.view<const nova::Velocity, nova::Position>()}, 0.5f);
+
+  CHECK(11.f == reg.get<nova::Velocity>(moving).dx);
+  CHECK(-8.f == reg.get<nova::Velocity>(moving).dy);
+  CHECK(6.5f == reg.get<nova::Position>(moving).x);
+  CHECK(-2.f == reg.get<nova::Position>(moving).y);
+
+  CHECK(0.5f == reg.get<nova::Position>(drifting).x);
+  CHECK(0.5f == reg.get<nova::Position>(drifting).y);
+
+  CHECK(5.f == reg.get<nova::Position>(still).x);
+  CHECK(5.f == reg.get<nova::Position>(still).y);
+}
+
+TEST_CASE("kinematics gather short chunks") {
+  auto reg = entt::registry{};
+
+  // every other entity has an acceleration, so the acceleration/velocity
+  // view only has chunks of one entity.
+  auto entities = std::vector<entt::entity>(1'000u);
+  reg.create(std::begin(entities), std::end(entities));
+  for (auto i = std::size_t{0}; i < std::size(entities); ++i) {
+    const auto f = static_cast<float>(i);
+    reg.emplace<nova::Velocity>(entities[i], f, -f);
+    if (i % 2u == 0u) {
+      reg.emplace<nova::Acceleration>(entities[i], 1.f + f, 2.f * f);
+    }
+  }
+
+  using acceleration_view_t =
+      nova::View<nova::With<const nova::Acceleration, nova::Velocity>>;
+  nova::detail::integrate_chunks<nova::Acceleration, nova::Velocity>(
+      acceleration_view_t{
+          reg.view<const nova::Acceleration, nova::Velocity>()},
+      0.25f);
+
+  for (auto i = std::size_t{0}; i < std::size(entities); ++i) {
+    const auto f = static_cast<float>(i);
+    const auto& velocity = reg.get<nova::Velocity>(entities[i]);
+    if (i % 2u == 0u) {
+      CHECK(f + 0.25f * (1.f + f) == velocity.dx);
+      CHECK(-f + 0.25f * (2.f * f) == velocity.dy);
+    } else {
+      CHECK(f == velocity.dx);
+      CHECK(-f == velocity.dy);
+    }
+  }
+}
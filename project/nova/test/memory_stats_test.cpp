@@ -0,0 +1,210 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+// clang-format off
+#include <doctest/doctest.h>
+// clang-format on
+
+#include "nova/diagnostics/memory_stats.hpp"
+
+#include <string>
+#include <vector>
+
+#include "nova/system/system.hpp"
+#include "nova/util/memory_usage.hpp"
+#include "nova/util/void_ptr.hpp"
+
+namespace {
+
+struct position {
+  float x, y;
+};
+
+struct velocity {
+  float x, y;
+};
+
+struct tag {};
+
+}  // namespace
+
+TEST_CASE("containers report their heap memory") {
+  auto values = std::vector<int>{1, 2, 3};
+  values.reserve(10u);
+  const auto usage = nova::heap_usage<std::vector<int>>{}(values);
+  CHECK(3u * sizeof(int) == usage.used_bytes);
+  CHECK(values.capacity() * sizeof(int) == usage.reserved_bytes);
+  CHECK(usage.reserved_bytes - usage.used_bytes == usage.wasted_bytes());
+
+  // short strings live in the string itself.
+  const auto small = std::string{"a"};
+  CHECK(nova::MemoryUsage{} == nova::heap_usage<std::string>{}(small));
+
+  const auto large = std::string(100u, 'a');
+  CHECK(100u <= nova::heap_usage<std::string>{}(large).used_bytes);
+
+  const auto total = nova::memory_usage_of(values);
+  CHECK(sizeof(values) + usage.used_bytes == total.used_bytes);
+}
+
+TEST_CASE("void_ptr reports the memory of its value") {
+  const auto ptr = nova::void_ptr{std::in_place_type<std::vector<int>>, 64u};
+  const auto usage = ptr.memory_usage();
+  CHECK(sizeof(std::vector<int>) + 64u * sizeof(int) == usage.used_bytes);
+
+  auto moved = nova::void_ptr{};
+  CHECK(nova::MemoryUsage{} == moved.memory_usage());
+  moved = nova::void_ptr{std::in_place_type<int>, 1};
+  CHECK(sizeof(int) == moved.memory_usage().used_bytes);
+}
+
+TEST_CASE("memory stats account for component pools") {
+  auto world = nova::World{};
+  auto& reg = world.registry();
+  // the layouts are recorded when the pools are reached by type, not when
+  // they are created by `emplace`.
+  std::ignore = reg.storage<position>();
+  std::ignore = reg.storage<tag>();
+  for (auto i = 0; i < 100; ++i) {
+    const auto e = reg.create();
+    reg.emplace<position>(e);
+    if (i % 10 == 0) {
+      reg.emplace<velocity>(e);
+      reg.emplace<tag>(e);
+    }
+  }
+
+  auto stats = nova::MemoryStats{};
+  stats.collect(world);
+  CHECK(1u == stats.collections());
+
+  constexpr auto entity_size = sizeof(entt::entity);
+  const auto* positions =
+      stats.find(nova::type_name<position>(), nova::MemoryCategory::component);
+  REQUIRE(nullptr != positions);
+  CHECK(positions->complete);
+  CHECK(100u == positions->size);
+  CHECK(100u <= positions->capacity);
+  CHECK(100u * (sizeof(position) + 2u * entity_size) ==
+        positions->usage.used_bytes);
+  CHECK(positions->usage.used_bytes <= positions->usage.reserved_bytes);
+
+  // empty components have no payload.
+  const auto* tags =
+      stats.find(nova::type_name<tag>(), nova::MemoryCategory::component);
+  REQUIRE(nullptr != tags);
+  CHECK(tags->complete);
+  CHECK(10u * 2u * entity_size == tags->usage.used_bytes);
+
+  // pools of unknown layout only count their entity index, until tracked.
+  const auto* velocities =
+      stats.find(nova::type_name<velocity>(), nova::MemoryCategory::component);
+  REQUIRE(nullptr != velocities);
+  CHECK_FALSE(velocities->complete);
+  CHECK(10u * 2u * entity_size == velocities->usage.used_bytes);
+
+  // largest first.
+  const auto& entries = stats.entries();
+  for (auto i = std::size_t{1}; i < std::size(entries); ++i) {
+    CHECK(entries[i - 1u].usage.reserved_bytes >=
+          entries[i].usage.reserved_bytes);
+  }
+}
+
+TEST_CASE("memory stats know the layouts of pools nova creates") {
+  auto world = nova::World{};
+  auto& reg = world.registry();
+  reg.emplace<velocity>(reg.create());
+
+  auto stats = nova::MemoryStats{};
+  const auto velocities = [&stats] {
+    return stats.find(nova::type_name<velocity>(),
+                      nova::MemoryCategory::component);
+  };
+  stats.collect(world);
+  REQUIRE(nullptr != velocities());
+  CHECK_FALSE(velocities()->complete);
+  stats.track<velocity>().collect(world);
+  CHECK(velocities()->complete);
+
+  // from the views of systems, before anything is emplaced.
+  auto sched = nova::Scheduler{};
+  sched.add_stage("update");
+  sched.add_system_to_stage([](nova::View<nova::With<const position>>) {},
+                            "update");
+  sched.initialize_systems(world);
+  stats.collect(world);
+  const auto* positions =
+      stats.find(nova::type_name<position>(), nova::MemoryCategory::component);
+  REQUIRE(nullptr != positions);
+  CHECK(positions->complete);
+  REQUIRE(nullptr != reg.layout(entt::type_hash<position>::value()));
+  CHECK(sizeof(position) ==
+        reg.layout(entt::type_hash<position>::value())->size);
+}
+
+TEST_CASE("memory stats account for resources and system states") {
+  auto world = nova::World{};
+  world.resources().set<std::vector<int>>(1'000u);
+
+  auto sched = nova::Scheduler{};
+  sched.add_stage("update");
+  sched.add_system_to_stage(
+      [](nova::Local<std::vector<int>> values) {
+        if (std::empty(*values)) {
+          values->resize(256u);
+        }
+      },
+      "update");
+  sched.initialize_systems(world);
+  sched.update(world);
+
+  auto stats = nova::MemoryStats{};
+  stats.collect(world, sched);
+
+  const auto* resource = stats.find(nova::type_name<std::vector<int>>(),
+                                    nova::MemoryCategory::resource);
+  REQUIRE(nullptr != resource);
+  CHECK(sizeof(std::vector<int>) + 1'000u * sizeof(int) ==
+        resource->usage.used_bytes);
+
+  const auto systems = stats.total(nova::MemoryCategory::system);
+  CHECK(256u * sizeof(int) <= systems.used_bytes);
+  CHECK(systems.used_bytes <= systems.reserved_bytes);
+}
+
+TEST_CASE("memory stats are collected on request") {
+  auto world = nova::World{};
+  world.resources().set<nova::MemoryStats>();
+  auto sched = nova::Scheduler{};
+  sched.add_stage("update");
+  sched.observe<nova::MemoryStats>();
+  sched.initialize_systems(world);
+  auto stats = *world.resources().get<nova::MemoryStats>();
+
+  sched.update(world);
+  CHECK(0u == stats->collections());
+
+  stats->request_update();
+  sched.update(world);
+  CHECK(1u == stats->collections());
+  CHECK_FALSE(stats->update_requested());
+  CHECK(nullptr != stats->find(nova::type_name<nova::MemoryStats>(),
+                               nova::MemoryCategory::resource));
+}
+
+TEST_CASE("memory stats are exported as JSON") {
+  auto world = nova::World{};
+  world.registry().emplace<position>(world.registry().create());
+
+  auto stats = nova::MemoryStats{};
+  stats.track<position>().collect(world);
+
+  const auto json = stats.to_json();
+  CHECK(json.starts_with(R"({"collections":1,"totals":{"component":{)"));
+  CHECK(json.ends_with("]}"));
+  CHECK(json.find(R"("category":"component")") != std::string::npos);
+  CHECK(json.find(R"("complete":true)") != std::string::npos);
+
+  auto escaped = std::string{};
+  nova::detail::append_json_string(escaped, "a\"b\\c\n");
+  CHECK(R"("a\"b\\c\n")" == escaped);
+}
@@ -0,0 +1,248 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+// clang-format off
+#include <doctest/doctest.h>
+// clang-format on
+
+#include "nova/diagnostics/metrics_plugin.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "nova/app/app.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#define NOVA_TEST_SOCKETS 1
+#else
+#define NOVA_TEST_SOCKETS 0
+#endif
+
+namespace {
+
+using namespace std::chrono_literals;
+
+struct position {
+  float x{};
+};
+
+auto contains(const std::string_view text, const std::string_view part)
+    -> bool {
+  return text.find(part) != std::string_view::npos;
+}
+
+// systems of the same signature, hence of the same type.
+auto first_tick(nova::Resource<position>) -> void {}
+auto second_tick(nova::Resource<position>) -> void {}
+
+#if NOVA_TEST_SOCKETS
+// sends `request` to the loopback interface, and reads the whole response.
+auto fetch(const std::uint16_t port, const std::string_view request)
+    -> std::string {
+  const auto client = ::socket(AF_INET, SOCK_STREAM, 0);
+  REQUIRE(client >= 0);
+  auto addr = sockaddr_in{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  REQUIRE(0 == ::connect(client, reinterpret_cast<const sockaddr*>(&addr),
+                         sizeof(addr)));
+  REQUIRE(static_cast<ssize_t>(std::size(request)) ==
+          ::send(client, request.data(), std::size(request), 0));
+
+  auto response = std::string{};
+  auto buffer = std::array<char, 4'096>{};
+  for (;;) {
+    const auto n = ::recv(client, buffer.data(), std::size(buffer), 0);
+    if (n <= 0) {
+      break;
+    }
+    response.append(buffer.data(), static_cast<std::size_t>(n));
+  }
+  ::close(client);
+  return response;
+}
+
+auto scrape(const std::uint16_t port) -> std::string {
+  return fetch(port, "GET /metrics HTTP/1.1\r\nHost: localhost\r\n\r\n");
+}
+#endif
+
+}  // namespace
+
+TEST_CASE("snapshots are written in the Prometheus text format") {
+  auto snapshot = nova::MetricsSnapshot{};
+  snapshot.frame = nova::TimingMetrics{
+      .name = "frame",
+      .window = nova::HistogramSummary{.count = 2u,
+                                       .p50 = 1'000'000u,
+                                       .p99 = 2'000'000u,
+                                       .max = 2'000'000u},
+      .count = 10u,
+      .sum = 5'000'000'000u,
+  };
+  snapshot.stages.push_back(nova::TimingMetrics{.name = "update"});
+  snapshot.system_times.push_back(nova::SystemTimingMetrics{
+      .stage = "update",
+      .timing = nova::TimingMetrics{.name = "move", .count = 4u, .sum = 2u},
+  });
+  snapshot.systems.push_back(nova::SystemMetrics{
+      .stage = "update", .name = R"(say "hi")"});
+  snapshot.systems.back().total[nova::PerfEvent::task_clock] = 500'000'000u;
+  snapshot.systems.back().total[nova::PerfEvent::cycles] = 42u;
+  snapshot.perf_events[static_cast<std::size_t>(
+      nova::PerfEvent::task_clock)] = true;
+  snapshot.entities = 3u;
+  snapshot.memory.push_back(nova::MemoryEntry{
+      .name = "position",
+      .category = nova::MemoryCategory::component,
+      .size = 3u,
+      .usage = nova::MemoryUsage{.used_bytes = 12u, .reserved_bytes = 64u},
+  });
+
+  auto text = std::string{};
+  nova::write_prometheus(text, snapshot);
+
+  CHECK(contains(text, "# TYPE nova_frame_seconds summary\n"));
+  CHECK(contains(text, "nova_frame_seconds{quantile=\"0.5\"} 0.001\n"));
+  CHECK(contains(text, "nova_frame_seconds{quantile=\"0.99\"} 0.002\n"));
+  CHECK(contains(text, "nova_frame_seconds_sum 5\n"));
+  CHECK(contains(text, "nova_frame_seconds_count 10\n"));
+  CHECK(contains(text, "nova_frame_max_seconds 0.002\n"));
+  CHECK(contains(text,
+                 "nova_stage_seconds{stage=\"update\",quantile=\"0.9\"} 0\n"));
+  CHECK(contains(text, "nova_stage_seconds_count{stage=\"update\"} 0\n"));
+  CHECK(contains(text, "# TYPE nova_system_seconds summary\n"));
+  CHECK(contains(text, "nova_system_seconds_count{stage=\"update\","
+                       "system=\"move\"} 4\n"));
+  CHECK(contains(text, "nova_system_cpu_seconds_total{stage=\"update\","
+                       "system=\"say \\\"hi\\\"\"} 0.5\n"));
+  // only the events that were counted.
+  CHECK_FALSE(contains(text, "nova_system_cycles_total"));
+  CHECK(contains(text, "nova_entities 3\n"));
+  CHECK(contains(text, "nova_memory_reserved_bytes{category=\"component\","
+                       "name=\"position\"} 64\n"));
+  CHECK(contains(text, "nova_pool_components{component=\"position\"} 3\n"));
+}
+
+TEST_CASE("snapshots copy the stats of the world") {
+  auto world = nova::World{};
+  for (auto i = 0; i < 5; ++i) {
+    world.registry().emplace<position>(world.registry().create());
+  }
+  auto frames = world.resources().set<nova::FrameStats>(
+      60u, nova::StageTiming::on);
+  frames->record_frame(2ms);
+  frames->record_stage(0u, "update", 1ms);
+  world.resources().set<nova::MemoryStats>()->collect(world);
+
+  auto snapshot = nova::MetricsSnapshot{};
+  nova::collect_metrics(world, snapshot);
+  CHECK(1u == snapshot.sequence);
+  CHECK(5u == snapshot.entities);
+  CHECK(1u == snapshot.frame.count);
+  CHECK(2'000'000u == snapshot.frame.window.max);
+  REQUIRE(1u == std::size(snapshot.stages));
+  CHECK("update" == snapshot.stages[0].name);
+  CHECK(std::empty(snapshot.system_times));
+  CHECK(std::empty(snapshot.systems));
+  CHECK_FALSE(std::empty(snapshot.memory));
+
+  // collecting again replaces everything.
+  nova::collect_metrics(nova::World{}, snapshot);
+  CHECK(2u == snapshot.sequence);
+  CHECK(0u == snapshot.entities);
+  CHECK(0u == snapshot.frame.count);
+  CHECK(std::empty(snapshot.stages));
+  CHECK(std::empty(snapshot.memory));
+}
+
+TEST_CASE("systems of the same signature are told apart") {
+  auto world = nova::World{};
+  world.resources().set<position>();
+  world.resources().set<nova::PerfStats>();
+  auto sched = nova::Scheduler{};
+  sched.add_stage("update");
+  sched.add_system_to_stage(first_tick, "update");
+  sched.add_system_to_stage(second_tick, "update");
+  sched.observe<nova::PerfStats>();
+  sched.initialize_systems(world);
+  sched.update(world);
+
+  auto snapshot = nova::MetricsSnapshot{};
+  nova::collect_metrics(world, snapshot);
+  REQUIRE(2u == std::size(snapshot.systems));
+  CHECK(snapshot.systems[0].stage == snapshot.systems[1].stage);
+  CHECK(snapshot.systems[0].name != snapshot.systems[1].name);
+
+  auto memory = nova::MemoryStats{};
+  memory.collect(world, sched);
+  auto names = std::vector<std::string>{};
+  for (const auto& entry : memory.entries()) {
+    if (entry.category == nova::MemoryCategory::system) {
+      CHECK(entry.name.starts_with("update/"));
+      names.push_back(entry.name);
+    }
+  }
+  REQUIRE(2u == std::size(names));
+  CHECK(names[0] != names[1]);
+}
+
+#if NOVA_TEST_SOCKETS
+
+TEST_CASE("the server serves the last published snapshot") {
+  auto server = nova::MetricsServer{0u, 0ns};
+  REQUIRE(0u != server.port());
+
+  // nothing published yet.
+  CHECK(contains(scrape(server.port()), "nova_entities 0\n"));
+
+  server.snapshot().entities = 7u;
+  CHECK(server.publish_due());
+  CHECK(server.publish());
+  const auto response = scrape(server.port());
+  CHECK(response.starts_with("HTTP/1.1 200 OK\r\n"));
+  CHECK(contains(response, "Content-Type: text/plain; version=0.0.4"));
+  CHECK(contains(response, "nova_entities 7\n"));
+
+  CHECK(fetch(server.port(), "GET / HTTP/1.1\r\n\r\n")
+            .starts_with("HTTP/1.1 404"));
+  CHECK(fetch(server.port(), "POST /metrics HTTP/1.1\r\n\r\n")
+            .starts_with("HTTP/1.1 405"));
+  CHECK(4u == server.scrapes());
+}
+
+TEST_CASE("the plugin publishes the frames of an app") {
+  auto app = nova::App{};
+  app.add_default_stages()
+      .insert_resource<nova::MetricsServer>(std::uint16_t{0u}, 0ns)
+      .add_plugin(nova::MetricsPlugin{})
+      .add_system([](nova::Registry& registry) {
+        registry.emplace<position>(registry.create());
+      });
+  app.scheduler.initialize_systems(app.world);
+
+  for (auto i = 0; i < 3; ++i) {
+    app.update();
+  }
+
+  const auto server = *app.world.resources().get<nova::MetricsServer>();
+  const auto response = scrape(server->port());
+  CHECK(contains(response, "nova_entities 3\n"));
+  // the last frame is recorded once it is over.
+  CHECK(contains(response, "nova_frame_seconds_count 2\n"));
+  CHECK(contains(response, "nova_stage_seconds_count{stage=\""));
+  CHECK(contains(response, "nova_system_seconds_count{stage=\""));
+  // hardware counters are opt-in.
+  CHECK_FALSE(app.world.resources().get<nova::PerfStats>().has_value());
+  CHECK_FALSE(contains(response, "nova_system_cpu_seconds_total"));
+  app.scheduler.teardown(app.world);
+}
+
+#endif
@@ -0,0 +1,218 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+// clang-format off
+#include <doctest/doctest.h>
+// clang-format on
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+
+#include "nova/scheduler/scheduler.hpp"
+#include "nova/system/system.hpp"
+#include "nova/system/system_builder.hpp"
+
+namespace {
+
+using namespace std::chrono_literals;
+
+struct window_t {
+  std::thread::id drawn_from{};
+};
+
+struct shared_t {
+  mutable std::atomic<int> value{0};
+};
+
+template <int I>
+struct slot_t {
+  bool value{false};
+};
+
+// waits for every participant, or gives up after a while.
+auto rendezvous(const shared_t& shared, const int participants) -> bool {
+  shared.value.fetch_add(1);
+  const auto deadline = std::chrono::steady_clock::now() + 2s;
+  while (shared.value.load() < participants) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::yield();
+  }
+  return true;
+}
+
+auto run_once(nova::Scheduler& sched, nova::World& world,
+              nova::TaskPool& pool) -> void {
+  sched.initialize_systems(world, pool);
+  sched.update(world, pool);
+}
+
+}  // namespace
+
+TEST_CASE("non send resources are not regular resources") {
+  auto world = nova::World{};
+  world.resources().set_non_send<window_t>();
+
+  CHECK(world.resources().contains_non_send<window_t>());
+  CHECK(world.resources().get_non_send<window_t>().has_value());
+  CHECK_FALSE(world.resources().contains<window_t>());
+  CHECK_FALSE(world.resources().get<window_t>().has_value());
+  CHECK(std::this_thread::get_id() == world.resources().main_thread());
+}
+
+TEST_CASE("non send params pin systems to the main thread") {
+  CHECK(nova::system_param<nova::NonSend<window_t>>::access().main_thread);
+  CHECK(nova::system_param<nova::Optional<nova::NonSend<const window_t>>>::
+            access()
+                .main_thread);
+  CHECK_FALSE(nova::system_param<nova::Resource<window_t>>::access()
+                  .main_thread);
+  CHECK(nova::system_param<nova::World&>::access().exclusive);
+  CHECK(nova::system_param<nova::Registry&>::access().exclusive);
+}
+
+TEST_CASE("the main thread runs non send systems while workers run others") {
+  auto sched = nova::Scheduler{};
+  sched.add_stage("stage");
+  sched.add_system_to_stage(
+      [](nova::NonSend<window_t> window, nova::Resource<const shared_t> shared,
+         nova::Resource<slot_t<0>> met) {
+        window->drawn_from = std::this_thread::get_id();
+        met->value = rendezvous(*shared, 2);
+      },
+      "stage");
+  sched.add_system_to_stage(
+      [](nova::Resource<const shared_t> shared, nova::Resource<slot_t<1>> met) {
+        met->value = rendezvous(*shared, 2);
+      },
+      "stage");
+
+  auto world = nova::World{};
+  world.resources().set_non_send<window_t>();
+  world.resources().set<shared_t>();
+  world.resources().set<slot_t<0>>();
+  world.resources().set<slot_t<1>>();
+
+  auto pool = nova::TaskPool{2u};
+  run_once(sched, world, pool);
+
+  const auto stage = sched.get_stage("stage");
+  REQUIRE(stage.has_value());
+  REQUIRE(1u == std::size(stage->first.groups));
+  CHECK(1u == std::size(stage->first.groups[0].main_thread));
+  CHECK(1u == std::size(stage->first.groups[0].any_thread));
+
+  CHECK(std::this_thread::get_id() ==
+        (*world.resources().get_non_send<window_t>())->drawn_from);
+  // both systems were running at the same time.
+  CHECK((*world.resources().get<slot_t<0>>())->value);
+  CHECK((*world.resources().get<slot_t<1>>())->value);
+}
+
+TEST_CASE("mixed groups run on a pool without workers") {
+  auto sched = nova::Scheduler{};
+  sched.add_stage("stage");
+  sched.add_system_to_stage(
+      [](nova::NonSend<window_t> window) {
+        window->drawn_from = std::this_thread::get_id();
+      },
+      "stage");
+  sched.add_system_to_stage(
+      [](nova::Resource<slot_t<0>> ran) { ran->value = true; }, "stage");
+
+  auto world = nova::World{};
+  world.resources().set_non_send<window_t>();
+  world.resources().set<slot_t<0>>();
+
+  auto pool = nova::TaskPool{0u};
+  run_once(sched, world, pool);
+
+  CHECK(std::this_thread::get_id() ==
+        (*world.resources().get_non_send<window_t>())->drawn_from);
+  CHECK((*world.resources().get<slot_t<0>>())->value);
+}
+
+TEST_CASE("the pools of views are created before systems run") {
+  auto sched = nova::Scheduler{};
+  sched.add_stage("stage");
+  sched.add_system_to_stage(
+      [](nova::View<nova::With<slot_t<0>>, nova::Without<slot_t<1>>>) {},
+      "stage");
+
+  auto world = nova::World{};
+  const auto has_pool = [&]<typename T>(std::type_identity<T>) {
+    for (const auto& [id, pool] : world.registry().storage()) {
+      if (id == entt::type_hash<T>::value()) {
+        return true;
+      }
+    }
+    return false;
+  };
+  CHECK_FALSE(has_pool(std::type_identity<slot_t<0>>{}));
+
+  auto pool = nova::TaskPool{2u};
+  sched.initialize_systems(world, pool);
+  CHECK(has_pool(std::type_identity<slot_t<0>>{}));
+  CHECK(has_pool(std::type_identity<slot_t<1>>{}));
+}
+
+TEST_CASE("conflicting or ordered systems do not run concurrently") {
+  auto sched = nova::Scheduler{};
+  sched.add_stage("stage");
+  const auto reader = [](nova::Resource<const shared_t>) {};
+  const auto writer = [](nova::Resource<shared_t> shared) {
+    shared->value.fetch_add(1);
+  };
+  const auto after = [](nova::Resource<const shared_t> shared,
+                        nova::Resource<slot_t<0>> saw_write) {
+    saw_write->value = shared->value.load() == 1;
+  };
+  sched.add_system_to_stage(nova::system(reader).label("reader"), "stage");
+  sched.add_system_to_stage(
+      nova::system(writer).label("writer").after("reader"), "stage");
+  sched.add_system_to_stage(nova::system(after).after("writer"), "stage");
+  sched.add_system_to_stage([](nova::Registry&) {}, "stage");
+
+  auto world = nova::World{};
+  world.resources().set<shared_t>();
+  world.resources().set<slot_t<0>>();
+
+  auto pool = nova::TaskPool{4u};
+  run_once(sched, world, pool);
+
+  const auto stage = sched.get_stage("stage");
+  REQUIRE(stage.has_value());
+  for (const auto& group : stage->first.groups) {
+    CHECK(1u == group.count);
+  }
+  CHECK((*world.resources().get<slot_t<0>>())->value);
+}
+
+TEST_CASE("errors of concurrent systems are rethrown") {
+  auto sched = nova::Scheduler{};
+  sched.add_stage("stage");
+  sched.add_system_to_stage([](nova::NonSend<window_t>) {}, "stage");
+  sched.add_system_to_stage(
+      [](nova::Resource<const shared_t>) { throw std::runtime_error{"boom"}; },
+      "stage");
+
+  auto world = nova::World{};
+  world.resources().set_non_send<window_t>();
+  world.resources().set<shared_t>();
+
+  auto pool = nova::TaskPool{2u};
+  sched.initialize_systems(world, pool);
+  CHECK_THROWS_WITH_AS(sched.update(world, pool), "boom", std::runtime_error);
+}
+
+TEST_CASE("a missing non send resource throws") {
+  auto sched = nova::Scheduler{};
+  sched.add_stage("stage");
+  sched.add_system_to_stage([](nova::NonSend<window_t>) {}, "stage");
+
+  auto world = nova::World{};
+  sched.initialize_systems(world);
+  CHECK_THROWS_AS(sched.update(world), nova::missing_resource<window_t>);
+}
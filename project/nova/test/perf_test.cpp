@@ -0,0 +1,152 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+// clang-format off
+#include <doctest/doctest.h>
+// clang-format on
+
+#include "nova/diagnostics/perf_stats.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+#include "common.hpp"
+#include "nova/scheduler/scheduler.hpp"
+#include "nova/system/system_builder.hpp"
+
+namespace {
+
+// spins for a millisecond of task clock or so.
+struct busy {
+  auto operator()(nova::Local<std::uint64_t> sink) const -> void {
+    const auto start = std::chrono::steady_clock::now();
+    auto x = *sink;
+    while (std::chrono::steady_clock::now() - start <
+           std::chrono::milliseconds{1}) {
+      x = x * 6364136223846793005u + 1442695040888963407u;
+    }
+    *sink = x;
+  }
+};
+
+auto find_busy(const nova::StagePerf& stage) -> const nova::PerfRecord& {
+  const auto found = std::ranges::find(stage.systems, nova::type_name<busy>(),
+                                       &nova::PerfRecord::name);
+  REQUIRE(found != std::end(stage.systems));
+  return *found;
+}
+
+auto make_scheduler() -> nova::Scheduler {
+  auto sched = test::observed_scheduler<nova::PerfStats>();
+  sched.add_system_to_stage([] {}, "first");
+  sched.add_system_to_stage(busy{}, "update");
+  sched.add_system_to_stage([](nova::Local<int> n) { ++*n; }, "update");
+  return sched;
+}
+
+}  // namespace
+
+TEST_CASE("perf counts add up") {
+  auto a = nova::PerfCounts{};
+  a[nova::PerfEvent::cycles] = 100u;
+  a[nova::PerfEvent::instructions] = 250u;
+  auto b = nova::PerfCounts{};
+  b[nova::PerfEvent::cycles] = 20u;
+  b[nova::PerfEvent::llc_misses] = 3u;
+
+  CHECK(a == (a + b) - b);
+  CHECK(120u == (a + b)[nova::PerfEvent::cycles]);
+  CHECK(3u == (a + b)[nova::PerfEvent::llc_misses]);
+  CHECK(2.5 == nova::instructions_per_cycle(a));
+  CHECK(0.0 == nova::instructions_per_cycle(nova::PerfCounts{}));
+  CHECK("branch_misses" ==
+        nova::perf_event_name(nova::PerfEvent::branch_misses));
+}
+
+TEST_CASE("perf support explains missing events") {
+  const auto support = nova::perf_support();
+  auto all = true;
+  for (const auto available : support.available) {
+    all = all and available;
+  }
+  CHECK(all == std::empty(support.error));
+
+  // unavailable events read zero.
+  const auto counts = nova::read_perf_counters();
+  for (auto i = std::size_t{0}; i < nova::perf_event_count; ++i) {
+    if (not support.available[i]) {
+      CHECK(0u == counts.values[i]);
+    }
+  }
+}
+
+TEST_CASE("perf stats sum systems into stages") {
+  auto stats = nova::PerfStats{};
+  auto system = nova::detail::create_system([] {});
+  auto counts = nova::PerfCounts{};
+  counts[nova::PerfEvent::instructions] = 10u;
+
+  for (auto i = 0; i < 2; ++i) {
+    stats.begin_frame(1u);
+    stats.prepare_stage(0u, "update", std::span{&system, 1u});
+    stats.add_system(0u, 0u, counts);
+    stats.add_scheduler(0u, counts);
+    stats.end_frame();
+  }
+
+  REQUIRE(1u == std::size(stats.stages()));
+  const auto& stage = stats.stages()[0];
+  CHECK("update" == stage.stage.name);
+  CHECK(system.meta.id.name() == stage.systems[0].name);
+  CHECK(20u == stage.stage.frame[nova::PerfEvent::instructions]);
+  CHECK(40u == stage.stage.total[nova::PerfEvent::instructions]);
+  CHECK(2u == stats.frames());
+
+  stats.reset();
+  CHECK(0u == stats.frames());
+  CHECK(nova::PerfCounts{} == stats.stages()[0].stage.total);
+}
+
+TEST_CASE("the scheduler counts every system") {
+  auto world = nova::World{};
+  auto sched = make_scheduler();
+  sched.initialize_systems(world);
+  world.resources().set<nova::PerfStats>();
+
+  sched.update(world);
+  sched.update(world);
+
+  const auto stats = *world.resources().get<nova::PerfStats>();
+  CHECK(2u == stats->frames());
+  REQUIRE(2u == std::size(stats->stages()));
+  const auto& update = stats->stages()[1];
+  CHECK("update" == update.stage.name);
+  REQUIRE(2u == std::size(update.systems));
+
+  if (stats->support().supports(nova::PerfEvent::task_clock)) {
+    CHECK(0u < find_busy(update).frame[nova::PerfEvent::task_clock]);
+  }
+  if (not stats->support().supports(nova::PerfEvent::cycles)) {
+    CHECK(0u == update.stage.total[nova::PerfEvent::cycles]);
+  }
+}
+
+TEST_CASE("the scheduler counts systems on the thread running them") {
+  auto world = nova::World{};
+  auto sched = make_scheduler();
+  sched.initialize_systems(world);
+  world.resources().set<nova::PerfStats>();
+
+  auto pool = nova::TaskPool{2u};
+  sched.update(world, pool);
+
+  const auto stats = *world.resources().get<nova::PerfStats>();
+  const auto& update = stats->stages()[1];
+  auto systems = nova::PerfCounts{};
+  for (const auto& system : update.systems) {
+    systems += system.frame;
+  }
+  CHECK(update.stage.frame == systems + update.scheduler.frame);
+  if (stats->support().supports(nova::PerfEvent::task_clock)) {
+    CHECK(0u < find_busy(update).frame[nova::PerfEvent::task_clock]);
+  }
+}
@@ -0,0 +1,109 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+// clang-format off
+#include <doctest/doctest.h>
+// clang-format on
+
+#include "nova/bundle/prefab.hpp"
+
+#include <string>
+
+namespace {
+
+struct position {
+  float x{};
+  float y{};
+};
+
+struct name {
+  std::string value{};
+};
+
+struct enemy {};
+
+struct BodyBundle {
+  using is_bundle = void;
+
+  position pos{};
+  int health{};
+};
+
+struct UnitBundle {
+  using is_bundle = void;
+
+  BodyBundle body{};
+  name n{};
+  enemy tag{};
+};
+
+auto make_unit() -> UnitBundle {
+  return UnitBundle{
+      .body = BodyBundle{.pos = position{.x = 1.f, .y = 2.f}, .health = 10},
+      .n = name{.value = "grunt"},
+  };
+}
+
+}  // namespace
+
+TEST_CASE("spawning a prefab copies its components") {
+  auto reg = nova::Registry{};
+  auto prefab = nova::Prefab{reg, make_unit()};
+
+  const auto entities = prefab.spawn(100);
+  REQUIRE(100u == std::size(entities));
+  CHECK(100u == reg.storage<position>().size());
+
+  for (const auto e : entities) {
+    REQUIRE(reg.all_of<position, int, name, enemy>(e));
+    CHECK(1.f == reg.get<position>(e).x);
+    CHECK(2.f == reg.get<position>(e).y);
+    CHECK(10 == reg.get<int>(e));
+    CHECK("grunt" == reg.get<name>(e).value);
+  }
+}
+
+TEST_CASE("prefab overrides are applied per instance") {
+  auto reg = nova::Registry{};
+  auto prefab = nova::Prefab{reg, make_unit()};
+
+  const auto entities =
+      prefab.spawn(10, [](const std::size_t i, position& pos, int& health) {
+        pos.x = static_cast<float>(i);
+        health += static_cast<int>(i);
+      });
+
+  for (auto i = std::size_t{0}; i < std::size(entities); ++i) {
+    const auto e = entities[i];
+    CHECK(static_cast<float>(i) == reg.get<position>(e).x);
+    CHECK(2.f == reg.get<position>(e).y);
+    CHECK(10 + static_cast<int>(i) == reg.get<int>(e));
+  }
+}
+
+TEST_CASE("prefab defaults can be changed between spawns") {
+  auto reg = nova::Registry{};
+  auto prefab = nova::Prefab{reg, make_unit()};
+
+  const auto first = prefab.spawn(1);
+  prefab.get<name>().value = "boss";
+  const auto second = prefab.spawn(1);
+
+  CHECK("grunt" == reg.get<name>(first.front()).value);
+  CHECK("boss" == reg.get<name>(second.front()).value);
+  CHECK(0u == std::size(prefab.spawn(0)));
+}
+
+TEST_CASE("prefabs spawn into a registry whose pools were replaced") {
+  auto reg = nova::Registry{};
+  auto prefab = nova::Prefab{reg, make_unit()};
+  prefab.spawn(10);
+
+  // what loading a snapshot does to the world's registry.
+  reg = nova::Registry{};
+
+  const auto entities = prefab.spawn(3);
+  CHECK(3u == reg.storage<position>().size());
+  for (const auto e : entities) {
+    REQUIRE(reg.all_of<position, int, name, enemy>(e));
+    CHECK("grunt" == reg.get<name>(e).value);
+  }
+}
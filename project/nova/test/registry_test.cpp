@@ -5,6 +5,10 @@
 
 #include "nova/registry.hpp"
 
+#include <ranges>
+#include <utility>
+#include <vector>
+
 struct NotABundle {
   int i{};
   constexpr auto operator==(NotABundle const&) const -> bool = default;
@@ -98,4 +102,52 @@ TEST_CASE("remove/erase a bundle") {
     CHECK_EQ(reg.try_get<int>(e), nullptr);
     CHECK_EQ(reg.try_get<float>(e), nullptr);
   }
-}
\ No newline at end of file
+}
+
+TEST_CASE("spawn a batch of bundles") {
+  struct Tag {};
+  struct Nested {
+    using is_bundle = void;
+    float f{};
+    Tag tag{};
+  };
+  struct MyBundle {
+    using is_bundle = void;
+    int i{};
+    Nested nested{};
+  };
+
+  auto reg = nova::Registry{};
+  const auto existing = reg.create();
+  reg.emplace<int>(existing, -1);
+
+  auto bundles = std::vector<MyBundle>{};
+  for (auto i = 0; i < 100; ++i) {
+    bundles.push_back(MyBundle{.i = i, .nested = Nested{.f = 0.5f * i}});
+  }
+
+  const auto check = [&](const auto& entities) {
+    REQUIRE(100u == std::size(entities));
+    for (auto i = 0; i < 100; ++i) {
+      const auto e = entities[static_cast<std::size_t>(i)];
+      CHECK(reg.has_bundle<MyBundle>(e));
+      CHECK(i == reg.get<int>(e));
+      CHECK(0.5f * i == reg.get<float>(e));
+      CHECK(reg.all_of<Tag>(e));
+    }
+    CHECK(-1 == reg.get<int>(existing));
+  };
+
+  SUBCASE("from a container") { check(reg.spawn_batch(bundles)); }
+
+  SUBCASE("with an explicit bundle type") {
+    check(reg.spawn_batch<MyBundle>(std::as_const(bundles)));
+  }
+
+  SUBCASE("from a generated range") {
+    check(reg.spawn_batch(std::views::iota(0, 100) |
+                          std::views::transform([&](const int i) {
+                            return bundles[static_cast<std::size_t>(i)];
+                          })));
+  }
+}
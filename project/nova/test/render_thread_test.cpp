@@ -0,0 +1,106 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+// clang-format off
+#include <doctest/doctest.h>
+// clang-format on
+
+#include "nova/render/render_thread.hpp"
+
+#include <chrono>
+#include <semaphore>
+#include <stdexcept>
+
+namespace {
+
+auto headless(nova::RenderThread& render_thread) -> nova::HeadlessBackend& {
+  return static_cast<nova::HeadlessBackend&>(render_thread.backend());
+}
+
+// blocks in `draw` until the test lets it present.
+class GatedBackend final : public nova::RenderBackend {
+ public:
+  std::binary_semaphore drawing{0};
+  std::binary_semaphore present{0};
+  std::vector<nova::Vertex> last_drawn{};
+
+  auto draw(const nova::RenderFrame& frame) -> void override {
+    drawing.release();
+    present.acquire();
+    last_drawn = frame.vertices;
+  }
+};
+
+class ThrowingBackend final : public nova::RenderBackend {
+ public:
+  auto draw(const nova::RenderFrame&) -> void override {
+    throw std::runtime_error{"lost device"};
+  }
+};
+
+}  // namespace
+
+TEST_CASE("frames are drawn in order on the render thread") {
+  auto render_thread =
+      nova::RenderThread{std::make_unique<nova::HeadlessBackend>()};
+
+  for (auto i = std::size_t{0}; i < 5u; ++i) {
+    render_thread.frame().vertices.resize(i);
+    render_thread.submit();
+  }
+  render_thread.wait_idle();
+
+  const auto& backend = headless(render_thread);
+  CHECK(std::this_thread::get_id() != backend.render_thread());
+  const auto draws = backend.draws();
+  REQUIRE(5u == std::size(draws));
+  for (auto i = std::size_t{0}; i < 5u; ++i) {
+    CHECK(i == draws[i].index);
+    CHECK(i == draws[i].vertex_count);
+    CHECK(backend.render_thread() == draws[i].thread);
+  }
+  CHECK(5u == render_thread.submitted());
+}
+
+TEST_CASE("the next frame is extracted while the previous one is drawn") {
+  auto backend = std::make_unique<GatedBackend>();
+  auto& gated = *backend;
+  auto render_thread = nova::RenderThread{MOV(backend)};
+
+  render_thread.frame().vertices.assign(1u, nova::Vertex{.x = 1.f});
+  render_thread.submit();
+  gated.drawing.acquire();
+
+  // frame 0 is being drawn, frame 1 goes to the other buffer.
+  render_thread.frame().vertices.assign(2u, nova::Vertex{.x = 2.f});
+  gated.present.release();
+  render_thread.submit();
+  gated.drawing.acquire();
+  CHECK(1u == std::size(gated.last_drawn));
+  CHECK(1.f == gated.last_drawn[0].x);
+
+  gated.present.release();
+  render_thread.wait_idle();
+  CHECK(2u == std::size(gated.last_drawn));
+  CHECK(2.f == gated.last_drawn[0].x);
+}
+
+TEST_CASE("a backend error is rethrown on the simulation thread") {
+  auto render_thread =
+      nova::RenderThread{std::make_unique<ThrowingBackend>()};
+
+  render_thread.submit();
+  CHECK_THROWS_WITH_AS(render_thread.wait_idle(), "lost device",
+                       std::runtime_error);
+  // once reported, the error does not prevent submitting new frames.
+  render_thread.submit();
+  render_thread.stop();
+}
+
+TEST_CASE("stopping draws the frame in flight") {
+  auto render_thread = nova::RenderThread{
+      std::make_unique<nova::HeadlessBackend>(std::chrono::milliseconds{10})};
+
+  render_thread.submit();
+  render_thread.stop();
+  CHECK(1u == std::size(headless(render_thread).draws()));
+  CHECK_THROWS_AS(render_thread.submit(), nova::nova_exception);
+}
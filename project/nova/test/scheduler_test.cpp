@@ -6,7 +6,18 @@
 #include "nova/scheduler/scheduler.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <format>
+#include <mutex>
 #include <ranges>
+#include <set>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 
 #include "common.hpp"
 #include "nova/scheduler/stage.hpp"
@@ -69,3 +80,294 @@ TEST_CASE("scheduler correctly assigns systems to stages") {
   CHECK(2u == sched.stage_count());
   CHECK(1u == sched.system_count());
 }
+
+namespace {
+
+std::atomic<std::size_t> init_counter{0};
+std::mutex init_threads_mutex{};
+std::set<std::thread::id> init_threads{};
+
+struct init_order {
+  std::size_t value{};
+};
+
+struct failing_init {};
+
+}  // namespace
+
+template <>
+struct nova::from_world<failing_init> {
+  auto operator()(nova::World&) -> failing_init {
+    throw nova::nova_exception{"failing_init"};
+  }
+};
+
+template <>
+struct nova::from_world<init_order> {
+  auto operator()(nova::World&) -> init_order {
+    {
+      auto lock = std::scoped_lock{init_threads_mutex};
+      init_threads.insert(std::this_thread::get_id());
+    }
+    // long enough for every worker to pick up some of the systems.
+    std::this_thread::sleep_for(std::chrono::milliseconds{2});
+    return init_order{.value = init_counter++};
+  }
+};
+
+TEST_CASE("scheduler initializes systems in parallel") {
+  using orders_t = std::vector<std::size_t>;
+
+  const auto make_scheduler = [] {
+    auto sched = nova::Scheduler{};
+    sched.add_stage("a");
+    sched.add_stage(nova::stage("b").after("a"));
+
+    auto first = [](nova::Local<init_order> order,
+                    nova::Resource<orders_t> res) {
+      res->push_back(order->value);
+    };
+    auto second = [](nova::Local<init_order> order,
+                     nova::Resource<orders_t> res) {
+      res->push_back(order->value);
+    };
+
+    sched.add_system_to_stage(nova::system(second).after("first"), "a");
+    sched.add_system_to_stage(nova::system(first).label("first"), "a");
+    for (auto i = 0; i < 16; ++i) {
+      sched.add_system_to_stage(
+          [](nova::Local<init_order> order, nova::Resource<orders_t> res) {
+            res->push_back(order->value);
+          },
+          "b");
+    }
+    return sched;
+  };
+
+  // the state every system got, in the order the systems run.
+  const auto run = [](nova::Scheduler& sched, nova::World& world) {
+    sched.update(world);
+    return **world.resources().get<orders_t>();
+  };
+
+  init_counter = 0u;
+  init_threads.clear();
+  auto serial = make_scheduler();
+  auto serial_world = nova::World{};
+  serial_world.resources().set<orders_t>();
+  serial.initialize_systems(serial_world);
+  CHECK(1u == std::size(init_threads));
+  const auto serial_orders = run(serial, serial_world);
+
+  init_counter = 0u;
+  init_threads.clear();
+  auto parallel = make_scheduler();
+  auto parallel_world = nova::World{};
+  parallel_world.resources().set<orders_t>();
+  auto pool = nova::TaskPool{4};
+  const auto& report = parallel.initialize_systems(parallel_world, pool);
+  const auto parallel_orders = run(parallel, parallel_world);
+
+  CHECK(5u == report.thread_count);
+  CHECK(std::size(init_threads) > 1u);
+  CHECK(18u == init_counter.load());
+
+  // `second` is ordered after `first`, so its state is initialized later.
+  REQUIRE(18u == std::size(serial_orders));
+  REQUIRE(18u == std::size(parallel_orders));
+  CHECK(serial_orders[0] < serial_orders[1]);
+  CHECK(parallel_orders[0] < parallel_orders[1]);
+
+  // the systems of stage `b` are not ordered, so they may be initialized in
+  // any order, but every system got exactly one state in both cases.
+  CHECK(test::equals_unordered(serial_orders, parallel_orders));
+  auto sorted = parallel_orders;
+  std::ranges::sort(sorted);
+  CHECK(std::ranges::equal(sorted, std::views::iota(std::size_t{0},
+                                                     std::size_t{18})));
+}
+
+TEST_CASE("scheduler inserts systems into an initialized stage") {
+  using names_t = std::vector<std::string>;
+
+  auto sched = nova::Scheduler{};
+  sched.add_stage("stage");
+  sched.add_system_to_stage(
+      nova::system([](nova::Resource<names_t> r) { r->push_back("a"); })
+          .label("a"),
+      "stage");
+  sched.add_system_to_stage(
+      nova::system([](nova::Resource<names_t> r) { r->push_back("b"); })
+          .label("b"),
+      "stage");
+
+  auto world = nova::World{};
+  world.resources().set<names_t>();
+  sched.initialize_systems(world);
+
+  const auto run = [&] {
+    auto names = *world.resources().get<names_t>();
+    names->clear();
+    sched.update(world);
+    return *names;
+  };
+
+  const auto names = run();
+  REQUIRE(2u == std::size(names));
+  const auto& first = names[0];
+  const auto& second = names[1];
+
+  SUBCASE("adding after initialization throws") {
+    CHECK_THROWS_AS(sched.add_system_to_stage([] {}, "stage"),
+                    nova::nova_exception);
+    CHECK_THROWS_AS(sched.add_startup_system([] {}), nova::nova_exception);
+    CHECK_THROWS_AS(sched.add_teardown_system([] {}), nova::nova_exception);
+  }
+
+  SUBCASE("slots into the existing order") {
+    sched.insert_system_to_stage(
+        world,
+        nova::system([](nova::Local<int> i, nova::Resource<names_t> r) {
+          *i += 1;
+          r->push_back("c");
+        })
+            .after(first)
+            .before(second),
+        "stage");
+
+    CHECK(std::ranges::equal(run(), names_t{first, "c", second}));
+  }
+
+  SUBCASE("re-sorts the stage when it has to") {
+    sched.insert_system_to_stage(
+        world,
+        nova::system([](nova::Resource<names_t> r) { r->push_back("c"); })
+            .after(second)
+            .before(first),
+        "stage");
+
+    CHECK(std::ranges::equal(run(), names_t{second, "c", first}));
+  }
+
+  SUBCASE("throws on cycles and keeps the stage intact") {
+    CHECK_THROWS_AS(sched.insert_system_to_stage(
+                        world,
+                        nova::system([] {}).label("c").after("a").before("a"),
+                        "stage"),
+                    nova::nova_exception);
+    CHECK(std::ranges::equal(run(), names_t{first, second}));
+  }
+
+  SUBCASE("inserts a system set as a whole") {
+    CHECK_THROWS_AS(
+        sched.insert_system_to_stage(
+            world,
+            nova::system_set()
+                .with_system(
+                    [](nova::Resource<names_t> r) { r->push_back("c"); })
+                .with_system([](nova::Local<failing_init>) {})
+                .after(second)
+                .before(first),
+            "stage"),
+        nova::nova_exception);
+    CHECK(2u == sched.system_count());
+    CHECK(std::ranges::equal(run(), names_t{first, second}));
+  }
+
+  SUBCASE("removes systems") {
+    CHECK(1u == sched.remove_systems_from_stage("a", "stage"));
+    CHECK(std::ranges::equal(run(), names_t{"b"}));
+    CHECK(0u == sched.remove_systems_from_stage("a", "stage"));
+  }
+
+  SUBCASE("does not remove systems others are ordered relative to") {
+    sched.insert_system_to_stage(world, nova::system([] {}).after("a"),
+                                 "stage");
+    CHECK_THROWS_AS(sched.remove_systems_from_stage("a", "stage"),
+                    nova::nova_exception);
+    CHECK(3u == sched.system_count());
+  }
+}
+
+namespace {
+
+// records the hooks it is called with.
+class recording_observer final : public nova::SchedulerObserver {
+  std::vector<std::string>* calls_;
+  bool systems_;
+
+ public:
+  recording_observer(std::vector<std::string>& calls, const bool systems)
+      : calls_(&calls), systems_(systems) {}
+
+  [[nodiscard]] auto observes_systems() const noexcept -> bool override {
+    return systems_;
+  }
+
+  auto on_frame_begin(const std::size_t n_stages) -> void override {
+    calls_->push_back(std::format("frame {}", n_stages));
+  }
+
+  auto on_stage_begin(const std::size_t index, const std::string_view name,
+                      std::span<const nova::System> systems)
+      -> void override {
+    calls_->push_back(
+        std::format("stage {} {} {}", index, name, std::size(systems)));
+  }
+
+  auto on_systems_begin(const std::size_t stage, const std::size_t first,
+                        const std::size_t count) noexcept -> void override {
+    calls_->push_back(std::format("systems {} {} {}", stage, first, count));
+  }
+
+  auto on_systems_end(const std::size_t, const std::size_t,
+                      const std::size_t) noexcept -> void override {
+    calls_->push_back("end systems");
+  }
+
+  auto on_stage_end(const std::size_t index) -> void override {
+    calls_->push_back(std::format("end stage {}", index));
+  }
+
+  auto on_frame_end(nova::World&, const nova::Scheduler&) -> void override {
+    calls_->push_back("end frame");
+  }
+};
+
+}  // namespace
+
+TEST_CASE("scheduler reports to the observers it observes") {
+  using names_t = std::vector<std::string>;
+
+  auto world = nova::World{};
+  auto sched = nova::Scheduler{};
+  sched.add_stage("stage");
+  sched.add_system_to_stage([] {}, "stage");
+  sched.add_system_to_stage([] {}, "stage");
+  sched.initialize_systems(world);
+
+  auto calls = names_t{};
+  sched.update(world);
+  CHECK(std::empty(calls));
+
+  SUBCASE("only once they are resources") {
+    sched.observe<recording_observer>();
+    sched.observe<recording_observer>();
+    sched.update(world);
+    CHECK(std::empty(calls));
+
+    world.resources().set<recording_observer>(calls, false);
+    sched.update(world);
+    CHECK(names_t{"frame 1", "stage 0 stage 2", "end stage 0", "end frame"} ==
+          calls);
+  }
+
+  SUBCASE("system by system") {
+    world.resources().set<recording_observer>(calls, true);
+    sched.observe<recording_observer>();
+    sched.update(world);
+    CHECK(names_t{"frame 1", "stage 0 stage 2", "systems 0 0 1",
+                  "end systems", "systems 0 1 1", "end systems",
+                  "end stage 0", "end frame"} == calls);
+  }
+}
@@ -0,0 +1,175 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+// clang-format off
+#include <doctest/doctest.h>
+// clang-format on
+
+#include "nova/snapshot/snapshot.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct position {
+  float x{};
+  float y{};
+  constexpr auto operator==(position const&) const -> bool = default;
+};
+
+struct name {
+  std::string value{};
+  std::vector<int> tags{};
+  position offset{};
+  auto operator==(name const&) const -> bool = default;
+};
+
+struct frozen {};
+
+struct score {
+  int points{};
+  std::string player{};
+};
+
+auto make_snapshot() {
+  return nova::Snapshot{}
+      .component<position>()
+      .component<name>()
+      .component<frozen>()
+      .resource<score>();
+}
+
+}  // namespace
+
+TEST_CASE("snapshot round trips components and resources") {
+  auto world = nova::World{};
+  auto& reg = world.registry();
+
+  const auto a = reg.create();
+  const auto destroyed = reg.create();
+  const auto b = reg.create();
+  reg.destroy(destroyed);
+
+  reg.emplace<position>(a, position{.x = 1.f, .y = 2.f});
+  reg.emplace<position>(b, position{.x = 3.f, .y = 4.f});
+  reg.emplace<name>(b, name{.value = "b", .tags = {1, 2, 3},
+                            .offset = position{.x = 5.f}});
+  reg.emplace<frozen>(a);
+  world.resources().set<score>(score{.points = 42, .player = "nova"});
+
+  const auto snapshot = make_snapshot();
+  const auto bytes = snapshot.save(world);
+
+  auto restored = nova::World{};
+  restored.registry().emplace<position>(restored.registry().create());
+  snapshot.load(restored, bytes);
+
+  auto& restored_reg = restored.registry();
+  CHECK(restored_reg.valid(a));
+  CHECK(restored_reg.valid(b));
+  CHECK_FALSE(restored_reg.valid(destroyed));
+  CHECK(reg.size() == restored_reg.size());
+
+  // recycling the destroyed entity gives the same identifier in both worlds.
+  CHECK(reg.create() == restored_reg.create());
+
+  CHECK(restored_reg.get<position>(a) == position{.x = 1.f, .y = 2.f});
+  CHECK(restored_reg.get<position>(b) == position{.x = 3.f, .y = 4.f});
+  CHECK(restored_reg.get<name>(b) == reg.get<name>(b));
+  CHECK(restored_reg.all_of<frozen>(a));
+  CHECK_FALSE(restored_reg.all_of<frozen>(b));
+  CHECK_FALSE(restored_reg.all_of<name>(a));
+
+  const auto restored_score = restored.resources().get<score>();
+  REQUIRE(restored_score.has_value());
+  CHECK(42 == (*restored_score)->points);
+  CHECK("nova" == (*restored_score)->player);
+}
+
+TEST_CASE("snapshot skips sections that are not registered") {
+  auto world = nova::World{};
+  const auto e = world.registry().create();
+  world.registry().emplace<position>(e, position{.x = 1.f});
+  world.registry().emplace<frozen>(e);
+
+  const auto bytes = make_snapshot().save(world);
+
+  auto restored = nova::World{};
+  nova::Snapshot{}.component<frozen>().load(restored, bytes);
+  CHECK(restored.registry().all_of<frozen>(e));
+  CHECK_FALSE(restored.registry().all_of<position>(e));
+}
+
+TEST_CASE("snapshot rejects invalid data") {
+  auto world = nova::World{};
+  auto bytes = make_snapshot().save(world);
+
+  SUBCASE("truncated") {
+    bytes.resize(std::size(bytes) / 2u);
+    CHECK_THROWS_AS(make_snapshot().load(world, bytes), nova::nova_exception);
+  }
+
+  SUBCASE("bad magic") {
+    bytes[0] = std::byte{0};
+    CHECK_THROWS_AS(make_snapshot().load(world, bytes), nova::nova_exception);
+  }
+}
+
+TEST_CASE("snapshot leaves the world intact on invalid data") {
+  auto source = nova::World{};
+  const auto e = source.registry().create();
+  source.registry().emplace<name>(e, name{.value = "source"});
+  source.resources().set<score>(score{.points = 1});
+  auto bytes = make_snapshot().save(source);
+
+  auto world = nova::World{};
+  const auto kept = world.registry().create();
+  world.registry().emplace<position>(kept, position{.x = 7.f});
+  world.resources().set<score>(score{.points = 2});
+
+  SUBCASE("truncated in the last section") {
+    bytes.pop_back();
+    CHECK_THROWS_AS(make_snapshot().load(world, bytes), nova::nova_exception);
+  }
+
+  SUBCASE("huge entity count") {
+    // the entity count follows the magic and the version.
+    const auto count = std::uint64_t{1} << 60u;
+    std::memcpy(std::data(bytes) + 2u * sizeof(std::uint32_t), &count,
+                sizeof(count));
+    CHECK_THROWS_AS(make_snapshot().load(world, bytes), nova::nova_exception);
+  }
+
+  REQUIRE(world.registry().valid(kept));
+  CHECK(world.registry().get<position>(kept) == position{.x = 7.f});
+  CHECK_FALSE(world.registry().all_of<name>(kept));
+  CHECK(2 == (*world.resources().get<score>())->points);
+}
+
+TEST_CASE("snapshot copies components across storage pages") {
+  auto world = nova::World{};
+  auto& reg = world.registry();
+  auto entities = std::vector<entt::entity>(3'000u);
+  reg.create(std::begin(entities), std::end(entities));
+  for (auto i = std::size_t{0}; i < std::size(entities); ++i) {
+    reg.emplace<position>(entities[i],
+                          position{.x = static_cast<float>(i), .y = 1.f});
+  }
+  // leaves a hole in the first page.
+  reg.remove<position>(entities[10]);
+
+  const auto snapshot = nova::Snapshot{}.component<position>();
+  auto restored = nova::World{};
+  snapshot.load(restored, snapshot.save(world));
+
+  CHECK(reg.storage<position>().size() ==
+        restored.registry().storage<position>().size());
+  CHECK_FALSE(restored.registry().all_of<position>(entities[10]));
+  for (auto i = std::size_t{0}; i < std::size(entities); ++i) {
+    if (i != 10u) {
+      CHECK(restored.registry().get<position>(entities[i]) ==
+            reg.get<position>(entities[i]));
+    }
+  }
+}
@@ -0,0 +1,153 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+// clang-format off
+#include <doctest/doctest.h>
+// clang-format on
+
+#include "nova/soa/soa.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace {
+
+struct velocity {
+  float dx{};
+  float dy{};
+};
+
+struct acceleration {
+  float ddx{};
+  float ddy{};
+};
+
+}  // namespace
+
+TEST_CASE("soa storage keeps each field in its own aligned array") {
+  auto reg = entt::registry{};
+  auto storage = nova::SoaStorage<velocity>{};
+
+  for (auto i = 0; i < 10; ++i) {
+    storage.emplace(reg.create(), velocity{.dx = static_cast<float>(i),
+                                           .dy = static_cast<float>(-i)});
+  }
+
+  REQUIRE(10u == storage.size());
+  const auto dx = storage.field<0>();
+  const auto dy = storage.field<1>();
+  CHECK(0u == reinterpret_cast<std::uintptr_t>(std::data(dx)) % 64u);
+  CHECK(0u == reinterpret_cast<std::uintptr_t>(std::data(dy)) % 64u);
+  for (auto i = std::size_t{0}; i < std::size(dx); ++i) {
+    CHECK(static_cast<float>(i) == dx[i]);
+    CHECK(-static_cast<float>(i) == dy[i]);
+  }
+}
+
+TEST_CASE("soa storage proxies reference the fields") {
+  auto reg = entt::registry{};
+  auto storage = nova::SoaStorage<velocity>{};
+  const auto e = reg.create();
+
+  auto [dx, dy] = storage.emplace(e, velocity{.dx = 1.f, .dy = 2.f});
+  dx += 10.f;
+  CHECK(11.f == storage.field<0>()[0]);
+
+  for (auto [entity, x, y] : storage.each()) {
+    CHECK(e == entity);
+    y = x;
+  }
+  const auto value = storage.load(e);
+  CHECK(11.f == value.dx);
+  CHECK(11.f == value.dy);
+}
+
+TEST_CASE("erasing from a soa storage moves the last element") {
+  auto reg = entt::registry{};
+  auto storage = nova::SoaStorage<velocity>{};
+  const auto a = reg.create();
+  const auto b = reg.create();
+  const auto c = reg.create();
+  storage.emplace(a, velocity{.dx = 1.f});
+  storage.emplace(b, velocity{.dx = 2.f});
+  storage.emplace(c, velocity{.dx = 3.f});
+
+  storage.erase(a);
+  CHECK_FALSE(storage.contains(a));
+  CHECK(0u == storage.index(c));
+  CHECK(3.f == storage.load(c).dx);
+  CHECK(2.f == storage.load(b).dx);
+  CHECK_FALSE(storage.remove(a));
+  CHECK_THROWS_AS(storage.emplace(b), nova::nova_exception);
+
+  reg.destroy(b);
+  CHECK(1u == storage.prune(reg));
+  REQUIRE(1u == storage.size());
+  CHECK(c == storage.entities().front());
+}
+
+TEST_CASE("soa storage evicts destroyed entities whose slot is reused") {
+  auto reg = entt::registry{};
+  auto storage = nova::SoaStorage<velocity>{};
+  const auto a = reg.create();
+  const auto b = reg.create();
+  storage.emplace(a, velocity{.dx = 1.f});
+  storage.emplace(b, velocity{.dx = 2.f});
+
+  reg.destroy(a);
+  const auto recycled = reg.create();
+  REQUIRE(entt::to_entity(a) == entt::to_entity(recycled));
+  REQUIRE(a != recycled);
+
+  storage.emplace(recycled, velocity{.dx = 3.f});
+  CHECK_FALSE(storage.contains(a));
+  CHECK(2u == storage.size());
+  CHECK(3.f == storage.load(recycled).dx);
+  CHECK(2.f == storage.load(b).dx);
+
+  CHECK(0u == storage.prune(reg));
+  reg.destroy(b);
+  CHECK(1u == storage.prune(reg));
+  REQUIRE(1u == storage.size());
+  CHECK(recycled == storage.entities().front());
+  CHECK(0u == storage.index(recycled));
+}
+
+TEST_CASE("soa storages can be lined up and integrated field by field") {
+  auto reg = entt::registry{};
+  auto velocities = nova::SoaStorage<velocity>{};
+  auto accelerations = nova::SoaStorage<acceleration>{};
+
+  const auto a = reg.create();
+  const auto b = reg.create();
+  velocities.emplace(a, velocity{.dx = 1.f});
+  velocities.emplace(b, velocity{.dx = 2.f});
+  accelerations.emplace(b, acceleration{.ddx = 20.f});
+  accelerations.emplace(a, acceleration{.ddx = 10.f});
+
+  accelerations.respect(velocities.entities());
+  REQUIRE(std::ranges::equal(velocities.entities(), accelerations.entities()));
+
+  const auto dx = velocities.field<0>();
+  const auto ddx = accelerations.field<0>();
+  for (auto i = std::size_t{0}; i < std::size(dx); ++i) {
+    dx[i] += ddx[i] * 0.5f;
+  }
+
+  CHECK(6.f == velocities.load(a).dx);
+  CHECK(12.f == velocities.load(b).dx);
+}
+
+TEST_CASE("soa system param") {
+  auto world = nova::World{};
+  const auto meta = nova::SystemMeta{};
+  CHECK_THROWS(nova::system_param<nova::Soa<velocity>>::param(meta, world));
+
+  world.resources().set<nova::SoaStorage<velocity>>();
+  auto soa = nova::system_param<nova::Soa<const velocity>>::param(meta, world);
+  CHECK(soa->empty());
+
+  const auto access = nova::system_param<nova::Soa<const velocity>>::access();
+  REQUIRE(1u == std::size(access.read_only));
+  CHECK(nova::type_id<nova::component_param<velocity>>() ==
+        access.read_only.front());
+  CHECK(std::empty(access.read_write));
+}
@@ -0,0 +1,124 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+// clang-format off
+#include <doctest/doctest.h>
+// clang-format on
+
+#include "nova/spatial/spatial_grid.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+
+using position_view_t = nova::View<nova::With<const nova::Position>>;
+
+auto spawn_random(entt::registry& reg, const std::size_t n, const float extent)
+    -> void {
+  auto gen = std::mt19937{42u};
+  auto distrib = std::uniform_real_distribution<float>{-extent, extent};
+  for (auto i = std::size_t{0}; i < n; ++i) {
+    reg.emplace<nova::Position>(reg.create(), distrib(gen), distrib(gen));
+  }
+}
+
+auto brute_force_radius(entt::registry& reg, const float x, const float y,
+                        const float radius) -> std::vector<entt::entity> {
+  auto result = std::vector<entt::entity>{};
+  for (auto&& [e, pos] : reg.view<const nova::Position>().each()) {
+    const auto dx = pos.x - x;
+    const auto dy = pos.y - y;
+    if (dx * dx + dy * dy <= radius * radius) {
+      result.push_back(e);
+    }
+  }
+  std::ranges::sort(result);
+  return result;
+}
+
+auto sorted(std::vector<entt::entity> entities) -> std::vector<entt::entity> {
+  std::ranges::sort(entities);
+  return entities;
+}
+
+}  // namespace
+
+TEST_CASE("spatial grid radius queries match a brute force search") {
+  auto reg = entt::registry{};
+  spawn_random(reg, 2'000, 200.f);
+
+  auto grid = nova::SpatialGrid{10.f};
+  grid.rebuild(position_view_t{reg.view<const nova::Position>()});
+  REQUIRE(2'000u == grid.size());
+
+  auto gen = std::mt19937{7u};
+  auto distrib = std::uniform_real_distribution<float>{-220.f, 220.f};
+  for (const auto radius : {0.f, 5.f, 10.f, 37.f, 1'000.f}) {
+    CAPTURE(radius);
+    for (auto i = 0; i < 20; ++i) {
+      const auto x = distrib(gen);
+      const auto y = distrib(gen);
+      CHECK(brute_force_radius(reg, x, y, radius) ==
+            sorted(grid.query_radius(x, y, radius)));
+    }
+  }
+}
+
+TEST_CASE("spatial grid aabb queries") {
+  auto reg = entt::registry{};
+  const auto inside = reg.create();
+  reg.emplace<nova::Position>(inside, 5.f, 5.f);
+  const auto edge = reg.create();
+  reg.emplace<nova::Position>(edge, -10.f, 10.f);
+  const auto outside = reg.create();
+  reg.emplace<nova::Position>(outside, 11.f, 0.f);
+
+  auto grid = nova::SpatialGrid{4.f};
+  grid.rebuild(position_view_t{reg.view<const nova::Position>()});
+
+  CHECK(sorted({inside, edge}) ==
+        sorted(grid.query_aabb(-10.f, -10.f, 10.f, 10.f)));
+  CHECK(std::empty(grid.query_aabb(100.f, 100.f, 200.f, 200.f)));
+}
+
+TEST_CASE("spatial grid reports entities of cells sharing a bucket once") {
+  // 8 entities hash their cells into 8 buckets, so some of the 7 cells of
+  // the query share one.
+  auto reg = entt::registry{};
+  auto entities = std::vector<entt::entity>{};
+  for (auto i = 0; i < 8; ++i) {
+    const auto e = reg.create();
+    reg.emplace<nova::Position>(e, static_cast<float>(i) * 4.f + 1.f, 1.f);
+    entities.push_back(e);
+  }
+
+  auto grid = nova::SpatialGrid{4.f};
+  grid.rebuild(position_view_t{reg.view<const nova::Position>()});
+
+  entities.pop_back();
+  CHECK(sorted(entities) == sorted(grid.query_aabb(0.f, 0.f, 27.f, 3.f)));
+}
+
+TEST_CASE("a parallel rebuild finds the same entities") {
+  auto reg = entt::registry{};
+  spawn_random(reg, 50'000, 1'000.f);
+
+  auto pool = nova::TaskPool{4u};
+  auto serial = nova::SpatialGrid{16.f};
+  auto parallel = nova::SpatialGrid{16.f};
+  const auto view = position_view_t{reg.view<const nova::Position>()};
+  serial.rebuild(view);
+  parallel.rebuild(view, &pool);
+
+  REQUIRE(serial.size() == parallel.size());
+  for (const auto& [x, y] : {std::pair{0.f, 0.f}, std::pair{-500.f, 250.f},
+                             std::pair{999.f, -999.f}}) {
+    CHECK(sorted(serial.query_radius(x, y, 40.f)) ==
+          sorted(parallel.query_radius(x, y, 40.f)));
+  }
+}
+
+TEST_CASE("an invalid cell size throws") {
+  CHECK_THROWS_AS(nova::SpatialGrid{0.f}, nova::nova_exception);
+  CHECK_THROWS_AS(nova::SpatialGrid{-1.f}, nova::nova_exception);
+}
@@ -0,0 +1,110 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+// clang-format off
+#include <doctest/doctest.h>
+// clang-format on
+
+#include "nova/task/task_pool.hpp"
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST_CASE("parallel_for visits every index exactly once") {
+  auto pool = nova::TaskPool{4};
+  auto visited = std::vector<std::atomic<int>>(1000);
+
+  pool.parallel_for(std::size(visited),
+                    [&](const std::size_t i) { visited[i] += 1; });
+
+  for (const auto& count : visited) {
+    CHECK(1 == count.load());
+  }
+}
+
+TEST_CASE("parallel_for rethrows the first exception") {
+  auto pool = nova::TaskPool{2};
+  auto count = std::atomic<int>{0};
+
+  CHECK_THROWS_AS(pool.parallel_for(100,
+                                    [&](const std::size_t i) {
+                                      count += 1;
+                                      if (i == 10u) {
+                                        throw std::runtime_error{"oops"};
+                                      }
+                                    }),
+                  std::runtime_error);
+  CHECK(count.load() <= 100);
+}
+
+TEST_CASE("parallel_for can be nested") {
+  auto pool = nova::TaskPool{2};
+  auto count = std::atomic<int>{0};
+
+  pool.parallel_for(8, [&](const std::size_t) {
+    pool.parallel_for(8, [&](const std::size_t) { count += 1; });
+  });
+
+  CHECK(64 == count.load());
+}
+
+TEST_CASE("spawned tasks are run before the pool is destroyed") {
+  auto count = std::atomic<int>{0};
+  {
+    auto pool = nova::TaskPool{2};
+    for (auto i = 0; i < 100; ++i) {
+      pool.spawn([&] { count += 1; });
+    }
+  }
+  CHECK(100 == count.load());
+}
+
+TEST_CASE("parallel_for runs work pinned to the calling thread") {
+  const auto caller = std::this_thread::get_id();
+  auto visited = std::vector<std::atomic<int>>(100);
+  auto pinned_on = std::thread::id{};
+
+  SUBCASE("with workers") {
+    auto pool = nova::TaskPool{2};
+    pool.parallel_for(
+        std::size(visited), [&](const std::size_t i) { visited[i] += 1; },
+        [&] { pinned_on = std::this_thread::get_id(); });
+  }
+
+  SUBCASE("without workers") {
+    auto pool = nova::TaskPool{0};
+    pool.parallel_for(
+        std::size(visited), [&](const std::size_t i) { visited[i] += 1; },
+        [&] { pinned_on = std::this_thread::get_id(); });
+  }
+
+  SUBCASE("with every worker busy") {
+    auto pool = nova::TaskPool{1};
+    auto release = std::atomic<bool>{false};
+    pool.spawn([&] {
+      while (not release.load()) {
+        std::this_thread::yield();
+      }
+    });
+    pool.parallel_for(
+        std::size(visited), [&](const std::size_t i) { visited[i] += 1; },
+        [&] { pinned_on = std::this_thread::get_id(); });
+    release = true;
+  }
+
+  CHECK(caller == pinned_on);
+  for (const auto& count : visited) {
+    CHECK(1 == count.load());
+  }
+}
+
+TEST_CASE("parallel_for rethrows errors of the pinned work") {
+  auto pool = nova::TaskPool{2};
+  auto count = std::atomic<int>{0};
+
+  CHECK_THROWS_AS(pool.parallel_for(
+                      10, [&](const std::size_t) { count += 1; },
+                      [] { throw std::runtime_error{"oops"}; }),
+                  std::runtime_error);
+  CHECK(10 == count.load());
+}
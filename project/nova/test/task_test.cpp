@@ -0,0 +1,216 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+// clang-format off
+#include <doctest/doctest.h>
+// clang-format on
+
+#include "nova/task/task_set.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <semaphore>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "nova/scheduler/scheduler.hpp"
+#include "nova/system/system_builder.hpp"
+#include "nova/task/tasks.hpp"
+
+namespace {
+
+using namespace std::chrono_literals;
+
+// polls `tasks` like a system would, once per "frame", until `n` results
+// arrived.
+template <typename T>
+auto poll_results(nova::TaskSet<T>& tasks, const std::size_t n)
+    -> std::vector<nova::TaskResult<T>> {
+  auto results = std::vector<nova::TaskResult<T>>{};
+  const auto deadline = std::chrono::steady_clock::now() + 5s;
+  while (std::size(results) < n and
+         std::chrono::steady_clock::now() < deadline) {
+    for (auto& result : tasks.poll()) {
+      results.push_back(MOV(result));
+    }
+    std::this_thread::sleep_for(1ms);
+  }
+  return results;
+}
+
+auto square(const int value) -> nova::Task<int> { co_return value * value; }
+
+auto sum_of_squares(const int n) -> nova::Task<int> {
+  auto sum = 0;
+  for (auto i = 1; i <= n; ++i) {
+    sum += co_await square(i);
+    co_await nova::yield_now();
+  }
+  co_return sum;
+}
+
+auto fail() -> nova::Task<int> {
+  throw std::runtime_error{"no path"};
+  co_return 0;
+}
+
+auto fail_in_child() -> nova::Task<int> { co_return 1 + co_await fail(); }
+
+auto spin_forever(std::atomic<int>& iterations) -> nova::Task<> {
+  for (;;) {
+    iterations.fetch_add(1);
+    co_await nova::yield_now();
+  }
+}
+
+auto set_flag(std::atomic<bool>& flag) -> nova::Task<> {
+  flag.store(true);
+  co_return;
+}
+
+}  // namespace
+
+TEST_CASE("task results are polled once they are done") {
+  auto pool = nova::TaskPool{2u};
+  auto tasks = nova::TaskSet<int>{pool};
+
+  const auto handle = tasks.spawn(sum_of_squares(10));
+  CHECK(1u == tasks.pending());
+
+  auto results = poll_results(tasks, 1u);
+  REQUIRE(1u == std::size(results));
+  CHECK(handle.id() == results[0].id());
+  REQUIRE(results[0].has_value());
+  CHECK(385 == results[0].value());
+  CHECK(0u == tasks.pending());
+}
+
+TEST_CASE("exceptions are delivered with the result") {
+  auto pool = nova::TaskPool{2u};
+  auto tasks = nova::TaskSet<int>{pool};
+
+  tasks.spawn(fail_in_child());
+  auto results = poll_results(tasks, 1u);
+  REQUIRE(1u == std::size(results));
+  CHECK(results[0].failed());
+  CHECK_THROWS_WITH_AS(results[0].value(), "no path", std::runtime_error);
+}
+
+TEST_CASE("running tasks stop at their next cancellation point") {
+  auto pool = nova::TaskPool{2u};
+  auto tasks = nova::TaskSet<>{pool};
+  auto iterations = std::atomic<int>{0};
+
+  auto handle = tasks.spawn(spin_forever(iterations));
+  while (iterations.load() < 10) {
+    std::this_thread::yield();
+  }
+  handle.cancel();
+
+  auto results = poll_results(tasks, 1u);
+  REQUIRE(1u == std::size(results));
+  CHECK(results[0].cancelled());
+  CHECK_THROWS_AS(results[0].value(), nova::task_cancelled);
+}
+
+TEST_CASE("tasks cancelled before they start never run") {
+  auto pool = nova::TaskPool{1u};
+  auto tasks = nova::TaskSet<>{pool};
+  auto flag = std::atomic<bool>{false};
+
+  // keeps the only worker busy.
+  auto release = std::binary_semaphore{0};
+  pool.spawn([&] { release.acquire(); });
+
+  tasks.spawn(set_flag(flag));
+  tasks.cancel_all();
+  release.release();
+
+  auto results = poll_results(tasks, 1u);
+  REQUIRE(1u == std::size(results));
+  CHECK(results[0].cancelled());
+  CHECK_FALSE(flag.load());
+
+  // tasks spawned after `cancel_all` are not cancelled.
+  tasks.spawn(set_flag(flag));
+  results = poll_results(tasks, 1u);
+  REQUIRE(1u == std::size(results));
+  CHECK(results[0].has_value());
+  CHECK(flag.load());
+}
+
+TEST_CASE("results of many concurrent tasks all arrive") {
+  auto pool = nova::TaskPool{4u};
+  auto tasks = nova::TaskSet<int>{pool};
+
+  for (auto i = 0; i < 1'000; ++i) {
+    tasks.spawn(square(i));
+  }
+
+  auto results = poll_results(tasks, 1'000u);
+  REQUIRE(1'000u == std::size(results));
+  std::ranges::sort(results, std::less{},
+                    [](const auto& result) { return result.id(); });
+  for (auto i = 0; i < 1'000; ++i) {
+    CHECK(static_cast<std::uint64_t>(i) == results[i].id());
+    CHECK(i * i == results[i].value());
+  }
+  CHECK(0u == tasks.pending());
+}
+
+TEST_CASE("destroying a set cancels its tasks") {
+  auto pool = nova::TaskPool{2u};
+  auto iterations = std::atomic<int>{0};
+  {
+    auto tasks = nova::TaskSet<>{pool};
+    tasks.spawn(spin_forever(iterations));
+    while (iterations.load() == 0) {
+      std::this_thread::yield();
+    }
+  }
+  // the task stops on its own, the pool can be joined.
+}
+
+TEST_CASE("systems poll the tasks they spawned in later frames") {
+  using results_t = std::vector<int>;
+
+  auto sched = nova::Scheduler{};
+  sched.add_stage("stage");
+  sched.add_system_to_stage(
+      [](nova::Tasks<int> tasks, nova::Local<bool> spawned,
+         nova::Resource<results_t> results) {
+        for (auto& result : tasks->poll()) {
+          results->push_back(result.value());
+        }
+        if (not *spawned) {
+          tasks->spawn(sum_of_squares(3));
+          *spawned = true;
+        }
+      },
+      "stage");
+
+  auto world = nova::World{};
+  world.resources().set<nova::TaskPool>(2u);
+  world.resources().set<results_t>();
+  sched.initialize_systems(world);
+
+  const auto deadline = std::chrono::steady_clock::now() + 5s;
+  const auto results = *world.resources().get<results_t>();
+  while (std::empty(*results) and
+         std::chrono::steady_clock::now() < deadline) {
+    sched.update(world);
+    std::this_thread::sleep_for(1ms);
+  }
+  REQUIRE(1u == std::size(*results));
+  CHECK(14 == results->front());
+}
+
+TEST_CASE("tasks need a task pool") {
+  auto sched = nova::Scheduler{};
+  sched.add_stage("stage");
+  sched.add_system_to_stage([](nova::Tasks<int>) {}, "stage");
+
+  auto world = nova::World{};
+  CHECK_THROWS_AS(sched.initialize_systems(world),
+                  nova::missing_resource<nova::TaskPool>);
+}
@@ -0,0 +1,158 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+// clang-format off
+#include <doctest/doctest.h>
+// clang-format on
+
+#include "nova/system/view.hpp"
+
+#include <numeric>
+#include <vector>
+
+namespace {
+
+struct position {
+  float x{};
+};
+
+struct velocity {
+  float dx{};
+};
+
+struct frozen {};
+
+auto make_entities(entt::registry& reg, const std::size_t n)
+    -> std::vector<entt::entity> {
+  auto entities = std::vector<entt::entity>(n);
+  reg.create(std::begin(entities), std::end(entities));
+  for (auto i = std::size_t{0}; i < n; ++i) {
+    reg.emplace<position>(entities[i], static_cast<float>(i));
+    reg.emplace<velocity>(entities[i], static_cast<float>(i) * 10.f);
+  }
+  return entities;
+}
+
+template <typename TView>
+auto collect_chunks(const TView& view) -> std::vector<typename TView::chunk_t> {
+  auto chunks = std::vector<typename TView::chunk_t>{};
+  for (const auto& chunk : view.chunks()) {
+    chunks.push_back(chunk);
+  }
+  return chunks;
+}
+
+template <typename TView>
+auto count_entities(const std::vector<typename TView::chunk_t>& chunks)
+    -> std::size_t {
+  return std::accumulate(
+      std::begin(chunks), std::end(chunks), std::size_t{0},
+      [](const auto sum, const auto& chunk) { return sum + chunk.size(); });
+}
+
+}  // namespace
+
+TEST_CASE("a single component view is one chunk") {
+  using view_t = nova::View<nova::With<const position>>;
+
+  auto reg = entt::registry{};
+  make_entities(reg, 100);
+
+  const auto view = view_t{reg.view<const position>()};
+  const auto chunks = collect_chunks(view);
+  REQUIRE(1u == std::size(chunks));
+
+  const auto pos = chunks[0].get<const position>();
+  REQUIRE(100u == std::size(pos));
+  for (auto i = std::size_t{0}; i < std::size(pos); ++i) {
+    CHECK(reg.get<position>(chunks[0].entities[i]).x == pos[i].x);
+  }
+}
+
+TEST_CASE("multi component chunks break where the pools diverge") {
+  using view_t = nova::View<nova::With<position, const velocity>>;
+
+  auto reg = entt::registry{};
+  const auto entities = make_entities(reg, 10);
+  // moves the last velocity in the middle of the pool.
+  reg.remove<velocity>(entities[4]);
+
+  const auto view = view_t{reg.view<position, const velocity>()};
+  const auto chunks = collect_chunks(view);
+  CHECK(3u == std::size(chunks));
+  CHECK(9u == count_entities<view_t>(chunks));
+
+  for (const auto& chunk : chunks) {
+    const auto pos = chunk.get<position>();
+    const auto vel = chunk.get<const velocity>();
+    REQUIRE(chunk.size() == std::size(pos));
+    REQUIRE(chunk.size() == std::size(vel));
+    for (auto i = std::size_t{0}; i < chunk.size(); ++i) {
+      CHECK(&reg.get<position>(chunk.entities[i]) == &pos[i]);
+      CHECK(&reg.get<velocity>(chunk.entities[i]) == &vel[i]);
+      pos[i].x += vel[i].dx;
+    }
+  }
+
+  for (auto i = std::size_t{0}; i < std::size(entities); ++i) {
+    const auto expected = i == 4u ? 4.f : static_cast<float>(i) * 11.f;
+    CHECK(expected == reg.get<position>(entities[i]).x);
+  }
+}
+
+TEST_CASE("excluded entities split the chunks") {
+  using view_t = nova::View<nova::With<const position, const velocity>,
+                            nova::Without<frozen>>;
+
+  auto reg = entt::registry{};
+  const auto entities = make_entities(reg, 10);
+  reg.emplace<frozen>(entities[3]);
+  reg.emplace<frozen>(entities[7]);
+
+  const auto view = view_t{
+      reg.view<const position, const velocity>(entt::exclude<frozen>)};
+  const auto chunks = collect_chunks(view);
+  CHECK(3u == std::size(chunks));
+  CHECK(8u == count_entities<view_t>(chunks));
+  for (const auto& chunk : chunks) {
+    for (const auto e : chunk.entities) {
+      CHECK_FALSE(reg.all_of<frozen>(e));
+    }
+  }
+}
+
+TEST_CASE("empty components yield empty spans") {
+  using view_t = nova::View<nova::With<const position, const frozen>>;
+
+  auto reg = entt::registry{};
+  const auto entities = make_entities(reg, 4);
+  for (const auto e : entities) {
+    reg.emplace<frozen>(e);
+  }
+
+  const auto view = view_t{reg.view<const position, const frozen>()};
+  const auto chunks = collect_chunks(view);
+  REQUIRE(1u == std::size(chunks));
+  CHECK(4u == std::size(chunks[0].get<const position>()));
+  CHECK(std::empty(chunks[0].get<const frozen>()));
+}
+
+TEST_CASE("chunks skip filtered out entities at both ends") {
+  using view_t = nova::View<nova::With<const position, const velocity>,
+                            nova::Without<frozen>>;
+
+  auto reg = entt::registry{};
+  const auto entities = make_entities(reg, 6);
+  reg.emplace<frozen>(entities.front());
+  reg.emplace<frozen>(entities.back());
+
+  const auto view = view_t{
+      reg.view<const position, const velocity>(entt::exclude<frozen>)};
+  const auto chunks = collect_chunks(view);
+  REQUIRE(1u == std::size(chunks));
+  CHECK(4u == chunks[0].size());
+  CHECK(entities[1] == chunks[0].entities.front());
+
+  for (const auto e : entities) {
+    reg.emplace_or_replace<frozen>(e);
+  }
+  CHECK(std::empty(collect_chunks(view)));
+}